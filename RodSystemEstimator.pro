@@ -2,4 +2,7 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     src \
-    tests
+    tests \
+    tools
+
+tests.depends = tools
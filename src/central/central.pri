@@ -3,11 +3,15 @@ INCLUDEPATH += $$PWD
 HEADERS += \
     $$PWD/mainwindow.h \
     $$PWD/rodsystemtablemodel.h \
+    $$PWD/jobqueuemodel.h \
+    $$PWD/consolemodel.h \
     $$PWD/uiconstants.h \
     $$PWD/doublespinboxitemdelegate.h
 
 SOURCES += \
     $$PWD/rodsystemtablemodel.cpp \
+    $$PWD/jobqueuemodel.cpp \
+    $$PWD/consolemodel.cpp \
     $$PWD/mainwindow.cpp \
     $$PWD/doublespinboxitemdelegate.cpp
     
@@ -0,0 +1,130 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the ConsoleModel class
+ */
+
+#include <QStringList>
+#include "consolemodel.h"
+#include "core/logwriter.h"
+
+using namespace RSE::Models;
+using namespace RSE::Core;
+
+//! Period of passing the output to views, ms
+static int const skFlushPeriod = 33;
+
+ConsoleModel::ConsoleModel(QString const& pathLogFile, int maxNumLines, QObject* pParent)
+    : QAbstractListModel(pParent)
+    , mLines(maxNumLines)
+    , mDecoder(QStringDecoder::System)
+{
+    mFlushTimer.setSingleShot(true);
+    mFlushTimer.setInterval(skFlushPeriod);
+    connect(&mFlushTimer, &QTimer::timeout, this, &ConsoleModel::flush);
+    mpLogWriter = new LogWriter(pathLogFile, this);
+    connect(mpLogWriter, &LogWriter::copied, this, &ConsoleModel::logSaved);
+}
+
+ConsoleModel::~ConsoleModel()
+{
+    mpLogWriter->write(mPendingData);
+}
+
+int ConsoleModel::rowCount(QModelIndex const& parent) const
+{
+    return parent.isValid() ? 0 : mLines.size();
+}
+
+QVariant ConsoleModel::data(QModelIndex const& index, int role) const
+{
+    if (!index.isValid() || index.row() >= mLines.size() || role != Qt::DisplayRole)
+        return QVariant();
+    return mLines[index.row()];
+}
+
+//! Accumulate the output to be shown with the next batch
+void ConsoleModel::append(QByteArray const& data)
+{
+    mPendingData.append(data);
+    if (!mFlushTimer.isActive())
+        mFlushTimer.start();
+}
+
+/*!
+ * \brief Pass the accumulated output to views and the log file
+ *
+ * The lines dropped from the buffer and the appended ones are reported as two ranges at most
+ */
+void ConsoleModel::flush()
+{
+    mFlushTimer.stop();
+    if (mPendingData.isEmpty())
+        return;
+    mpLogWriter->write(mPendingData);
+    QString text = mDecoder.decode(mPendingData);
+    mPendingData.clear();
+    text.remove('\r');
+    if (text.isEmpty())
+        return;
+    QStringList newLines = text.split('\n');
+    // The text ended by a line break leaves an empty part
+    bool isLastLineOpen = !text.endsWith('\n');
+    if (!isLastLineOpen)
+        newLines.removeLast();
+    // Complete the last line
+    if (mIsLastLineOpen && !mLines.isEmpty() && !newLines.isEmpty())
+    {
+        mLines.back().append(newLines.front());
+        newLines.removeFirst();
+        QModelIndex lastIndex = index(mLines.size() - 1);
+        emit dataChanged(lastIndex, lastIndex);
+    }
+    mIsLastLineOpen = isLastLineOpen;
+    int numNewLines = newLines.size();
+    if (numNewLines == 0)
+        return;
+    int capacity = mLines.capacity();
+    // Replace all the lines
+    if (numNewLines >= capacity)
+    {
+        beginResetModel();
+        mLines.clear();
+        for (int i = numNewLines - capacity; i != numNewLines; ++i)
+            mLines.push(newLines[i]);
+        endResetModel();
+        return;
+    }
+    // Drop the oldest lines and append the new ones
+    int numDropped = std::max(mLines.size() + numNewLines - capacity, 0);
+    if (numDropped > 0)
+    {
+        beginRemoveRows(QModelIndex(), 0, numDropped - 1);
+        mLines.popFront(numDropped);
+        endRemoveRows();
+    }
+    int numLines = mLines.size();
+    beginInsertRows(QModelIndex(), numLines, numLines + numNewLines - 1);
+    for (QString& line : newLines)
+        mLines.push(std::move(line));
+    endInsertRows();
+}
+
+//! Remove the lines shown. The log file keeps them
+void ConsoleModel::clear()
+{
+    flush();
+    beginResetModel();
+    mLines.clear();
+    mIsLastLineOpen = false;
+    mDecoder.resetState();
+    endResetModel();
+}
+
+//! Save the whole output to a file without blocking the interface
+void ConsoleModel::saveLog(QString const& pathFile)
+{
+    flush();
+    mpLogWriter->copy(pathFile);
+}
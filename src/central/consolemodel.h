@@ -0,0 +1,68 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the ConsoleModel class
+ */
+
+#ifndef CONSOLEMODEL_H
+#define CONSOLEMODEL_H
+
+#include <QAbstractListModel>
+#include <QStringDecoder>
+#include <QTimer>
+#include "core/ringbuffer.h"
+
+namespace RSE
+{
+
+namespace Core
+{
+class LogWriter;
+}
+
+namespace Models
+{
+
+/*!
+ * \brief List model to represent the output of solvers line by line
+ *
+ * Output is accumulated and passed to views at most at the display rate. Only the last lines are kept in memory,
+ * while the whole output is written to the log file
+ */
+class ConsoleModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    ConsoleModel(QString const& pathLogFile, int maxNumLines = 10000, QObject* pParent = nullptr);
+    ~ConsoleModel();
+    int rowCount(QModelIndex const& parent = QModelIndex()) const override;
+    QVariant data(QModelIndex const& index, int role = Qt::DisplayRole) const override;
+    void append(QByteArray const& data);
+    void flush();
+    void clear();
+    void saveLog(QString const& pathFile);
+
+signals:
+    void logSaved(QString const& pathFile, bool isOk);
+
+private:
+    //! Last lines of the output
+    Core::RingBuffer<QString> mLines;
+    //! Whether the last line is waiting for the rest of it
+    bool mIsLastLineOpen = false;
+    //! Output which has not been passed to views yet
+    QByteArray mPendingData;
+    //! Decoder which keeps the beginning of a character split between batches
+    QStringDecoder mDecoder;
+    //! Timer to pass the output to views in batches
+    QTimer mFlushTimer;
+    Core::LogWriter* mpLogWriter;
+};
+
+}
+
+}
+
+#endif // CONSOLEMODEL_H
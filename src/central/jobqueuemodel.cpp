@@ -0,0 +1,123 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the JobQueueModel class
+ */
+
+#include "jobqueuemodel.h"
+#include "core/jobscheduler.h"
+
+using namespace RSE::Models;
+using namespace RSE::Solution;
+
+//! Period of refreshing the durations of running jobs, ms
+static int const skDurationUpdatePeriod = 1000;
+
+JobQueueModel::JobQueueModel(JobScheduler* pScheduler, QObject* pParent)
+    : QAbstractTableModel(pParent)
+    , mpScheduler(pScheduler)
+{
+    mDurationTimer.setInterval(skDurationUpdatePeriod);
+    connect(&mDurationTimer, &QTimer::timeout, this, &JobQueueModel::updateDurations);
+    connect(mpScheduler, &JobScheduler::jobAboutToBeAdded, this, &JobQueueModel::processJobAboutToBeAdded);
+    connect(mpScheduler, &JobScheduler::jobAdded, this, &JobQueueModel::endInsertRows);
+    connect(mpScheduler, &JobScheduler::jobChanged, this, &JobQueueModel::processJobChanged);
+    connect(mpScheduler, &JobScheduler::jobsAboutToBeCleared, this, &JobQueueModel::beginResetModel);
+    connect(mpScheduler, &JobScheduler::jobsCleared, this, &JobQueueModel::endResetModel);
+}
+
+int JobQueueModel::rowCount(QModelIndex const& parent) const
+{
+    return parent.isValid() ? 0 : (int)mpScheduler->jobs().size();
+}
+
+int JobQueueModel::columnCount(QModelIndex const& parent) const
+{
+    return parent.isValid() ? 0 : kNumColumns;
+}
+
+//! Represent the state of a job
+QVariant JobQueueModel::data(QModelIndex const& index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+        return QVariant();
+    SolverJob const& job = mpScheduler->jobs()[index.row()];
+    if (role == Qt::ToolTipRole)
+        return job.directory;
+    if (role == Qt::TextAlignmentRole)
+        return index.column() == kMessage ? QVariant(int(Qt::AlignLeft | Qt::AlignVCenter)) : QVariant(int(Qt::AlignCenter));
+    if (role != Qt::DisplayRole)
+        return QVariant();
+    switch (index.column())
+    {
+    case kID:
+        return job.id;
+    case kName:
+        return job.name;
+    case kState:
+        return SolverJob::stateName(job.state);
+    case kStarted:
+        return job.startedTime.isValid() ? job.startedTime.toString("hh:mm:ss") : QString();
+    case kDuration:
+        return job.startedTime.isValid() ? QString::number(job.duration() * 1e-3, 'f', 1) : QString();
+    case kMessage:
+        return job.message;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant JobQueueModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation == Qt::Vertical)
+        return QVariant();
+    switch (section)
+    {
+    case kID:
+        return tr("№");
+    case kName:
+        return tr("Проект");
+    case kState:
+        return tr("Состояние");
+    case kStarted:
+        return tr("Запуск");
+    case kDuration:
+        return tr("Длительность, с");
+    case kMessage:
+        return tr("Сообщение");
+    default:
+        return QVariant();
+    }
+}
+
+//! Identifier of the job represented in a row, -1 is returned if the row is invalid
+int JobQueueModel::jobID(int iRow) const
+{
+    if (iRow < 0 || iRow >= rowCount())
+        return -1;
+    return mpScheduler->jobs()[iRow].id;
+}
+
+//! Announce a row before the job is appended, so that views never see the new job before the insertion has begun
+void JobQueueModel::processJobAboutToBeAdded(int iJob)
+{
+    beginInsertRows(QModelIndex(), iJob, iJob);
+}
+
+//! Refresh a row and keep the durations updated while there are running jobs
+void JobQueueModel::processJobChanged(int iJob)
+{
+    emit dataChanged(index(iJob, 0), index(iJob, kNumColumns - 1));
+    if (mpScheduler->numRunning() > 0)
+        mDurationTimer.start();
+    else
+        mDurationTimer.stop();
+}
+
+void JobQueueModel::updateDurations()
+{
+    int numRows = rowCount();
+    if (numRows > 0)
+        emit dataChanged(index(0, kDuration), index(numRows - 1, kDuration));
+}
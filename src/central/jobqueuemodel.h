@@ -0,0 +1,64 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the JobQueueModel class
+ */
+
+#ifndef JOBQUEUEMODEL_H
+#define JOBQUEUEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QTimer>
+
+namespace RSE
+{
+
+namespace Solution
+{
+class JobScheduler;
+}
+
+namespace Models
+{
+
+//! Table model to represent the queue of solver jobs
+class JobQueueModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column
+    {
+        kID,
+        kName,
+        kState,
+        kStarted,
+        kDuration,
+        kMessage,
+        kNumColumns
+    };
+    JobQueueModel(Solution::JobScheduler* pScheduler, QObject* pParent = nullptr);
+    ~JobQueueModel() = default;
+    int rowCount(QModelIndex const& parent = QModelIndex()) const override;
+    int columnCount(QModelIndex const& parent = QModelIndex()) const override;
+    QVariant data(QModelIndex const& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    int jobID(int iRow) const;
+
+private:
+    void processJobAboutToBeAdded(int iJob);
+    void processJobChanged(int iJob);
+    void updateDurations();
+
+private:
+    Solution::JobScheduler* mpScheduler;
+    //! Timer to refresh the durations of running jobs
+    QTimer mDurationTimer;
+};
+
+}
+
+}
+
+#endif // JOBQUEUEMODEL_H
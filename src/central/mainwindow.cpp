@@ -8,7 +8,11 @@
 #include <QVBoxLayout>
 #include <QGridLayout>
 #include <QLabel>
-#include <QTextEdit>
+#include <QListView>
+#include <QScrollBar>
+#include <QFontDatabase>
+#include <QGuiApplication>
+#include <QClipboard>
 #include <QDoubleSpinBox>
 #include <QSpinBox>
 #include <QSpacerItem>
@@ -19,6 +23,7 @@
 #include <QComboBox>
 #include <QFileDialog>
 #include <QMessageBox>
+#include <QTime>
 
 #include "DockManager.h"
 #include "DockWidget.h"
@@ -29,10 +34,14 @@
 #include "ui_mainwindow.h"
 #include "uiconstants.h"
 #include "rodsystemtablemodel.h"
+#include "jobqueuemodel.h"
+#include "consolemodel.h"
 #include "doublespinboxitemdelegate.h"
 #include "core/project.h"
 #include "core/solutionoptions.h"
 #include "core/solutionmanager.h"
+#include "core/jobscheduler.h"
+#include "core/resultcache.h"
 #include "core/io.h"
 #include "viewers/convergenceviewer.h"
 #include "viewers/klpgraphviewer.h"
@@ -56,8 +65,11 @@ const static bool skIsDistribute           = false;
 static QString skDirectoryData             = "data/";
 static QString skDirectoryInput            = "Input/";
 static QString skDirectoryOutput           = "Output/";
+static QString skDirectoryJobs             = "Jobs/";
+static QString skDirectoryCache            = "Cache/";
 const static QString skFileNameCables      = "Провода.txt";
 const static QString skFileNameConvergence = "optimal.txt";
+const static QString skFileNameLog         = "Solver.log";
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
@@ -81,6 +93,7 @@ MainWindow::~MainWindow()
     // Project
     delete mpProject;
     delete mpSolutionManager;
+    delete mpJobScheduler;
     delete mpSolutionOptions;
     delete mpIO;
 }
@@ -103,15 +116,19 @@ void MainWindow::createContent()
     // Construct the solution manager
     mpSolutionManager = new SolutionManager(skDirectoryData, skDirectoryInput, skDirectoryOutput);
     connect(mpSolutionManager, &SolutionManager::outputSent, this, &MainWindow::appendOutputData);
+    mpSolutionManager->setResultCache(std::make_shared<ResultCache>(skDirectoryData + skDirectoryCache));
+    // Construct the scheduler of concurrent solutions
+    mpJobScheduler = new JobScheduler(skDirectoryData, skDirectoryInput, skDirectoryOutput, skDirectoryData + skDirectoryJobs);
     // Create the default project and solution options
     createDefaultProject();
     createDefaultSolutionOptions();
     // Solution process
     mpDockManager->addDockWidget(ads::RightDockWidgetArea, createCalculationWidget());
     // Computational workflow
-    mpDockManager->addDockWidget(ads::BottomDockWidgetArea, createConsole());
-    // Damper
     CDockAreaWidget* pArea = nullptr;
+    pArea = mpDockManager->addDockWidget(ads::BottomDockWidgetArea, createConsole());
+    mpDockManager->addDockWidget(ads::CenterDockWidgetArea, createJobQueueWidget(), pArea);
+    // Damper
     pArea = mpDockManager->addDockWidget(ads::LeftDockWidgetArea, createDamperWidget());
     // Mechanical properties and geometry of a rod system
     pArea = mpDockManager->addDockWidget(ads::BottomDockWidgetArea, createRodSystemWidget(), pArea);
@@ -209,6 +226,7 @@ CDockWidget* MainWindow::createRodSystemWidget()
     QTableView* pTable = new QTableView();
     mpRodSystemTableModel = new Models::RodSystemTableModel(pTable);
     mpRodSystemTableModel->setRodSystem(&mpProject->rodSystem());
+    mpRodSystemTableModel->setSurrogates(Core::SpanSurrogate::read(Core::SpanSurrogate::pathFile(skDirectoryData + skFileNameCables)));
     mpDoubleSpinBoxItemDelegate = new Models::DoubleSpinBoxItemDelegate();
     pTable->setModel(mpRodSystemTableModel);
     pTable->setItemDelegate(mpDoubleSpinBoxItemDelegate);
@@ -235,11 +253,18 @@ CDockWidget* MainWindow::createRodSystemWidget()
     pAction = pToolBar->addAction(QIcon(":/icons/table-row-delete.svg"), tr("Удалить (Delete, D)"),
                                   mpRodSystemTableModel, &Models::RodSystemTableModel::removeSelected);
     pAction->setShortcuts({Qt::Key_Delete, Qt::Key_D});
+    pAction = pToolBar->addAction(QIcon(":/icons/import.svg"), tr("Импортировать длины пролетов из CSV"),
+                                  this, &MainWindow::importDistances);
     pToolBar->setMaximumHeight(kToolBarIconSize);
+    // Paste distances from the clipboard
+    pAction = new QAction(tr("Вставить длины пролетов"), pTable);
+    pAction->setShortcut(QKeySequence::Paste);
+    pAction->setShortcutContext(Qt::WidgetWithChildrenShortcut);
+    connect(pAction, &QAction::triggered, this, &MainWindow::pasteDistances);
+    pTable->addAction(pAction);
     // Signals & Slots
     connect(mpNameCable, &QComboBox::currentTextChanged, this, &MainWindow::setCable);
     connect(mpForce, &QDoubleSpinBox::valueChanged, this, &MainWindow::setForce);
-    connect(mpRodSystemTableModel, &Models::RodSystemTableModel::modified, this, &MainWindow::computeSpans);
     // Arrangement of fields
     pGridLayout->setColumnStretch(1, 1);
     pWidgetLayout->addLayout(pGridLayout);
@@ -339,14 +364,85 @@ CDockWidget* MainWindow::createCalculationWidget()
 //! Construct a widget to view solution information
 CDockWidget* MainWindow::createConsole()
 {
+    QSize const kToolBarIconSize(18, 18);
     CDockWidget* pDockWidget = new CDockWidget(tr("Вывод результатов расчета"));
-    mpConsole = new QTextEdit();
-    mpConsole->setReadOnly(true);
+    // Only the visible lines are laid out, since all of them are of the same height
+    mpConsole = new QListView();
+    mpConsoleModel = new Models::ConsoleModel(skDefaultPath + skFileNameLog, 10000, mpConsole);
+    mpConsole->setModel(mpConsoleModel);
+    mpConsole->setUniformItemSizes(true);
+    mpConsole->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    mpConsole->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    // Follow the output unless a user has scrolled up
+    connect(mpConsoleModel, &QAbstractItemModel::rowsInserted, mpConsole, [this]()
+    {
+        QScrollBar* pScrollBar = mpConsole->verticalScrollBar();
+        if (pScrollBar->value() == pScrollBar->maximum())
+            mpConsole->scrollToBottom();
+    });
+    connect(mpConsoleModel, &Models::ConsoleModel::logSaved, this, [this](QString const& pathFile, bool isOk)
+    {
+        if (!isOk)
+            QMessageBox::warning(this, tr("Сохранение журнала"), tr("Не удалось сохранить журнал в файл %1").arg(pathFile));
+    });
+    QAction* pAction = new QAction(tr("Копировать"), mpConsole);
+    pAction->setShortcut(QKeySequence::Copy);
+    pAction->setShortcutContext(Qt::WidgetWithChildrenShortcut);
+    connect(pAction, &QAction::triggered, this, &MainWindow::copyConsoleSelection);
+    mpConsole->addAction(pAction);
+    // Toolbar
+    QToolBar* pToolBar = pDockWidget->createDefaultToolBar();
+    pToolBar->setToolButtonStyle(Qt::ToolButtonStyle::ToolButtonIconOnly);
+    pDockWidget->setToolBarIconSize(kToolBarIconSize, CDockWidget::StateDocked);
+    pToolBar->addAction(QIcon(":/icons/document-save-as.svg"), tr("Сохранить журнал расчета"), this, &MainWindow::saveLog);
+    pToolBar->addAction(QIcon(":/icons/delete.svg"), tr("Очистить вывод"), mpConsoleModel, &Models::ConsoleModel::clear);
+    // Progress of the running solver
+    QLabel* pProgressLabel = new QLabel();
+    pToolBar->addSeparator();
+    pToolBar->addWidget(pProgressLabel);
+    connect(mpSolutionManager, &SolutionManager::progressChanged, pProgressLabel, [pProgressLabel](double progress, qint64 remainingTime)
+    {
+        QString text = tr("Выполнено %1%").arg(qRound(progress * 100));
+        if (remainingTime > 0)
+            text += tr(", осталось %1").arg(QTime(0, 0).addMSecs(remainingTime).toString("hh:mm:ss"));
+        pProgressLabel->setText(text);
+    });
+    connect(mpSolutionManager, &SolutionManager::stateChanged, pProgressLabel, [pProgressLabel](SolutionManager::State state)
+    {
+        if (state == SolutionManager::kQueued)
+            pProgressLabel->clear();
+    });
     pDockWidget->setWidget(mpConsole);
     mpUi->menuWindow->addAction(pDockWidget->toggleViewAction());
     return pDockWidget;
 }
 
+//! Construct a widget to control the queue of solutions which are run concurrently
+CDockWidget* MainWindow::createJobQueueWidget()
+{
+    QSize const kToolBarIconSize(18, 18);
+    CDockWidget* pDockWidget = new CDockWidget(tr("Очередь расчетов"));
+    mpJobQueueTable = new QTableView();
+    mpJobQueueModel = new Models::JobQueueModel(mpJobScheduler, mpJobQueueTable);
+    mpJobQueueTable->setModel(mpJobQueueModel);
+    mpJobQueueTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    mpJobQueueTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    mpJobQueueTable->horizontalHeader()->setStretchLastSection(true);
+    mpJobQueueTable->verticalHeader()->hide();
+    // Toolbar
+    QToolBar* pToolBar = pDockWidget->createDefaultToolBar();
+    pToolBar->setToolButtonStyle(Qt::ToolButtonStyle::ToolButtonIconOnly);
+    pDockWidget->setToolBarIconSize(kToolBarIconSize, CDockWidget::StateDocked);
+    pToolBar->addAction(QIcon(":/icons/list-add.svg"), tr("Добавить расчет частот текущего проекта в очередь"),
+                        this, &MainWindow::submitJob);
+    pToolBar->addAction(QIcon(":/icons/list-remove.svg"), tr("Отменить выбранные расчеты"), this, &MainWindow::cancelSelectedJobs);
+    pToolBar->addAction(QIcon(":/icons/delete.svg"), tr("Удалить завершенные расчеты"),
+                        mpJobScheduler, &JobScheduler::clearFinished);
+    pDockWidget->setWidget(mpJobQueueTable);
+    mpUi->menuWindow->addAction(pDockWidget->toggleViewAction());
+    return pDockWidget;
+}
+
 //! Specify menu interactions
 void MainWindow::specifyMenuConnections()
 {
@@ -461,10 +557,26 @@ void MainWindow::setForce(double value)
     computeSpans();
 }
 
-//! Compute length of all cables
+//! Compute length of all cables once the parameters have settled
 void MainWindow::computeSpans()
 {
-    mpRodSystemTableModel->updateContent();
+    mpRodSystemTableModel->requestUpdate();
+}
+
+//! Paste distances between supports from the clipboard
+void MainWindow::pasteDistances()
+{
+    if (!mpRodSystemTableModel->pasteDistances())
+        QMessageBox::warning(this, tr("Вставка длин пролетов"), mpRodSystemTableModel->errorString());
+}
+
+//! Replace distances between supports with the ones read from a CSV file
+void MainWindow::importDistances()
+{
+    QString pathFile = QFileDialog::getOpenFileName(this, tr("Импортировать длины пролетов"), mpIO->lastPath(),
+                                                    tr("Таблица (*.csv *.txt)"));
+    if (!pathFile.isEmpty() && !mpRodSystemTableModel->importDistances(pathFile))
+        QMessageBox::warning(this, tr("Импорт длин пролетов"), mpRodSystemTableModel->errorString());
 }
 
 //! Specify longitudinal stiffness of all supports
@@ -492,10 +604,18 @@ void MainWindow::createDefaultProject()
     Core::Support support(4.1e4, 2.6e5);
     // Project
     mpProject = new Core::Project(skDefaultProjectName, dataBaseCables, damper, rodSystem, support);
-    mpProject->readTemplateData(skDirectoryData + skDirectoryInput);
+    readTemplateData(skDirectoryData + skDirectoryInput);
     setProjectTitle();
 }
 
+//! Read template data of the project and report the error occurred, if any
+void MainWindow::readTemplateData(QString const& path)
+{
+    QString errorString;
+    if (!mpProject->readTemplateData(path, &errorString))
+        QMessageBox::warning(this, tr("Чтение шаблона"), errorString);
+}
+
 //! Create default solution options
 void MainWindow::createDefaultSolutionOptions()
 {
@@ -505,7 +625,7 @@ void MainWindow::createDefaultSolutionOptions()
 //! Solve the rod system
 void MainWindow::runRodSystemSolution()
 {
-    mpConsole->clear();
+    mpConsoleModel->clear();
     mpSolutionManager->solveRodSystem(*mpProject, *mpSolutionOptions);
 }
 
@@ -518,7 +638,45 @@ void MainWindow::runOptimizationSolution()
 //! Process the message from the solution process
 void MainWindow::appendOutputData(QByteArray const& data)
 {
-    mpConsole->append(data);
+    mpConsoleModel->append(data);
+}
+
+//! Save the whole output of solvers using a dialog window
+void MainWindow::saveLog()
+{
+    QString pathFile = QFileDialog::getSaveFileName(this, tr("Сохранить журнал расчета"), mpIO->lastPath() + skFileNameLog,
+                                                    tr("Журнал (*.log *.txt)"));
+    if (!pathFile.isEmpty())
+        mpConsoleModel->saveLog(pathFile);
+}
+
+//! Copy the selected lines of the output to the clipboard
+void MainWindow::copyConsoleSelection()
+{
+    QModelIndexList indices = mpConsole->selectionModel()->selectedIndexes();
+    std::sort(indices.begin(), indices.end());
+    QStringList lines;
+    for (QModelIndex const& index : indices)
+        lines.push_back(index.data().toString());
+    QGuiApplication::clipboard()->setText(lines.join('\n'));
+}
+
+//! Queue the solution of the current project, so that it is run in its own directory
+void MainWindow::submitJob()
+{
+    mpJobScheduler->submit(*mpProject, *mpSolutionOptions);
+}
+
+//! Cancel the jobs selected in the queue
+void MainWindow::cancelSelectedJobs()
+{
+    QModelIndexList rows = mpJobQueueTable->selectionModel()->selectedRows();
+    std::vector<int> ids;
+    ids.reserve(rows.size());
+    for (QModelIndex const& index : rows)
+        ids.push_back(mpJobQueueModel->jobID(index.row()));
+    for (int id : ids)
+        mpJobScheduler->cancel(id);
 }
 
 //! Open a new project
@@ -564,11 +722,17 @@ void MainWindow::openProject(QString const& pathFile)
     Core::DataBaseCables dataBaseCables(skDirectoryData, skFileNameCables);
     Core::IOPair ioPair = mpIO->open(pathFile, dataBaseCables);
     if (!ioPair.first || !ioPair.second)
+    {
+        QMessageBox::warning(this, tr("Открытие проекта"), mpIO->errorString());
         return;
+    }
     // Обработка проекта
     delete mpProject;
     mpProject = ioPair.first;
-    mpProject->readTemplateData(skDirectoryData + skDirectoryInput);
+    // Повторное чтение шаблона, если он изменился после сохранения проекта
+    QString pathTemplate = skDirectoryData + skDirectoryInput;
+    if (!mpProject->hasTemplateData() || mpProject->isTemplateOutdated(pathTemplate))
+        readTemplateData(pathTemplate);
     // Обработка расчетных настроек
     delete mpSolutionOptions;
     mpSolutionOptions = ioPair.second;
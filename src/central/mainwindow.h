@@ -19,7 +19,7 @@ class QSettings;
 class QDoubleSpinBox;
 class QSpinBox;
 class QTableView;
-class QTextEdit;
+class QListView;
 class QProcess;
 class QComboBox;
 QT_END_NAMESPACE
@@ -42,12 +42,15 @@ class IO;
 namespace Solution
 {
 class SolutionManager;
+class JobScheduler;
 class SolutionOptions;
 }
 
 namespace Models
 {
 class RodSystemTableModel;
+class JobQueueModel;
+class ConsoleModel;
 class DoubleSpinBoxItemDelegate;
 }
 
@@ -93,12 +96,14 @@ private:
     void createContent();
     void createDefaultProject();
     void createDefaultSolutionOptions();
+    void readTemplateData(QString const& path);
     void closeEvent(QCloseEvent* pEvent) override;
     ads::CDockWidget* createDamperWidget();
     ads::CDockWidget* createRodSystemWidget();
     ads::CDockWidget* createSupportWidget();
     ads::CDockWidget* createCalculationWidget();
     ads::CDockWidget* createConsole();
+    ads::CDockWidget* createJobQueueWidget();
     // Signals & Slots
     void specifyMenuConnections();
 
@@ -109,10 +114,18 @@ private slots:
     // Recompute
     void computeSpring();
     void computeSpans();
+    // Bulk entry of distances
+    void pasteDistances();
+    void importDistances();
     // Controlling the solution process
     void runRodSystemSolution();
     void runOptimizationSolution();
     void appendOutputData(QByteArray const& data);
+    void saveLog();
+    void copyConsoleSelection();
+    // Queue of solutions
+    void submitJob();
+    void cancelSelectedJobs();
     void showConvergence();
     void showResults();
     // Set project data
@@ -128,6 +141,8 @@ private:
     Ui::MainWindow* mpUi;
     ads::CDockManager* mpDockManager;
     Models::RodSystemTableModel* mpRodSystemTableModel;
+    Models::JobQueueModel* mpJobQueueModel;
+    QTableView* mpJobQueueTable;
     Models::DoubleSpinBoxItemDelegate* mpDoubleSpinBoxItemDelegate;
     std::shared_ptr<Viewers::KLPGraphViewer> mpGraphViewer;
     // Parameters of a damper
@@ -148,10 +163,12 @@ private:
     QSpinBox* mpNumDampModes;
     QSpinBox* mpStepModes;
     QDoubleSpinBox* mpTolTrunc;
-    QTextEdit* mpConsole;
+    QListView* mpConsole;
+    Models::ConsoleModel* mpConsoleModel;
     // Project
     RSE::Core::Project* mpProject;
     RSE::Solution::SolutionManager* mpSolutionManager;
+    RSE::Solution::JobScheduler* mpJobScheduler;
     RSE::Solution::SolutionOptions* mpSolutionOptions;
     RSE::Core::IO* mpIO;
     // Settings
@@ -6,147 +6,371 @@
  */
 
 #include <QTableView>
+#include <QGuiApplication>
+#include <QClipboard>
+#include <QFile>
+#include <QLocale>
+#include <QRegularExpression>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "rodsystemtablemodel.h"
 #include "core/rodsystem.h"
 
 using namespace RSE::Models;
 using namespace RSE::Core;
 
+//! Delay after the last edit before the spans are recomputed, ms
+static int const skUpdateDelay = 250;
+//! Maximal number of rods which can be entered
+static int const skMaxNumRods = 10000;
+//! Relative error of tabulated spans which is acceptable for the representation of lengths
+static double const skSurrogateTolerance = 1e-4;
+
 RodSystemTableModel::RodSystemTableModel(QObject* pParent)
-    : QStandardItemModel(pParent)
+    : QAbstractTableModel(pParent)
 {
-    setHorizontalHeaderLabels({tr("Длина пролета, м"), tr("Длина провода, м"), tr("Масса провода, кг")});
-    connect(this, &QStandardItemModel::itemChanged, this, &RodSystemTableModel::setChangedData);
+    mUpdateTimer.setSingleShot(true);
+    mUpdateTimer.setInterval(skUpdateDelay);
+    connect(&mUpdateTimer, &QTimer::timeout, this, &RodSystemTableModel::computeSpans);
 }
 
 //! Acquire the pointer to a rod system
 void RodSystemTableModel::setRodSystem(RodSystem* pRodSystem)
 {
+    beginResetModel();
     mpRodSystem = pRodSystem;
-    if (!mpRodSystem)
+    mLengths.clear();
+    endResetModel();
+    updateContent();
+}
+
+//! Specify tabulated solutions of single spans to represent lengths of cables without solving
+void RodSystemTableModel::setSurrogates(std::vector<SpanSurrogate> surrogates)
+{
+    mSurrogates = std::move(surrogates);
+    updateContent();
+}
+
+int RodSystemTableModel::rowCount(QModelIndex const& parent) const
+{
+    if (parent.isValid() || !mpRodSystem)
+        return 0;
+    return mpRodSystem->numRods();
+}
+
+int RodSystemTableModel::columnCount(QModelIndex const& parent) const
+{
+    return parent.isValid() ? 0 : kNumColumns;
+}
+
+//! Represent the distance between supports, length and mass of a cable
+QVariant RodSystemTableModel::data(QModelIndex const& index, int role) const
+{
+    if (!index.isValid() || !mpRodSystem)
+        return QVariant();
+    int iRow = index.row();
+    if (role == Qt::TextAlignmentRole)
+        return Qt::AlignCenter;
+    if (index.column() == kDistance)
     {
-        clearContent();
-        return;
+        double distance = mpRodSystem->distances()[iRow];
+        if (role == Qt::DisplayRole)
+            return QString::number(distance);
+        if (role == Qt::EditRole || role == Qt::UserRole)
+            return distance;
+        return QVariant();
     }
-    updateContent();
+    if (role != Qt::DisplayRole || iRow >= (int)mLengths.size() || std::isnan(mLengths[iRow]))
+        return QVariant();
+    double length = mLengths[iRow];
+    if (index.column() == kLength)
+        return QString::number(length, 'g', 8);
+    return QString::number(mpRodSystem->massPerLength() * length);
 }
 
-//! Represent all data of a rod system
-void RodSystemTableModel::updateContent()
+QVariant RodSystemTableModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
-    clearContent();
-    if (!mpRodSystem)
-        return;
-    QStandardItem* rootItem = invisibleRootItem();
-    int numRods = mpRodSystem->numRods();
-    std::vector<double> const& distances = mpRodSystem->distances();
-    Spans spans = mpRodSystem->computeSpans();
-    for (int i = 0; i != numRods; ++i)
+    if (role != Qt::DisplayRole)
+        return QVariant();
+    if (orientation == Qt::Vertical)
+        return section + 1;
+    switch (section)
     {
-        double distance = distances[i];
-        double length   = spans.L[i];
-        double mass     = mpRodSystem->massPerLength() * length;
-        // Distance between supports
-        QStandardItem* pDistanceItem = new QStandardItem();
-        pDistanceItem->setText(QString::number(distance));
-        pDistanceItem->setData(distances[i], Qt::UserRole);
-        pDistanceItem->setTextAlignment(Qt::AlignCenter);
-        // Calculated length of a cable
-        QStandardItem* pLengthItem = new QStandardItem();
-        pLengthItem->setText(QString::number(length, 'g', 8));
-        pLengthItem->setTextAlignment(Qt::AlignCenter);
-        pLengthItem->setEditable(false);
-        // Mass of cable
-        QStandardItem* pMassItem = new QStandardItem();
-        pMassItem->setText(QString::number(mass));
-        pMassItem->setTextAlignment(Qt::AlignCenter);
-        pMassItem->setEditable(false);
-        // Resulted row
-        rootItem->appendRow({pDistanceItem, pLengthItem, pMassItem});
+    case kDistance:
+        return tr("Длина пролета, м");
+    case kLength:
+        return tr("Длина провода, м");
+    case kMass:
+        return tr("Масса провода, кг");
+    default:
+        return QVariant();
     }
 }
 
-//! Remove all the objects created
-void RodSystemTableModel::clearContent()
+//! Only distances between supports are editable
+Qt::ItemFlags RodSystemTableModel::flags(QModelIndex const& index) const
 {
-    removeRows(0, rowCount());
+    Qt::ItemFlags result = QAbstractTableModel::flags(index);
+    if (index.isValid() && index.column() == kDistance)
+        result |= Qt::ItemIsEditable;
+    return result;
 }
 
-//! Set the changed distances between supports
-void RodSystemTableModel::setChangedData(QStandardItem* pItem)
+//! Set the changed distance between supports
+bool RodSystemTableModel::setData(QModelIndex const& index, QVariant const& value, int role)
 {
-    if (pItem->index().column() != 0)
-        return;
-    int iRow = pItem->index().row();
-    QStandardItem* pRootItem = invisibleRootItem();
-    QStandardItem* pChild = pRootItem->child(iRow, 0);
+    if (!mpRodSystem || !index.isValid() || index.column() != kDistance || (role != Qt::EditRole && role != Qt::UserRole))
+        return false;
+    bool isOk = false;
+    double distance = value.toDouble(&isOk);
+    if (!isOk || !(distance > 0.0))
+        return false;
     std::vector<double> distances = mpRodSystem->distances();
-    distances[iRow] = pChild->data(Qt::UserRole).toDouble();
+    if (distances[index.row()] == distance)
+        return true;
+    distances[index.row()] = distance;
     mpRodSystem->setDistances(distances);
-    emit modified();
+    emit dataChanged(index, index);
+    notifyModified();
+    return true;
+}
+
+//! Compute the spans immediately
+void RodSystemTableModel::updateContent()
+{
+    mUpdateTimer.stop();
+    computeSpans();
+}
+
+//! Compute the spans after the edits have settled, so that a series of changes results in a single computation
+void RodSystemTableModel::requestUpdate()
+{
+    mUpdateTimer.start();
 }
 
 //! Insert fresh rows after selected ones
 void RodSystemTableModel::insertAfterSelected()
 {
     const double kDefaultInsertValue = 1.0;
-    const int kMaxNumRods = 10;
 
     // Check if the actual number of rods is higher than the maximal limit
-    if (mpRodSystem->numRods() >= kMaxNumRods)
+    if (!mpRodSystem || mpRodSystem->numRods() >= skMaxNumRods)
         return;
-    // Obtain the selection
-    QTableView* pParent = (QTableView*) parent();
-    QItemSelectionModel* pSelectionModel = pParent->selectionModel();
-    QModelIndexList itemIndices = pSelectionModel->selectedIndexes();
-    // Insert after the first selected item
+    // Insert after the first selected item a copy of it
+    std::vector<int> rows = selectedRows();
     std::vector<double> distances = mpRodSystem->distances();
-    if (!itemIndices.empty() && !distances.empty())
+    int iRow = distances.size();
+    double distance = distances.empty() ? kDefaultInsertValue : distances.back();
+    if (!rows.empty() && !distances.empty())
     {
-        int iRod = itemIndices[0].row();
-        std::vector<double>::iterator it = distances.begin() + iRod;
-        distances.insert(it, distances[iRod]);
+        iRow = rows.front() + 1;
+        distance = distances[rows.front()];
     }
-    else if (!distances.empty())
+    distances.insert(distances.begin() + iRow, distance);
+    beginInsertRows(QModelIndex(), iRow, iRow);
+    mLengths.insert(mLengths.begin() + std::min<std::size_t>(iRow, mLengths.size()), std::numeric_limits<double>::quiet_NaN());
+    mpRodSystem->setDistances(distances);
+    endInsertRows();
+    notifyModified();
+}
+
+//! Remove the selected rows, so that each contiguous range is reported to views at once
+void RodSystemTableModel::removeSelected()
+{
+    if (!mpRodSystem)
+        return;
+    std::vector<int> rows = selectedRows();
+    // Discard the result which deletes all the rods
+    if (rows.empty() || (int)rows.size() == mpRodSystem->numRods())
+        return;
+    std::vector<double> distances = mpRodSystem->distances();
+    // Remove the ranges starting from the last one not to shift the preceding rows
+    auto iterEnd = rows.rbegin();
+    while (iterEnd != rows.rend())
     {
-        distances.push_back(distances.back());
+        int iLast = *iterEnd;
+        int iFirst = iLast;
+        for (++iterEnd; iterEnd != rows.rend() && *iterEnd == iFirst - 1; ++iterEnd)
+            --iFirst;
+        beginRemoveRows(QModelIndex(), iFirst, iLast);
+        distances.erase(distances.begin() + iFirst, distances.begin() + iLast + 1);
+        if (iFirst < (int)mLengths.size())
+            mLengths.erase(mLengths.begin() + iFirst, mLengths.begin() + std::min<std::size_t>(iLast + 1, mLengths.size()));
+        mpRodSystem->setDistances(distances);
+        endRemoveRows();
     }
-    else
+    notifyModified();
+}
+
+/*!
+ * \brief Paste distances from the clipboard
+ *
+ * The distances overwrite the rows starting from the first selected one and extend the table, if needed.
+ * If no rows are selected, the distances are appended.
+ */
+bool RodSystemTableModel::pasteDistances()
+{
+    if (!mpRodSystem)
+        return false;
+    std::vector<double> values = parseDistances(QGuiApplication::clipboard()->text(), mErrorString);
+    if (values.empty())
+        return false;
+    std::vector<int> rows = selectedRows();
+    setDistances(rows.empty() ? rowCount() : rows.front(), values);
+    return true;
+}
+
+//! Replace all the distances with the ones read from a CSV file
+bool RodSystemTableModel::importDistances(QString const& pathFile)
+{
+    if (!mpRodSystem)
+        return false;
+    QFile file(pathFile);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
     {
-        distances.push_back(kDefaultInsertValue);
+        mErrorString = tr("Не удалось открыть файл %1").arg(pathFile);
+        return false;
     }
-    mpRodSystem->setDistances(distances);
-    emit modified();
+    std::vector<double> values = parseDistances(QString::fromUtf8(file.readAll()), mErrorString);
+    if (values.empty())
+        return false;
+    beginResetModel();
+    mLengths.assign(values.size(), std::numeric_limits<double>::quiet_NaN());
+    mpRodSystem->setDistances(values);
+    endResetModel();
+    notifyModified();
+    return true;
 }
 
-//! Remove the selected rows
-void RodSystemTableModel::removeSelected()
+/*!
+ * \brief Overwrite the distances starting from the specified row as a single batch
+ *
+ * Views are notified about the appended rows and changed values once, and the spans are computed once afterwards
+ */
+void RodSystemTableModel::setDistances(int iStartRow, std::vector<double> const& values)
 {
-    // Acquire the selection
-    QTableView* pParent = (QTableView*) parent();
-    QItemSelectionModel* pSelectionModel = pParent->selectionModel();
-    QModelIndexList itemIndices = pSelectionModel->selectedIndexes();
-    // Set the removing mask
-    int numRods = mpRodSystem->numRods();
-    std::vector<bool> mask(numRods);
-    std::fill(mask.begin(), mask.end(), true);
-    int numSelected = itemIndices.size();
-    for (int i = 0; i != numSelected; ++i)
+    if (!mpRodSystem || values.empty())
+        return;
+    std::vector<double> distances = mpRodSystem->distances();
+    int numOldRows = distances.size();
+    iStartRow = std::clamp(iStartRow, 0, numOldRows);
+    int numNewRows = std::min<int>(std::max<int>(numOldRows, iStartRow + values.size()), skMaxNumRods);
+    int numValues = numNewRows - iStartRow;
+    if (numValues <= 0)
+        return;
+    distances.resize(numNewRows);
+    std::copy_n(values.begin(), numValues, distances.begin() + iStartRow);
+    if (numNewRows > numOldRows)
     {
-        int iRow = itemIndices[i].row();
-        mask[iRow] = false;
+        beginInsertRows(QModelIndex(), numOldRows, numNewRows - 1);
+        mLengths.resize(numNewRows, std::numeric_limits<double>::quiet_NaN());
+        mpRodSystem->setDistances(distances);
+        endInsertRows();
     }
-    std::vector<double> distances = mpRodSystem->distances();
-    // Copy the resulted distances
-    std::vector<double> resultDistances;
-    for (int i = 0; i != numRods; ++i)
+    else
     {
-        if (mask[i])
-            resultDistances.push_back(distances[i]);
+        mpRodSystem->setDistances(distances);
     }
-    // Discard the result which deletes all the rods
-    if (resultDistances.empty())
+    int iLastChanged = std::min(iStartRow + numValues, numOldRows) - 1;
+    if (iLastChanged >= iStartRow)
+        emit dataChanged(index(iStartRow, kDistance), index(iLastChanged, kDistance));
+    notifyModified();
+}
+
+/*!
+ * \brief Parse distances separated by whitespaces, semicolons or commas
+ *
+ * Commas are treated as decimal separators only if values are separated by tabulations or semicolons, as spreadsheets do,
+ * otherwise they separate values. Lines which do not contain anything resembling a number, such as headers, are skipped,
+ * while lines which mix numbers with other fields are rejected.
+ * \return Distances or an empty vector, if the text contains invalid values
+ */
+std::vector<double> RodSystemTableModel::parseDistances(QString const& text, QString& errorString)
+{
+    static QRegularExpression const skNumberLike("^[-+]?[.,]?\\d");
+    QStringList lines = text.split('\n');
+    bool isDecimalComma = text.contains('\t') || text.contains(';');
+    QRegularExpression separators(isDecimalComma ? "[\\s;]+" : "[\\s;,]+");
+    QLocale locale = QLocale::c();
+    std::vector<double> result;
+    for (int iLine = 0; iLine != lines.size(); ++iLine)
+    {
+        QStringList fields = lines[iLine].split(separators, Qt::SkipEmptyParts);
+        bool isHeader = true;
+        std::size_t numParsed = result.size();
+        for (QString& field : fields)
+        {
+            if (isDecimalComma)
+                field.replace(',', '.');
+            bool isOk = false;
+            double value = locale.toDouble(field, &isOk);
+            if (!isOk)
+            {
+                // Malformed numbers are not taken for text
+                if (skNumberLike.match(field).hasMatch())
+                {
+                    errorString = tr("Недопустимое значение '%1' в строке %2").arg(field).arg(iLine + 1);
+                    return {};
+                }
+                continue;
+            }
+            isHeader = false;
+            if (!(value > 0.0) || !std::isfinite(value))
+            {
+                errorString = tr("Недопустимая длина пролета '%1' в строке %2").arg(field).arg(iLine + 1);
+                return {};
+            }
+            result.push_back(value);
+        }
+        // Only whole lines of text can be skipped
+        if (!isHeader && result.size() - numParsed != (std::size_t)fields.size())
+        {
+            errorString = tr("Не удалось распознать строку %1").arg(iLine + 1);
+            return {};
+        }
+    }
+    if (result.empty())
+        errorString = tr("Длины пролетов не найдены");
+    return result;
+}
+
+//! Compute the spans and refresh the dependent columns
+void RodSystemTableModel::computeSpans()
+{
+    if (!mpRodSystem)
         return;
-    mpRodSystem->setDistances(resultDistances);
+    int numRods = mpRodSystem->numRods();
+    auto iSurrogate = std::find_if(mSurrogates.begin(), mSurrogates.end(), [this](SpanSurrogate const& surrogate)
+                                   { return surrogate.nameCable() == mpRodSystem->nameCable(); });
+    if (iSurrogate != mSurrogates.end())
+        mLengths = iSurrogate->computeSpans(*mpRodSystem, skSurrogateTolerance).L;
+    else
+        mLengths = mpRodSystem->computeSpans().L;
+    mLengths.resize(numRods, std::numeric_limits<double>::quiet_NaN());
+    if (numRods > 0)
+        emit dataChanged(index(0, kLength), index(numRods - 1, kMass));
+}
+
+//! Report the modification of the distances once the views have been notified and postpone the computation of spans
+void RodSystemTableModel::notifyModified()
+{
     emit modified();
+    requestUpdate();
+}
+
+//! Acquire the sorted indices of the selected rows
+std::vector<int> RodSystemTableModel::selectedRows() const
+{
+    std::vector<int> result;
+    QTableView* pParent = qobject_cast<QTableView*>(parent());
+    if (!pParent || !pParent->selectionModel())
+        return result;
+    QModelIndexList itemIndices = pParent->selectionModel()->selectedIndexes();
+    result.reserve(itemIndices.size());
+    for (QModelIndex const& itemIndex : itemIndices)
+        result.push_back(itemIndex.row());
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
 }
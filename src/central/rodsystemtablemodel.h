@@ -8,41 +8,73 @@
 #ifndef RODSYSTEMTABLEMODEL_H
 #define RODSYSTEMTABLEMODEL_H
 
-#include <QStandardItemModel>
+#include <QAbstractTableModel>
+#include <QTimer>
+#include <vector>
+#include "core/spansurrogate.h"
 
 namespace RSE
 {
 
-namespace Core
-{
-class RodSystem;
-}
-
 namespace Models
 {
 
-//! Table model to set and represent data of a rod system
-class RodSystemTableModel : public QStandardItemModel
+/*!
+ * \brief Table model to set and represent data of a rod system
+ *
+ * Distances between supports are read from a rod system directly, while lengths of cables are cached.
+ * Edits are applied row by row and the spans are recomputed once the edits have settled
+ */
+class RodSystemTableModel : public QAbstractTableModel
 {
     Q_OBJECT
 
 public:
+    enum Column
+    {
+        kDistance,
+        kLength,
+        kMass,
+        kNumColumns
+    };
     RodSystemTableModel(QObject* pParent = nullptr);
     ~RodSystemTableModel() = default;
     void setRodSystem(Core::RodSystem* pRodSystem);
+    void setSurrogates(std::vector<Core::SpanSurrogate> surrogates);
+    int rowCount(QModelIndex const& parent = QModelIndex()) const override;
+    int columnCount(QModelIndex const& parent = QModelIndex()) const override;
+    QVariant data(QModelIndex const& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(QModelIndex const& index) const override;
+    bool setData(QModelIndex const& index, QVariant const& value, int role = Qt::EditRole) override;
     void updateContent();
+    void requestUpdate();
     void insertAfterSelected();
     void removeSelected();
+    bool pasteDistances();
+    bool importDistances(QString const& pathFile);
+    void setDistances(int iStartRow, std::vector<double> const& values);
+    QString const& errorString() const { return mErrorString; }
+    static std::vector<double> parseDistances(QString const& text, QString& errorString);
 
 signals:
     void modified();
 
 private:
-    void clearContent();
-    void setChangedData(QStandardItem* pItem);
+    void computeSpans();
+    void notifyModified();
+    std::vector<int> selectedRows() const;
 
 private:
     Core::RodSystem* mpRodSystem = nullptr;
+    //! Lengths of cables computed previously, NaN denotes rows which have not been computed yet
+    std::vector<double> mLengths;
+    //! Tabulated solutions of single spans used instead of the exact solution where they are accurate enough
+    std::vector<Core::SpanSurrogate> mSurrogates;
+    //! Timer to postpone the computation of spans until edits are finished
+    QTimer mUpdateTimer;
+    //! Description of the last error occurred while entering distances
+    QString mErrorString;
 };
 
 }
@@ -5,17 +5,31 @@
  * \brief Implementation of the AbstractDataObject class
  */
 
+#include <algorithm>
 #include "abstractdataobject.h"
 #include "constants.h"
+#include "prnwriter.h"
+#include "prnreader.h"
 
 using namespace RSE::Core;
 
-DataIDType AbstractDataObject::smMaxObjectID = 0;
+std::atomic<DataIDType> AbstractDataObject::smMaxObjectID = 0;
+//! Marker written instead of an identifier to denote the block format, since identifiers are positive
+static DataIDType const skBlockMarker = -1;
+//! Version of the block format
+static quint32 const skBlockVersion = 1;
 
-//! Base constructor
-AbstractDataObject::AbstractDataObject(ObjectType type, QString const& name)
+/*!
+ * \brief Base constructor
+ * \param numItemRows Number of rows of each item
+ * \param numItemCols Number of columns of each item
+ */
+AbstractDataObject::AbstractDataObject(ObjectType type, QString const& name, IndexType numItemRows, IndexType numItemCols)
     : mkType(type)
     , mName(name)
+    , mNumItemRows(numItemRows)
+    , mNumItemCols(numItemCols)
+    , mpItems(new DataItems)
 {
     mID = ++smMaxObjectID;
 }
@@ -25,68 +39,123 @@ AbstractDataObject::~AbstractDataObject()
 
 }
 
-//! Modify an existing key
-bool AbstractDataObject::changeItemKey(DataKeyType oldKey, DataKeyType newKey, DataHolder* items)
+//! Insert a new item filled with zeros after all the items with the same or lower keys
+DataItemType AbstractDataObject::addItem(DataKeyType key)
+{
+    DataItems& items = *mpItems;
+    IndexType size = itemSize();
+    quint32 iItem = std::upper_bound(items.keys.begin(), items.keys.end(), key) - items.keys.begin();
+    items.keys.insert(items.keys.begin() + iItem, key);
+    items.values.insert(items.values.begin() + iItem * size, size, 0.0);
+    return item(iItem);
+}
+
+//! Modify an existing key, so that the item is moved to keep the keys sorted
+bool AbstractDataObject::changeItemKey(DataKeyType oldKey, DataKeyType newKey)
 {
-    if (!items)
-        items = &mItems;
     // If the table does not contain the old key or the new one is already presented
-    auto iterOldKey = items->find(oldKey);
-    auto iterNewKey = items->find(newKey);
-    if (iterOldKey == items->end() || iterNewKey != items->end())
+    int iOldItem = findItem(oldKey);
+    if (iOldItem < 0 || findItem(newKey) >= 0)
         return false;
-    DataItemType obj = iterOldKey->second;
-    items->erase(oldKey);
-    items->emplace(newKey, std::move(obj));
+    // Move the item to the position of the new key
+    DataItems& items = *mpItems;
+    IndexType size = itemSize();
+    auto iterKeys = items.keys.begin();
+    auto iterValues = items.values.begin();
+    int iNewItem = std::upper_bound(items.keys.begin(), items.keys.end(), newKey) - iterKeys;
+    if (iNewItem > iOldItem)
+    {
+        std::rotate(iterValues + iOldItem * size, iterValues + (iOldItem + 1) * size, iterValues + iNewItem * size);
+        std::rotate(iterKeys + iOldItem, iterKeys + iOldItem + 1, iterKeys + iNewItem);
+        --iNewItem;
+    }
+    else
+    {
+        std::rotate(iterValues + iNewItem * size, iterValues + iOldItem * size, iterValues + (iOldItem + 1) * size);
+        std::rotate(iterKeys + iNewItem, iterKeys + iOldItem, iterKeys + iOldItem + 1);
+    }
+    items.keys[iNewItem] = newKey;
     return true;
 }
 
-//! Remove the entity paired to the specified key
+//! Remove all the entities paired to the specified key
 void AbstractDataObject::removeItem(DataKeyType key)
 {
-    mItems.erase(key);
+    if (findItem(key) < 0)
+        return;
+    DataItems& items = *mpItems;
+    auto [iterStart, iterEnd] = std::equal_range(items.keys.begin(), items.keys.end(), key);
+    IndexType size = itemSize();
+    auto iterValues = items.values.begin();
+    items.values.erase(iterValues + (iterStart - items.keys.begin()) * size, iterValues + (iterEnd - items.keys.begin()) * size);
+    items.keys.erase(iterStart, iterEnd);
 }
 
 //! Set an array value with the specified indices
 bool AbstractDataObject::setArrayValue(DataKeyType key, DataValueType newValue, IndexType iRow, IndexType iColumn)
 {
-    auto iterKey = mItems.find(key);
-    if (iterKey == mItems.end())
+    int iItem = findItem(key);
+    if (iItem < 0)
         return false;
-    DataItemType& array = iterKey->second;
-    array[iRow][iColumn] = newValue;
+    itemData(iItem)[iRow * mNumItemCols + iColumn] = newValue;
     return true;
 }
 
 //! Retrieve a value from an array
-DataValueType AbstractDataObject::arrayValue(DataKeyType key, IndexType iRow, IndexType iColumn)
+DataValueType AbstractDataObject::arrayValue(DataKeyType key, IndexType iRow, IndexType iColumn) const
 {
-    auto iterKey = mItems.find(key);
-    DataItemType& array = iterKey->second;
-    return array[iRow][iColumn];
+    int iItem = findItem(key);
+    if (iItem < 0)
+        return 0.0;
+    return itemData(iItem)[iRow * mNumItemCols + iColumn];
 }
 
-//! Retrieve all the keys
-std::vector<DataKeyType> AbstractDataObject::keys() const
+//! Find the index of the first item paired to the specified key, -1 is returned if it is not found
+int AbstractDataObject::findItem(DataKeyType key) const
 {
-    std::vector<DataKeyType> keys;
-    for (auto const& item : mItems)
-        keys.push_back(item.first);
-    return keys;
+    std::vector<DataKeyType> const& keys = mpItems->keys;
+    auto iterKey = std::lower_bound(keys.begin(), keys.end(), key);
+    if (iterKey == keys.end() || *iterKey != key)
+        return -1;
+    return iterKey - keys.begin();
 }
 
-//! Serialize an abstract data object
+//! Remove all the items without copying the shared ones
+void AbstractDataObject::clearItems()
+{
+    if (mpItems.constData()->ref.loadRelaxed() > 1)
+    {
+        mpItems.reset(new DataItems);
+        return;
+    }
+    mpItems->keys.clear();
+    mpItems->values.clear();
+}
+
+//! Allocate the storage for the specified number of items
+void AbstractDataObject::reserveItems(quint32 numItems)
+{
+    mpItems->keys.reserve(numItems);
+    mpItems->values.reserve(numItems * itemSize());
+}
+
+/*!
+ * \brief Serialize an abstract data object
+ *
+ * The keys and values of all the items are written as two blocks of little-endian numbers
+ */
 void AbstractDataObject::serialize(QDataStream& stream) const
 {
     stream << (quint32)mkType;
     stream << mName;
+    stream << skBlockMarker << skBlockVersion;
     stream << (DataIDType)mID;
-    stream << (quint32)mItems.size();
-    for (auto& item : mItems)
-    {
-        stream << item.first;
-        stream << item.second;
-    }
+    stream << mNumItemRows << mNumItemCols;
+    std::vector<DataKeyType> const& keys = mpItems->keys;
+    std::vector<DataValueType> const& values = mpItems->values;
+    stream << (quint32)keys.size();
+    writeBlock(stream, keys.data(), keys.size());
+    writeBlock(stream, values.data(), values.size());
 }
 
 /*!
@@ -94,28 +163,164 @@ void AbstractDataObject::serialize(QDataStream& stream) const
  *
  * It is assumed that a type and name have already been assigned.
  * So, only an identifier and items need to be set.
+ * Both the block format and the previous one, where items are written one by one, are supported.
+ * Items of a different shape are truncated or padded with zeros.
  */
 void AbstractDataObject::deserialize(QDataStream& stream)
 {
-    mItems.clear();
+    clearItems();
     quint32 numItems;
-    DataKeyType key;
     stream >> mID;
+    if (mID == skBlockMarker)
+    {
+        quint32 version;
+        IndexType numRows, numCols;
+        stream >> version;
+        if (version > skBlockVersion)
+        {
+            stream.setStatus(QDataStream::ReadCorruptData);
+            return;
+        }
+        stream >> mID >> numRows >> numCols >> numItems;
+        if (stream.status() != QDataStream::Ok)
+            return;
+        // Check the sizes of blocks before allocating them
+        quint64 itemSize = (quint64)numRows * numCols;
+        quint64 numValues = itemSize * numItems;
+        if ((numItems != 0 && numValues / numItems != itemSize) || !checkBlock<DataKeyType>(stream, numItems)
+            || !checkBlock<DataValueType>(stream, numValues))
+        {
+            stream.setStatus(QDataStream::ReadCorruptData);
+            return;
+        }
+        if (mIsVariableRows)
+            mNumItemRows = numRows;
+        std::vector<DataKeyType> keys(numItems);
+        std::vector<DataValueType> values(numValues);
+        if (!readBlock(stream, keys.data(), keys.size()) || !readBlock(stream, values.data(), values.size()))
+            return;
+        // Take the blocks as they are, if it is possible
+        if (numRows == mNumItemRows && numCols == mNumItemCols && std::is_sorted(keys.begin(), keys.end()))
+        {
+            mpItems->keys = std::move(keys);
+            mpItems->values = std::move(values);
+            return;
+        }
+        reserveItems(numItems);
+        for (quint32 i = 0; i != numItems; ++i)
+            insertItem(keys[i], values.data() + i * itemSize, numRows, numCols);
+        return;
+    }
+    DataKeyType key;
+    Array<DataValueType> array;
     stream >> numItems;
+    // Each item holds at least its key
+    if (stream.status() != QDataStream::Ok || !checkBlock<DataKeyType>(stream, numItems))
+        return;
+    reserveItems(numItems);
     for (quint32 i = 0; i != numItems; ++i)
     {
-        DataItemType dataItem;
         stream >> key;
-        stream >> dataItem;
-        mItems.emplace(key, dataItem);
+        stream >> array;
+        if (stream.status() != QDataStream::Ok)
+            return;
+        insertItem(key, array.data(), array.rows(), array.cols());
+    }
+}
+
+//! Insert an item whose values are truncated or padded with zeros to fit the shape of items
+void AbstractDataObject::insertItem(DataKeyType key, DataValueType const* pValues, IndexType numRows, IndexType numCols)
+{
+    DataItemType dataItem = addItem(key);
+    IndexType minNumRows = std::min(numRows, mNumItemRows);
+    IndexType minNumCols = std::min(numCols, mNumItemCols);
+    for (IndexType iRow = 0; iRow != minNumRows; ++iRow)
+        std::copy_n(&pValues[iRow * numCols], minNumCols, dataItem[iRow]);
+}
+
+/*!
+ * \brief Import a data object from a text file
+ *
+ * The header consists of the number of items followed by the number of rows of each item, if it is variable.
+ * Each item is specified by its key followed by its values.
+ * Items are appended directly to the storage while their keys are sorted.
+ * \return Whether the data object has been read successfully. Otherwise, the reader contains the error description
+ */
+bool AbstractDataObject::import(PrnReader& reader)
+{
+    clearItems();
+    quint32 numItems;
+    if (!reader.read(numItems))
+        return false;
+    if (mIsVariableRows && !reader.read(mNumItemRows))
+        return false;
+    reader.skipLine();
+    reserveItems(numItems);
+    DataItems& items = *mpItems;
+    IndexType size = itemSize();
+    DataKeyType key;
+    for (quint32 iItem = 0; iItem != numItems; ++iItem)
+    {
+        if (!reader.read(key))
+            return false;
+        DataValueType* pData;
+        if (items.keys.empty() || items.keys.back() <= key)
+        {
+            items.keys.push_back(key);
+            items.values.resize(items.values.size() + size);
+            pData = &items.values[items.values.size() - size];
+        }
+        else
+        {
+            pData = addItem(key).data();
+        }
+        for (IndexType i = 0; i != size; ++i)
+        {
+            if (!reader.read(pData[i]))
+                return false;
+        }
     }
+    return true;
 }
 
 //! Write an abstract data object to a file
 void AbstractDataObject::write(QTextStream& stream) const
 {
-    stream << mItems.size() << 1;
+    int const kPrecision = RSE::Constants::kWritingPrecision;
+    std::vector<DataKeyType> const& keys = mpItems->keys;
+    quint32 numItems = keys.size();
+    stream << numItems << (mIsVariableRows ? mNumItemRows : 1);
     stream << Qt::endl;
-    for (auto& item : mItems)
-        stream << QString::number(item.first, 'g', RSE::Constants::kWritingPrecision) << item.second;
+    for (quint32 iItem = 0; iItem != numItems; ++iItem)
+    {
+        stream << QString::number(keys[iItem], 'g', kPrecision);
+        DataValueType const* pData = itemData(iItem);
+        for (IndexType iRow = 0; iRow != mNumItemRows; ++iRow)
+        {
+            for (IndexType jCol = 0; jCol != mNumItemCols; ++jCol)
+                stream << QString::number(pData[iRow * mNumItemCols + jCol], 'g', kPrecision);
+            stream << Qt::endl;
+        }
+    }
+}
+
+//! Write an abstract data object using the fast formatter
+void AbstractDataObject::write(PrnWriter& writer) const
+{
+    std::vector<DataKeyType> const& keys = mpItems->keys;
+    quint32 numItems = keys.size();
+    writer.write(numItems);
+    writer.write(mIsVariableRows ? mNumItemRows : 1);
+    writer.endLine();
+    for (quint32 iItem = 0; iItem != numItems; ++iItem)
+    {
+        writer.write(keys[iItem]);
+        DataValueType const* pData = itemData(iItem);
+        for (IndexType iRow = 0; iRow != mNumItemRows; ++iRow)
+        {
+            for (IndexType jCol = 0; jCol != mNumItemCols; ++jCol)
+                writer.write(pData[iRow * mNumItemCols + jCol]);
+            writer.endLine();
+        }
+    }
 }
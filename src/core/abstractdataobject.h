@@ -11,15 +11,44 @@
 #include <QObject>
 #include <QString>
 #include <QDataStream>
-#include <map>
+#include <QSharedData>
+#include <atomic>
+#include <vector>
 #include "array.h"
 #include "aliasdata.h"
 
 namespace RSE::Core
 {
 
-using DataItemType = Array<DataValueType>;
-using DataHolder = std::multimap<DataKeyType, DataItemType>;
+class PrnWriter;
+class PrnReader;
+
+//! Reference to values of an item which are stored contiguously in a data object
+class DataItem
+{
+public:
+    DataItem(DataValueType* pData, IndexType numCols) : mpData(pData), mNumCols(numCols) { }
+    ~DataItem() { }
+    DataValueType* operator[](IndexType iRow) { return &mpData[mNumCols * iRow]; }
+    DataValueType* data() { return mpData; }
+
+private:
+    //! Pointer to the first value of an item
+    DataValueType* mpData;
+    //! Number of columns of an item
+    IndexType mNumCols;
+};
+
+using DataItemType = DataItem;
+
+//! Storage of items sorted by keys
+struct DataItems : public QSharedData
+{
+    //! Sorted keys of items
+    std::vector<DataKeyType> keys;
+    //! Values of items packed in the order of keys
+    std::vector<DataValueType> values;
+};
 
 //! Data object which is designied in the way to be represented in a table easily
 class AbstractDataObject : public QObject
@@ -32,17 +61,19 @@ public:
         kMatrix,
         kSurface
     };
-    AbstractDataObject(ObjectType type, QString const& name);
+    AbstractDataObject(ObjectType type, QString const& name, IndexType numItemRows, IndexType numItemCols);
     virtual ~AbstractDataObject() = 0;
     virtual AbstractDataObject* clone() const = 0;
-    virtual DataItemType& addItem(DataKeyType key) = 0;
-    void removeItem(DataValueType key);
-    bool changeItemKey(DataKeyType oldKey, DataKeyType newKey, DataHolder* items = nullptr);
+    DataItemType addItem(DataKeyType key);
+    DataItemType item(quint32 iItem) { return DataItemType(itemData(iItem), mNumItemCols); }
+    void removeItem(DataKeyType key);
+    bool changeItemKey(DataKeyType oldKey, DataKeyType newKey);
     bool setArrayValue(DataKeyType key, DataValueType newValue, IndexType iRow = 0, IndexType iColumn = 0);
-    DataValueType arrayValue(DataKeyType key, IndexType iRow = 0, IndexType iColumn = 0);
-    std::vector<DataKeyType> keys() const;
-    quint32 numberItems() const { return mItems.size(); }
-    DataHolder const& getItems() { return mItems; }
+    DataValueType arrayValue(DataKeyType key, IndexType iRow = 0, IndexType iColumn = 0) const;
+    std::vector<DataKeyType> const& keys() const { return mpItems->keys; }
+    quint32 numberItems() const { return mpItems->keys.size(); }
+    IndexType numberItemRows() const { return mNumItemRows; }
+    IndexType numberItemCols() const { return mNumItemCols; }
     DataIDType id() const { return mID; }
     ObjectType type() const { return mkType; }
     QString const& name() const { return mName; }
@@ -52,19 +83,38 @@ public:
     virtual void serialize(QDataStream& stream) const;
     virtual void deserialize(QDataStream& stream);
     friend QDataStream& operator<<(QDataStream& stream, AbstractDataObject const& obj);
-    virtual void import(QTextStream& stream) = 0;
+    virtual bool import(PrnReader& reader);
     void write(QTextStream& stream) const;
+    void write(PrnWriter& writer) const;
+
+protected:
+    IndexType itemSize() const { return mNumItemRows * mNumItemCols; }
+    DataValueType* itemData(quint32 iItem) { return mpItems->values.data() + itemSize() * iItem; }
+    DataValueType const* itemData(quint32 iItem) const { return mpItems->values.data() + itemSize() * iItem; }
+    int findItem(DataKeyType key) const;
+    void insertItem(DataKeyType key, DataValueType const* pValues, IndexType numRows, IndexType numCols);
+    void clearItems();
+    void reserveItems(quint32 numItems);
 
 protected:
     const ObjectType mkType;
     QString mName;
     DataIDType mID;
-    DataHolder mItems;
+    //! Number of rows of each item
+    IndexType mNumItemRows;
+    //! Number of columns of each item
+    IndexType mNumItemCols;
+    //! Flag which indicates whether the number of rows of items is read from files rather than fixed
+    bool mIsVariableRows = false;
+    //! Items shared between copies of a data object until one of them is modified
+    QSharedDataPointer<DataItems> mpItems;
 
 private:
-    static DataIDType smMaxObjectID;
+    static std::atomic<DataIDType> smMaxObjectID;
 };
 
+using DataObjects = std::vector<AbstractDataObject*>;
+
 //! Print a data object to a binary stream
 inline QDataStream& operator<<(QDataStream& stream, AbstractDataObject const& obj)
 {
@@ -5,6 +5,9 @@
  * \brief Implementation of the Array class
  */
 
+#include <algorithm>
+#include <cstring>
+#include <new>
 #include "array.h"
 
 template class RSE::Core::Array<double>;
@@ -16,53 +19,59 @@ Array<T>::Array(IndexType numRows, IndexType numCols)
     , mNumCols(numCols)
 {
     const IndexType& curSize = size();
-    mpData = new T[curSize];
-    for (IndexType i = 0; i != curSize; ++i)
-        mpData[i] = 0.0;
+    reserve(curSize);
+    std::fill(mpData, mpData + curSize, T(0));
 }
 
 //! Copy constructor
 template<typename T>
 Array<T>::Array(Array<T> const& another)
+    : mNumRows(another.mNumRows)
+    , mNumCols(another.mNumCols)
 {
-    const IndexType& newSize = another.size();
-    mpData = new T[newSize];
-    for (IndexType i = 0; i != newSize; ++i)
-        mpData[i] = another.mpData[i];
-    mNumRows = another.mNumRows;
-    mNumCols = another.mNumCols;
+    const IndexType& newSize = size();
+    reserve(newSize);
+    std::memcpy(mpData, another.mpData, newSize * sizeof(T));
 }
 
 //! Move constructor
 template<typename T>
 Array<T>::Array(Array<T>&& another)
 {
-    std::swap(mpData, another.mpData);
-    mNumRows = std::exchange(another.mNumRows, 0);
-    mNumCols = std::exchange(another.mNumCols, 0);
+    moveFrom(another);
 }
 
-//! Assignment operator
+//! Assignment operator which reuses the allocated storage if possible
 template<typename T>
 Array<T>& Array<T>::operator=(Array<T> const& another)
 {
     if (this != &another)
     {
-        delete[] mpData;
         const IndexType& newSize = another.size();
-        mpData = new T[newSize];
-        for (IndexType i = 0; i != newSize; ++i)
-            mpData[i] = another.mpData[i];
+        reserve(newSize);
+        std::memcpy(mpData, another.mpData, newSize * sizeof(T));
         mNumRows = another.mNumRows;
         mNumCols = another.mNumCols;
     }
     return *this;
 }
 
+//! Move assignment operator
+template<typename T>
+Array<T>& Array<T>::operator=(Array<T>&& another)
+{
+    if (this != &another)
+    {
+        release();
+        moveFrom(another);
+    }
+    return *this;
+}
+
 template<typename T>
 Array<T>::~Array()
 {
-    delete[] mpData;
+    release();
 }
 
 //! Resize and copy previous values if possible
@@ -71,34 +80,40 @@ void Array<T>::resize(IndexType numRows, IndexType numCols)
 {
     if (!numRows || !numCols)
     {
-        delete[] mpData;
-        mpData = nullptr;
-        mNumRows = 0;
-        mNumCols = 0;
+        clear();
         return;
     }
     if (numRows == mNumRows && numCols == mNumCols)
         return;
     const IndexType newSize = numRows * numCols;
-    T* pData = new T[newSize];
-    // Filling with zeros
-    for (IndexType i = 0; i != newSize; ++i)
-        pData[i] = 0.0;
-    // Copying previous values
-    IndexType iCur;
-    IndexType iNew;
     IndexType minNumRows = std::min(mNumRows, numRows);
     IndexType minNumCols = std::min(mNumCols, numCols);
-    for (IndexType iRow = 0; iRow != minNumRows; ++iRow)
+    if (newSize > mCapacity)
     {
-        iCur = iRow * mNumCols;
-        iNew = iRow * numCols;
-        for (IndexType jCol = 0; jCol != minNumCols; ++jCol)
-            pData[iNew + jCol] = mpData[iCur + jCol];
+        // Copying previous values to a new storage
+        Array<T> temp(numRows, numCols);
+        for (IndexType iRow = 0; iRow != minNumRows; ++iRow)
+            std::memcpy(&temp.mpData[iRow * numCols], &mpData[iRow * mNumCols], minNumCols * sizeof(T));
+        *this = std::move(temp);
+        return;
+    }
+    // Rearranging values in place
+    if (numCols <= mNumCols)
+    {
+        for (IndexType iRow = 0; iRow != minNumRows; ++iRow)
+            std::memmove(&mpData[iRow * numCols], &mpData[iRow * mNumCols], numCols * sizeof(T));
     }
-    // Swapping
-    delete[] mpData;
-    mpData = pData;
+    else
+    {
+        for (IndexType iRow = minNumRows; iRow-- != 0; )
+        {
+            T* pRow = &mpData[iRow * numCols];
+            std::memmove(pRow, &mpData[iRow * mNumCols], mNumCols * sizeof(T));
+            std::fill(pRow + mNumCols, pRow + numCols, T(0));
+        }
+    }
+    // Filling new rows with zeros
+    std::fill(mpData + minNumRows * numCols, mpData + newSize, T(0));
     mNumRows = numRows;
     mNumCols = numCols;
 }
@@ -110,25 +125,19 @@ void Array<T>::removeColumn(IndexType iRemoveColumn)
     if (iRemoveColumn >= mNumCols)
         return;
     IndexType numCols = mNumCols - 1;
-    const IndexType newSize = mNumRows * numCols;
-    T* pData = new T[newSize];
-    IndexType k = 0;
-    IndexType iCur;
+    // Shifting values in place
+    T* pDest = mpData;
+    T const* pSource = mpData;
     for (IndexType iRow = 0; iRow != mNumRows; ++iRow)
     {
-        iCur = iRow * mNumCols;
-        for (IndexType jCol = 0; jCol != mNumCols; ++jCol)
-        {
-            if (jCol != iRemoveColumn)
-            {
-                pData[k] = mpData[iCur + jCol];
-                ++k;
-            }
-        }
+        std::memmove(pDest, pSource, iRemoveColumn * sizeof(T));
+        std::memmove(pDest + iRemoveColumn, pSource + iRemoveColumn + 1, (numCols - iRemoveColumn) * sizeof(T));
+        pDest += numCols;
+        pSource += mNumCols;
     }
-    delete[] mpData;
-    mpData = pData;
     mNumCols = numCols;
+    if (!mNumCols)
+        mNumRows = 0;
 }
 
 //! Swap two columns
@@ -138,16 +147,60 @@ void Array<T>::swapColumns(IndexType iFirstColumn, IndexType iSecondColumn)
     if (iFirstColumn >= mNumCols || iSecondColumn >= mNumCols)
         return;
     for (IndexType iRow = 0; iRow != mNumRows; ++iRow)
-        std::swap(mpData[iRow + iFirstColumn], mpData[iRow + iSecondColumn]);
+        std::swap(mpData[iRow * mNumCols + iFirstColumn], mpData[iRow * mNumCols + iSecondColumn]);
 }
 
-//! Remove all the values
+//! Assign the value to all the elements
+template<typename T>
+void Array<T>::fill(T const& value)
+{
+    std::fill(mpData, mpData + size(), value);
+}
+
+//! Remove all the values, while keeping the storage allocated
 template<typename T>
 void Array<T>::clear()
 {
-    delete[] mpData;
-    mpData = nullptr;
     mNumRows = 0;
     mNumCols = 0;
 }
 
+//! Make sure that the storage is able to hold the specified number of values. Previous values are not preserved
+template<typename T>
+void Array<T>::reserve(IndexType newCapacity)
+{
+    if (newCapacity <= mCapacity)
+        return;
+    release();
+    mpData = static_cast<T*>(::operator new[](newCapacity * sizeof(T), std::align_val_t(skAlignment)));
+    mCapacity = newCapacity;
+}
+
+//! Free the heap storage and switch to the inline one
+template<typename T>
+void Array<T>::release()
+{
+    if (!isInline())
+        ::operator delete[](mpData, std::align_val_t(skAlignment));
+    mpData = mInlineData;
+    mCapacity = skNumInlineValues;
+}
+
+//! Take the values of another array which becomes empty
+template<typename T>
+void Array<T>::moveFrom(Array<T>& another)
+{
+    if (another.isInline())
+    {
+        std::memcpy(mInlineData, another.mInlineData, another.size() * sizeof(T));
+        mpData = mInlineData;
+        mCapacity = skNumInlineValues;
+    }
+    else
+    {
+        mpData = std::exchange(another.mpData, another.mInlineData);
+        mCapacity = std::exchange(another.mCapacity, skNumInlineValues);
+    }
+    mNumRows = std::exchange(another.mNumRows, 0);
+    mNumCols = std::exchange(another.mNumCols, 0);
+}
@@ -9,6 +9,13 @@
 #define ARRAY_H
 
 #include <QDebug>
+#include <QDataStream>
+#include <QSysInfo>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
 #include "constants.h"
 
 namespace RSE::Core
@@ -16,10 +23,26 @@ namespace RSE::Core
 
 using IndexType = quint32;
 
-//! Numerical array class
+//! Marker which precedes arrays written as raw blocks. It cannot be confused with a number of rows of the element-wise format
+static quint32 const skArrayBlockMarker = 0xFFFFFFFF;
+//! Version of the block format of arrays
+static quint32 const skArrayBlockVersion = 1;
+
+template<typename K> void writeBlock(QDataStream& stream, K const* pData, quint64 size);
+template<typename K> bool readBlock(QDataStream& stream, K* pData, quint64 size);
+template<typename K> bool checkBlock(QDataStream& stream, quint64 size);
+
+/*!
+ * \brief Numerical array class
+ *
+ * Small arrays (up to 3 x 3) are stored inline, larger ones are allocated on the heap with the cache line alignment.
+ * The allocated storage is reused while the array is shrinked, resized or assigned.
+ */
 template<typename T>
 class Array
 {
+    static_assert(std::is_trivially_copyable_v<T>, "Values of an array must be trivially copyable");
+
 private:
     template <typename U> class Row;
 
@@ -29,28 +52,46 @@ public:
     Array(Array<T>&& another);
     ~Array();
     T* data() { return mpData; }
+    T const* data() const { return mpData; }
     void resize(IndexType numRows, IndexType numCols);
     void removeColumn(IndexType iRemoveColumn);
     void swapColumns(IndexType iFirstColumn, IndexType iSecondColumn);
+    void fill(T const& value);
     void clear();
     IndexType rows() const { return mNumRows; };
     IndexType cols() const { return mNumCols; };
     IndexType size() const { return mNumRows * mNumCols; }
+    IndexType capacity() const { return mCapacity; }
+    bool isInline() const { return mpData == mInlineData; }
     Row<T> operator[](IndexType iRow) { return Row<T>(&mpData[mNumCols * iRow]); };
     Row<T> operator[](IndexType iRow) const { return Row<T>(&mpData[mNumCols * iRow]); };
     Array& operator=(Array<T> const& another);
+    Array& operator=(Array<T>&& another);
     template<typename K> friend QDebug operator<<(QDebug stream, Array<K>& array);
     template<typename K> friend QDataStream& operator<<(QDataStream& stream, Array<K> const& array);
     template<typename K> friend QDataStream& operator>>(QDataStream& stream, Array<K>& array);
     template<typename K> friend QTextStream& operator<<(QTextStream& stream, Array<K> const& array);
 
 private:
+    void reserve(IndexType newCapacity);
+    void release();
+    void moveFrom(Array<T>& another);
+
+private:
+    //! Maximal number of values stored inline
+    static constexpr IndexType skNumInlineValues = 9;
+    //! Alignment of the heap storage, bytes
+    static constexpr std::size_t skAlignment = 64;
     //! Number of rows
     IndexType mNumRows;
     //! Number of columns
     IndexType mNumCols;
+    //! Number of values which can be stored without reallocation
+    IndexType mCapacity = skNumInlineValues;
     //! Pointer to the data stored
-    T* mpData = nullptr;
+    T* mpData = mInlineData;
+    //! Storage of small arrays
+    T mInlineData[skNumInlineValues];
     //! Proxy class to acquire a row by index
     template <typename U>
     class Row
@@ -85,30 +126,111 @@ inline QDebug operator<<(QDebug stream, Array<K>& array)
     return stream;
 }
 
-//! Write an array to a binary stream
+/*!
+ * \brief Write an array to a binary stream
+ *
+ * The values are written as a single block of little-endian bytes preceded by the marker, version and shape
+ */
 template<typename K>
 inline QDataStream& operator<<(QDataStream& stream, Array<K> const& array)
 {
+    stream << skArrayBlockMarker << skArrayBlockVersion;
     stream << array.mNumRows << array.mNumCols;
-    IndexType const& size = array.size();
-    for (IndexType i = 0; i != size; ++i)
-        stream << array.mpData[i];
+    writeBlock(stream, array.mpData, array.size());
     return stream;
 }
 
-//! Read an array from a stream
+//! Read an array from a stream written either as a block or element by element
 template<typename K>
 inline QDataStream& operator>>(QDataStream& stream, Array<K>& array)
 {
-    delete[] array.mpData;
-    stream >> array.mNumRows >> array.mNumCols;
+    IndexType numRows, numCols;
+    stream >> numRows;
+    array.clear();
+    if (numRows == skArrayBlockMarker)
+    {
+        quint32 version;
+        stream >> version;
+        if (version > skArrayBlockVersion)
+        {
+            stream.setStatus(QDataStream::ReadCorruptData);
+            return stream;
+        }
+        stream >> numRows >> numCols;
+        if (stream.status() != QDataStream::Ok || !checkBlock<K>(stream, (quint64)numRows * numCols))
+            return stream;
+        array.resize(numRows, numCols);
+        if (!readBlock(stream, array.mpData, array.size()))
+            array.clear();
+        return stream;
+    }
+    stream >> numCols;
+    if (stream.status() != QDataStream::Ok || !checkBlock<K>(stream, (quint64)numRows * numCols))
+        return stream;
+    array.resize(numRows, numCols);
     IndexType const& size = array.size();
-    array.mpData = new K[size];
     for (IndexType i = 0; i != size; ++i)
         stream >> array.mpData[i];
     return stream;
 }
 
+//! Write values to a binary stream as a single block of little-endian bytes
+template<typename K>
+inline void writeBlock(QDataStream& stream, K const* pData, quint64 size)
+{
+    static_assert(std::is_trivially_copyable_v<K>);
+    quint64 numBytes = size * sizeof(K);
+    if constexpr (QSysInfo::ByteOrder == QSysInfo::LittleEndian)
+    {
+        stream.writeRawData(reinterpret_cast<char const*>(pData), numBytes);
+    }
+    else
+    {
+        std::vector<char> bytes(numBytes);
+        std::memcpy(bytes.data(), pData, numBytes);
+        for (quint64 i = 0; i != numBytes; i += sizeof(K))
+            std::reverse(&bytes[i], &bytes[i] + sizeof(K));
+        stream.writeRawData(bytes.data(), numBytes);
+    }
+}
+
+//! Read a single block of little-endian values from a binary stream
+template<typename K>
+inline bool readBlock(QDataStream& stream, K* pData, quint64 size)
+{
+    static_assert(std::is_trivially_copyable_v<K>);
+    qint64 numBytes = size * sizeof(K);
+    char* pBytes = reinterpret_cast<char*>(pData);
+    if (stream.readRawData(pBytes, numBytes) != numBytes)
+    {
+        stream.setStatus(QDataStream::ReadPastEnd);
+        return false;
+    }
+    if constexpr (QSysInfo::ByteOrder != QSysInfo::LittleEndian)
+    {
+        for (qint64 i = 0; i != numBytes; i += sizeof(K))
+            std::reverse(pBytes + i, pBytes + i + sizeof(K));
+    }
+    return true;
+}
+
+/*!
+ * \brief Check whether a block of values can be read from a binary stream before allocating it
+ *
+ * Sizes are computed in 64 bits. A block which does not fit into an array or exceeds the rest of the stream marks it as corrupted
+ */
+template<typename K>
+inline bool checkBlock(QDataStream& stream, quint64 size)
+{
+    QIODevice* pDevice = stream.device();
+    bool isValid = size <= std::numeric_limits<IndexType>::max();
+    if (isValid && pDevice)
+        isValid = size * sizeof(K) <= (quint64)pDevice->bytesAvailable();
+    if (!isValid)
+        stream.setStatus(QDataStream::ReadCorruptData);
+    return isValid;
+}
+
 //! Write an array to a text stream
 template<typename K>
 inline QTextStream& operator<<(QTextStream& stream, Array<K> const& array)
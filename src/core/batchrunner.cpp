@@ -0,0 +1,422 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the BatchRunner class
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QThreadPool>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <set>
+#include "batchrunner.h"
+#include "project.h"
+#include "io.h"
+#include "solutionoptions.h"
+
+using namespace RSE::Core;
+using namespace RSE::Solution;
+
+static QString const skColumnName    = "name";
+static QString const skColumnProject = "project";
+//! Parameters which require the spring of a damper to be recomputed
+static QStringList const skDamperParameters = {"massCable", "massLoadedCable", "workingLength", "bouncerLength"};
+
+static bool validateVariants(std::vector<BatchVariant>& variants, QString& errorString);
+
+BatchRunner::BatchRunner(DataBaseCables const& dataBaseCables, QString const& templatePath, QString const& outputPath)
+    : mDataBaseCables(dataBaseCables)
+    , mTemplatePath(templatePath)
+    , mOutputPath(outputPath)
+{
+}
+
+/*!
+ * \brief Prepare inputs of all the variants concurrently
+ * \param pathProject Project which variants are based on, unless they specify their own ones
+ * \param numThreads Number of threads used. If it is not positive, the number of cores is used
+ * \return Results in the order of variants
+ */
+std::vector<BatchResult> BatchRunner::run(QString const& pathProject, std::vector<BatchVariant> const& variants, int numThreads) const
+{
+    std::vector<BatchResult> results(variants.size());
+    QThreadPool pool;
+    pool.setMaxThreadCount(numThreads > 0 ? numThreads : QThread::idealThreadCount());
+    // Each task writes its own result only
+    for (std::size_t i = 0; i != variants.size(); ++i)
+        pool.start([this, &results, &variants, &pathProject, i]() { results[i] = runVariant(pathProject, variants[i]); });
+    pool.waitForDone();
+    return results;
+}
+
+//! Load, modify and write inputs of a variant
+BatchResult BatchRunner::runVariant(QString const& pathProject, BatchVariant const& variant) const
+{
+    QElapsedTimer timer;
+    timer.start();
+    BatchResult result;
+    result.name = variant.name;
+    result.directory = QDir(mOutputPath).absoluteFilePath(variant.name) + '/';
+    auto fail = [&result, &timer](QString const& message)
+    {
+        result.message = message;
+        result.duration = timer.elapsed();
+        return result;
+    };
+    // Load the project
+    QString pathFile = variant.pathProject.isEmpty() ? pathProject : variant.pathProject;
+    IO io(QFileInfo(pathFile).absolutePath());
+    IOPair ioPair = io.open(pathFile, mDataBaseCables);
+    std::unique_ptr<Project> pProject(ioPair.first);
+    std::unique_ptr<SolutionOptions> pOptions(ioPair.second);
+    if (!pProject || !pOptions)
+        return fail(io.errorString());
+    if (!pProject->hasTemplateData() || pProject->isTemplateOutdated(mTemplatePath))
+    {
+        QString errorString;
+        if (!pProject->readTemplateData(mTemplatePath, &errorString))
+            return fail(QString("Could not read the template from %1. %2").arg(mTemplatePath, errorString));
+    }
+    if (!pProject->hasTemplateData())
+        return fail(QString("Could not read the template from %1").arg(mTemplatePath));
+    // Apply the overrides
+    bool isSpringChanged = false;
+    bool isSpringSet = false;
+    for (auto const& [name, value] : variant.overrides)
+    {
+        QString errorString;
+        if (!applyOverride(*pProject, *pOptions, name, value, errorString))
+            return fail(errorString);
+        isSpringChanged = isSpringChanged || skDamperParameters.contains(name);
+        isSpringSet = isSpringSet || name == "springLength" || name == "springStiffness";
+    }
+    if (isSpringChanged && !isSpringSet)
+    {
+        Damper& damper = pProject->damper();
+        damper.setSpringLength(0.0);
+        damper.setSpringStiffness(0.0);
+        if (damper.massLoadedCable() > damper.massCable() && damper.bouncerLength() < damper.workingLength())
+            damper.computeSpring();
+    }
+    // Compute the spans. The converged solution is reused while writing the inputs
+    Spans spans = pProject->rodSystem().computeSpans();
+    result.isConverged = spans.isConverged;
+    result.numIterations = spans.numIterations;
+    result.projectedForce = spans.projectedForce;
+    result.lengths = spans.L;
+    // Write the inputs
+    if (!QDir().mkpath(result.directory))
+        return fail(QString("Could not create the directory %1").arg(result.directory));
+    CalcDataReport report = pProject->writeCalcData(result.directory, *pOptions);
+    result.writtenFiles = report.writtenFiles;
+    if (!report.failedFiles.isEmpty())
+        return fail(QString("Could not write the files: %1").arg(report.failedFiles.join(", ")));
+    result.isOk = true;
+    result.duration = timer.elapsed();
+    return result;
+}
+
+/*!
+ * \brief Read variants from a manifest
+ *
+ * The format is determined by the extension: JSON for ".json", otherwise CSV.
+ * Relative paths to projects are resolved against the directory of the manifest
+ */
+std::vector<BatchVariant> BatchRunner::readManifest(QString const& pathFile, QString& errorString)
+{
+    QFile file(pathFile);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        errorString = QString("Could not open the manifest %1").arg(pathFile);
+        return {};
+    }
+    QByteArray content = file.readAll();
+    QFileInfo info(pathFile);
+    std::vector<BatchVariant> result;
+    if (info.suffix().compare("json", Qt::CaseInsensitive) == 0)
+        result = parseJSON(content, errorString);
+    else
+        result = parseCSV(QString::fromUtf8(content), errorString);
+    QDir directory = info.absoluteDir();
+    for (BatchVariant& variant : result)
+    {
+        if (!variant.pathProject.isEmpty())
+            variant.pathProject = directory.absoluteFilePath(variant.pathProject);
+    }
+    return result;
+}
+
+/*!
+ * \brief Parse variants from a table
+ *
+ * The first line contains names of columns separated by commas, semicolons or tabulations. Besides the parameters,
+ * columns can specify names of variants and paths to projects. Empty cells leave the parameters intact.
+ * Lines which are empty or start with '#' are skipped
+ */
+std::vector<BatchVariant> BatchRunner::parseCSV(QString const& text, QString& errorString)
+{
+    std::vector<BatchVariant> result;
+    QStringList lines = text.split('\n');
+    QStringList columns;
+    QChar separator;
+    for (int iLine = 0; iLine != lines.size(); ++iLine)
+    {
+        QString line = lines[iLine].trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+        // Read the header
+        if (columns.isEmpty())
+        {
+            separator = line.contains('\t') ? '\t' : line.contains(';') ? ';' : ',';
+            for (QString const& column : line.split(separator))
+                columns.push_back(column.trimmed());
+            for (QString const& column : columns)
+            {
+                if (column != skColumnName && column != skColumnProject && !parameterNames().contains(column))
+                {
+                    errorString = QString("Unknown column '%1'").arg(column);
+                    return {};
+                }
+            }
+            continue;
+        }
+        // Read the variant
+        QStringList fields = line.split(separator);
+        if (fields.size() != columns.size())
+        {
+            errorString = QString("Line %1 contains %2 fields instead of %3").arg(iLine + 1).arg(fields.size()).arg(columns.size());
+            return {};
+        }
+        BatchVariant variant;
+        for (int i = 0; i != columns.size(); ++i)
+        {
+            QString value = fields[i].trimmed();
+            if (columns[i] == skColumnName)
+                variant.name = value;
+            else if (columns[i] == skColumnProject)
+                variant.pathProject = value;
+            else if (!value.isEmpty())
+                variant.overrides[columns[i]] = value;
+        }
+        result.push_back(variant);
+    }
+    if (!validateVariants(result, errorString))
+        return {};
+    return result;
+}
+
+/*!
+ * \brief Parse variants from an array of objects
+ *
+ * The array is either the root of a document or the member "variants" of the root object. Parameters are specified
+ * by numbers or strings, distances can be given by arrays of numbers as well
+ */
+std::vector<BatchVariant> BatchRunner::parseJSON(QByteArray const& content, QString& errorString)
+{
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(content, &error);
+    if (error.error != QJsonParseError::NoError)
+    {
+        errorString = QString("Could not parse the manifest: %1 at offset %2").arg(error.errorString()).arg(error.offset);
+        return {};
+    }
+    QJsonArray items = document.isArray() ? document.array() : document.object().value("variants").toArray();
+    std::vector<BatchVariant> result;
+    for (int iItem = 0; iItem != items.size(); ++iItem)
+    {
+        if (!items[iItem].isObject())
+        {
+            errorString = QString("Variant %1 is not an object").arg(iItem + 1);
+            return {};
+        }
+        BatchVariant variant;
+        QJsonObject object = items[iItem].toObject();
+        for (auto iter = object.begin(); iter != object.end(); ++iter)
+        {
+            QString key = iter.key();
+            QJsonValue value = iter.value();
+            if (key == skColumnName || key == skColumnProject)
+            {
+                (key == skColumnName ? variant.name : variant.pathProject) = value.toString();
+                continue;
+            }
+            if (!parameterNames().contains(key))
+            {
+                errorString = QString("Unknown parameter '%1' of the variant %2").arg(key).arg(iItem + 1);
+                return {};
+            }
+            if (value.isDouble())
+            {
+                variant.overrides[key] = QString::number(value.toDouble(), 'g', 17);
+            }
+            else if (value.isString())
+            {
+                variant.overrides[key] = value.toString();
+            }
+            else if (value.isArray())
+            {
+                QStringList numbers;
+                for (QJsonValue const& number : value.toArray())
+                    numbers.push_back(QString::number(number.toDouble(), 'g', 17));
+                variant.overrides[key] = numbers.join(' ');
+            }
+            else
+            {
+                errorString = QString("Invalid value of the parameter '%1' of the variant %2").arg(key).arg(iItem + 1);
+                return {};
+            }
+        }
+        result.push_back(variant);
+    }
+    if (!validateVariants(result, errorString))
+        return {};
+    return result;
+}
+
+//! Summarize the results in a machine-readable form
+QJsonDocument BatchRunner::summary(std::vector<BatchResult> const& results)
+{
+    QJsonArray variants;
+    int numFailed = 0;
+    for (BatchResult const& result : results)
+    {
+        QJsonArray lengths;
+        for (double length : result.lengths)
+            lengths.push_back(length);
+        QJsonObject variant;
+        variant["name"] = result.name;
+        variant["directory"] = result.directory;
+        variant["isOk"] = result.isOk;
+        variant["message"] = result.message;
+        variant["isConverged"] = result.isConverged;
+        variant["numIterations"] = result.numIterations;
+        variant["projectedForce"] = result.projectedForce;
+        variant["lengths"] = lengths;
+        variant["writtenFiles"] = QJsonArray::fromStringList(result.writtenFiles);
+        variant["duration"] = result.duration;
+        variants.push_back(variant);
+        if (!result.isOk)
+            ++numFailed;
+    }
+    QJsonObject root;
+    root["numVariants"] = (int)results.size();
+    root["numFailed"] = numFailed;
+    root["variants"] = variants;
+    return QJsonDocument(root);
+}
+
+//! Names of parameters which can be overridden
+QStringList const& BatchRunner::parameterNames()
+{
+    static QStringList const skNames = {"distances", "cable", "force", "massCable", "massLoadedCable", "workingLength",
+                                        "bouncerLength", "springLength", "springStiffness", "longitudinalStiffness",
+                                        "verticalStiffness", "numCalcModes", "numDampModes", "stepModes", "tolTrunc"};
+    return skNames;
+}
+
+//! Assign a value to a parameter of a project or solution options
+bool BatchRunner::applyOverride(Project& project, SolutionOptions& options, QString const& name, QString const& value,
+                                QString& errorString)
+{
+    using Setter = std::function<void(double)>;
+    // Parameters which are not numbers
+    if (name == "cable")
+    {
+        std::string nameCable = value.toStdString();
+        std::vector<std::string> names = project.dataBaseCables().names();
+        if (std::find(names.begin(), names.end(), nameCable) == names.end())
+        {
+            errorString = QString("Unknown cable '%1'").arg(value);
+            return false;
+        }
+        project.rodSystem().setCable(project.dataBaseCables().getItem(nameCable));
+        return true;
+    }
+    if (name == "distances")
+    {
+        std::vector<double> distances;
+        for (QString const& field : value.split(QRegularExpression("[\\s;]+"), Qt::SkipEmptyParts))
+        {
+            bool isOk = false;
+            double distance = field.toDouble(&isOk);
+            if (!isOk || !(distance > 0.0))
+            {
+                errorString = QString("Invalid distance '%1'").arg(field);
+                return false;
+            }
+            distances.push_back(distance);
+        }
+        if (distances.empty())
+        {
+            errorString = "No distances are specified";
+            return false;
+        }
+        project.rodSystem().setDistances(distances);
+        return true;
+    }
+    // Numerical parameters
+    std::map<QString, Setter> const setters = {
+        {"force", [&project](double x) { project.rodSystem().setForce(x); }},
+        {"massCable", [&project](double x) { project.damper().setMassCable(x); }},
+        {"massLoadedCable", [&project](double x) { project.damper().setMassLoadedCable(x); }},
+        {"workingLength", [&project](double x) { project.damper().setWorkingLength(x); }},
+        {"bouncerLength", [&project](double x) { project.damper().setBouncerLength(x); }},
+        {"springLength", [&project](double x) { project.damper().setSpringLength(x); }},
+        {"springStiffness", [&project](double x) { project.damper().setSpringStiffness(x); }},
+        {"longitudinalStiffness", [&project](double x) { project.support().setLongitudinalStiffness(x); }},
+        {"verticalStiffness", [&project](double x) { project.support().setVerticalStiffness(x); }},
+        {"numCalcModes", [&options](double x) { options.setNumCalcModes((int)x); }},
+        {"numDampModes", [&options](double x) { options.setNumDampModes((int)x); }},
+        {"stepModes", [&options](double x) { options.setStepModes((int)x); }},
+        {"tolTrunc", [&options](double x) { options.setTolTrunc(x); }}};
+    auto iter = setters.find(name);
+    if (iter == setters.end())
+    {
+        errorString = QString("Unknown parameter '%1'").arg(name);
+        return false;
+    }
+    bool isOk = false;
+    double number = value.toDouble(&isOk);
+    bool isInteger = name.startsWith("num") || name == "stepModes";
+    if (!isOk || number < 0.0 || (isInteger && number != std::floor(number)))
+    {
+        errorString = QString("Invalid value '%1' of the parameter '%2'").arg(value, name);
+        return false;
+    }
+    iter->second(number);
+    return true;
+}
+
+//! Name variants which are unnamed and check that names are unique and can be used as names of directories
+bool validateVariants(std::vector<BatchVariant>& variants, QString& errorString)
+{
+    std::set<QString> names;
+    QRegularExpression invalidCharacters("[/\\\\:*?\"<>|]");
+    for (std::size_t i = 0; i != variants.size(); ++i)
+    {
+        QString& name = variants[i].name;
+        if (name.isEmpty())
+            name = QString("Variant%1").arg(i + 1);
+        if (name.contains(invalidCharacters) || name == "." || name == "..")
+        {
+            errorString = QString("Invalid name of the variant '%1'").arg(name);
+            return false;
+        }
+        if (!names.insert(name).second)
+        {
+            errorString = QString("Duplicate name of the variant '%1'").arg(name);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,96 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the BatchRunner class
+ */
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <QString>
+#include <QStringList>
+#include <QJsonDocument>
+#include <map>
+#include <vector>
+#include "databasecables.h"
+
+namespace RSE
+{
+
+namespace Solution
+{
+class SolutionOptions;
+}
+
+namespace Core
+{
+
+class Project;
+
+//! Design variant described by parameters which override the ones of a project
+struct BatchVariant
+{
+    //! Unique name which is also used as the name of the directory of inputs
+    QString name;
+    //! Project the variant is based on. If empty, the base project of a batch is used
+    QString pathProject;
+    //! Values of parameters indexed by their names
+    std::map<QString, QString> overrides;
+};
+
+//! Outcome of preparing inputs of a variant
+struct BatchResult
+{
+    QString name;
+    //! Directory where the inputs have been written
+    QString directory;
+    bool isOk = false;
+    //! Description of a failure
+    QString message;
+    bool isConverged = false;
+    int numIterations = 0;
+    //! Projected stretching force, N
+    double projectedForce = 0.0;
+    //! Lengths of rods, m
+    std::vector<double> lengths;
+    QStringList writtenFiles;
+    //! Time to prepare the variant, ms
+    qint64 duration = 0;
+};
+
+/*!
+ * \brief Preparation of solver inputs for a series of design variants without user interface
+ *
+ * Each variant is loaded from a project file, modified by its overrides, and then the spans are computed and the inputs
+ * are written to its own directory. Variants are independent, so they are prepared concurrently by a pool of threads.
+ * Templates are shared through the process-wide cache, so each template directory is parsed once per batch
+ */
+class BatchRunner
+{
+public:
+    BatchRunner(DataBaseCables const& dataBaseCables, QString const& templatePath, QString const& outputPath);
+    ~BatchRunner() = default;
+    std::vector<BatchResult> run(QString const& pathProject, std::vector<BatchVariant> const& variants, int numThreads = 0) const;
+    BatchResult runVariant(QString const& pathProject, BatchVariant const& variant) const;
+    static std::vector<BatchVariant> readManifest(QString const& pathFile, QString& errorString);
+    static std::vector<BatchVariant> parseCSV(QString const& text, QString& errorString);
+    static std::vector<BatchVariant> parseJSON(QByteArray const& content, QString& errorString);
+    static QJsonDocument summary(std::vector<BatchResult> const& results);
+    static QStringList const& parameterNames();
+
+private:
+    static bool applyOverride(Project& project, Solution::SolutionOptions& options, QString const& name, QString const& value,
+                              QString& errorString);
+
+private:
+    DataBaseCables mDataBaseCables;
+    QString mTemplatePath;
+    QString mOutputPath;
+};
+
+}
+
+}
+
+#endif // BATCHRUNNER_H
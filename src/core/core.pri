@@ -7,6 +7,10 @@ HEADERS += \
     $$PWD/io.h \
     $$PWD/numericalutilities.h \
     $$PWD/solutionmanager.h \
+    $$PWD/jobscheduler.h \
+    $$PWD/logwriter.h \
+    $$PWD/resultcache.h \
+    $$PWD/ringbuffer.h \
     $$PWD/solutionoptions.h \
     $$PWD/support.h \
     $$PWD/constants.h \
@@ -17,13 +21,26 @@ HEADERS += \
     $$PWD/abstractdataobject.h \
     $$PWD/scalardataobject.h \
     $$PWD/vectordataobject.h \
+    $$PWD/matrixdataobject.h \
+    $$PWD/surfacedataobject.h \
     $$PWD/aliasdata.h \
+    $$PWD/uncertaintyestimator.h \
+    $$PWD/spansurrogate.h \
+    $$PWD/prnwriter.h \
+    $$PWD/prnreader.h \
+    $$PWD/templatecache.h \
+    $$PWD/batchrunner.h \
+    $$PWD/solvertelemetry.h \
+    $$PWD/solverlauncher.h \
 
 SOURCES += \
     $$PWD/databasecables.cpp \
     $$PWD/fileutilities.cpp \
     $$PWD/io.cpp \
     $$PWD/solutionmanager.cpp \
+    $$PWD/jobscheduler.cpp \
+    $$PWD/logwriter.cpp \
+    $$PWD/resultcache.cpp \
     $$PWD/solutionoptions.cpp \
     $$PWD/support.cpp \
     $$PWD/damper.cpp \
@@ -33,6 +50,16 @@ SOURCES += \
     $$PWD/abstractdataobject.cpp \
     $$PWD/scalardataobject.cpp \
     $$PWD/vectordataobject.cpp \
+    $$PWD/matrixdataobject.cpp \
+    $$PWD/surfacedataobject.cpp \
+    $$PWD/uncertaintyestimator.cpp \
+    $$PWD/spansurrogate.cpp \
+    $$PWD/prnwriter.cpp \
+    $$PWD/prnreader.cpp \
+    $$PWD/templatecache.cpp \
+    $$PWD/batchrunner.cpp \
+    $$PWD/solvertelemetry.cpp \
+    $$PWD/solverlauncher.cpp \
 
 # Library GSL
 ROOT_PATH = $${PWD}/../../
@@ -8,12 +8,38 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
+#include <QDebug>
+#include <array>
+#include <map>
 #include "io.h"
 #include "project.h"
 
 using namespace RSE::Core;
 using namespace RSE::Solution;
 
+static quint32 const skSignature   = 0x52534550; // RSEP
+static quint32 const skVersion     = 3;
+static qint64  const skHeaderSize  = 16;
+static qint64  const skEntrySize   = 32;
+static qint64  const skAlignment   = 8;
+//! Version whose entries of the table of contents are 24 bytes long with CRC-16 checksums
+static quint32 const skVersionCRC16 = 2;
+
+//! Section of a project file
+struct Section
+{
+    //! Tag of a section
+    quint32 tag;
+    //! Content of a section
+    QByteArray data;
+};
+
+static void writeParameters(QDataStream& stream, Project& project, SolutionOptions& options);
+static void writeCable(QDataStream& stream, Cable const& cable);
+static bool readCable(QDataStream& stream, Cable& cable);
+static qint64 alignOffset(qint64 offset);
+static quint32 computeChecksum(QByteArray const& data);
+
 IO::IO(QString const& lastPath)
     : mLastPath(lastPath)
 {
@@ -23,32 +49,54 @@ IO::IO(QString const& lastPath)
 //! Save the project and solution data to a file
 void IO::saveAs(QString const& pathFile, Project& project, SolutionOptions& options)
 {
+    // 1. Write the sections
+    std::vector<Section> sections = {{kParameters, {}}, {kCable, {}}, {kCalcState, {}}};
+    if (project.hasTemplateData())
+        sections.push_back({kTemplateData, {}});
+    for (Section& section : sections)
+    {
+        QDataStream stream(&section.data, QIODeviceBase::WriteOnly);
+        switch (section.tag)
+        {
+        case kParameters:
+            writeParameters(stream, project, options);
+            break;
+        case kCable:
+            writeCable(stream, project.rodSystem().cable());
+            break;
+        case kTemplateData:
+            project.serializeTemplateData(stream);
+            break;
+        case kCalcState:
+            project.serializeCalcState(stream);
+            break;
+        }
+    }
     QFile file(pathFile);
     if (!file.open(QIODeviceBase::WriteOnly))
         return;
     QDataStream stream(&file);
-    // 1. Write the project
-    // Parameters of damper
-    Damper const& damper = project.damper();
-    stream << damper.massCable()
-           << damper.massLoadedCable()
-           << damper.workingLength()
-           << damper.bouncerLength()
-           << damper.springLength()
-           << damper.springStiffness();
-    // Parameters of a rod system
-    RodSystem const& rodSystem = project.rodSystem();
-    stream << (qint64)rodSystem.numRods();
-    for (auto const& item : rodSystem.distances())
-        stream << item;
-    stream << rodSystem.force();
-    stream << QString(project.rodSystem().nameCable().data());
-    // Parameters of supports
-    Support const& support = project.support();
-    stream << support.longitudinalStiffness()
-           << support.verticalStiffness();
-    // 2. Write the computation parameters
-    stream << options.numCalcModes() << options.numDampModes() << options.stepModes() << options.tolTrunc();
+    // 2. Write the header
+    qint64 numSections = sections.size();
+    stream << skSignature << skVersion << (quint32)numSections << (quint32)0;
+    // 3. Write the table of contents
+    qint64 offset = skHeaderSize + skEntrySize * numSections;
+    for (Section const& section : sections)
+    {
+        offset = alignOffset(offset);
+        stream << section.tag << (quint32)0 << computeChecksum(section.data) << (quint32)0 << (quint64)offset
+               << (quint64)section.data.size();
+        offset += section.data.size();
+    }
+    // 4. Write the content of the sections
+    char const kPadding[skAlignment] = {};
+    offset = skHeaderSize + skEntrySize * numSections;
+    for (Section const& section : sections)
+    {
+        stream.writeRawData(kPadding, alignOffset(offset) - offset);
+        stream.writeRawData(section.data.constData(), section.data.size());
+        offset = alignOffset(offset) + section.data.size();
+    }
     file.close();
     // Save the last path used
     QString name = QFileInfo(pathFile).baseName();
@@ -56,14 +104,120 @@ void IO::saveAs(QString const& pathFile, Project& project, SolutionOptions& opti
     mLastPath = QFileInfo(pathFile).dir().path() + '/';
 }
 
-//! Read the computational data from a file
+/*!
+ * \brief Read the computational data from a file
+ *
+ * If the file cannot be read, the reason is given by errorString()
+ */
 IOPair IO::open(QString const& pathFile, DataBaseCables const& dataBaseCables)
 {
+    mErrorString.clear();
     QFile file(pathFile);
     // Open a file for reading
     if (!file.open(QIODeviceBase::ReadOnly))
+    {
+        mErrorString = QString("Could not open the file %1: %2").arg(pathFile, file.errorString());
         return IOPair(nullptr, nullptr);
-    QDataStream stream(&file);
+    }
+    // Map the file to memory, if possible
+    qint64 fileSize = file.size();
+    uchar* pMapped = fileSize > 0 ? file.map(0, fileSize) : nullptr;
+    QByteArray content = pMapped ? QByteArray::fromRawData((char const*)pMapped, fileSize) : file.readAll();
+    fileSize = content.size();
+    // 1. Find the sections
+    std::map<quint32, QByteArray> sections;
+    QDataStream stream(content);
+    quint32 signature, version, numSections, reserved;
+    stream >> signature >> version >> numSections >> reserved;
+    if (stream.status() == QDataStream::Ok && signature == skSignature)
+    {
+        if (version < skVersionCRC16 || version > skVersion)
+        {
+            mErrorString = version > skVersion
+                               ? QString("The file %1 has been written by a newer version of the program: "
+                                         "the format version is %2, while the latest supported one is %3")
+                                     .arg(pathFile).arg(version).arg(skVersion)
+                               : QString("The format version %1 of the file %2 is not supported").arg(version).arg(pathFile);
+            if (pMapped)
+                file.unmap(pMapped);
+            return IOPair(nullptr, nullptr);
+        }
+        bool isCRC16 = version == skVersionCRC16;
+        for (quint32 i = 0; i != numSections; ++i)
+        {
+            quint32 tag, flags, checksum, reserved;
+            quint64 offset, size;
+            if (isCRC16)
+            {
+                quint16 shortFlags, shortChecksum;
+                stream >> tag >> shortFlags >> shortChecksum >> offset >> size;
+                checksum = shortChecksum;
+            }
+            else
+            {
+                stream >> tag >> flags >> checksum >> reserved >> offset >> size;
+            }
+            if (stream.status() != QDataStream::Ok)
+                break;
+            if (offset > (quint64)fileSize || size > (quint64)fileSize - offset)
+                continue;
+            QByteArray data = QByteArray::fromRawData(content.constData() + offset, size);
+            if ((isCRC16 ? qChecksum(data) : computeChecksum(data)) != checksum)
+            {
+                qWarning() << QString("The section %1 of the file %2 is damaged").arg(tag, 0, 16).arg(pathFile);
+                continue;
+            }
+            sections[tag] = data;
+        }
+    }
+    else
+    {
+        // The file consists of the parameters only
+        sections[kParameters] = content;
+    }
+    if (!sections.contains(kParameters))
+    {
+        mErrorString = QString("The file %1 does not contain valid parameters of a project").arg(pathFile);
+        if (pMapped)
+            file.unmap(pMapped);
+        return IOPair(nullptr, nullptr);
+    }
+    // 2. Read the cable
+    Cable cable;
+    Cable const* pCable = nullptr;
+    if (sections.contains(kCable))
+    {
+        QDataStream cableStream(sections[kCable]);
+        if (readCable(cableStream, cable))
+            pCable = &cable;
+    }
+    // 3. Read the parameters
+    QDataStream parametersStream(sections[kParameters]);
+    IOPair ioPair = readParameters(parametersStream, QFileInfo(pathFile).baseName(), dataBaseCables, pCable);
+    // 4. Restore the derived data
+    Project* pProject = ioPair.first;
+    if (sections.contains(kTemplateData))
+    {
+        QDataStream templateStream(sections[kTemplateData]);
+        pProject->deserializeTemplateData(templateStream);
+    }
+    if (sections.contains(kCalcState))
+    {
+        QDataStream stateStream(sections[kCalcState]);
+        pProject->deserializeCalcState(stateStream);
+    }
+    sections.clear();
+    content.clear();
+    if (pMapped)
+        file.unmap(pMapped);
+    // Remember the last path used
+    mLastPath = QFileInfo(pathFile).dir().path() + '/';
+    return ioPair;
+}
+
+//! Read the parameters of a project and solution options. The cable is taken from the database, unless it is specified
+IOPair IO::readParameters(QDataStream& stream, QString const& name, DataBaseCables const& dataBaseCables, Cable const* pCable)
+{
     // 1. Read a project
     // Parameters of damper
     double massCable, massLoadedCable, workingLength, bouncerLength, springLength, springStiffness;
@@ -83,7 +237,7 @@ IOPair IO::open(QString const& pathFile, DataBaseCables const& dataBaseCables)
     stream >> force;
     QString nameCable;
     stream >> nameCable;
-    Cable cable = dataBaseCables.getItem(nameCable.toStdString());
+    Cable cable = pCable ? *pCable : dataBaseCables.getItem(nameCable.toStdString());
     RodSystem rodSystem(distances, cable, force);
     // Parameters of supports
     double longitudinalStiffness, verticalStiffness;
@@ -95,9 +249,76 @@ IOPair IO::open(QString const& pathFile, DataBaseCables const& dataBaseCables)
     stream >> numCalcModes >> numDampModes >> stepModes >> tolTrunc;
     SolutionOptions* pSolutionOptions = new SolutionOptions(numCalcModes, numDampModes, stepModes, tolTrunc);
     // Create a project
-    QString name = QFileInfo(pathFile).baseName();
     Project* pProject = new Project(name, dataBaseCables, damper, rodSystem, support);
-    // Remember the last path used
-    mLastPath = QFileInfo(pathFile).dir().path() + '/';
     return IOPair(pProject, pSolutionOptions);
 }
+
+//! Write the parameters of a project and solution options
+void writeParameters(QDataStream& stream, Project& project, SolutionOptions& options)
+{
+    // 1. Write the project
+    // Parameters of damper
+    Damper const& damper = project.damper();
+    stream << damper.massCable()
+           << damper.massLoadedCable()
+           << damper.workingLength()
+           << damper.bouncerLength()
+           << damper.springLength()
+           << damper.springStiffness();
+    // Parameters of a rod system
+    RodSystem const& rodSystem = project.rodSystem();
+    stream << (qint64)rodSystem.numRods();
+    for (auto const& item : rodSystem.distances())
+        stream << item;
+    stream << rodSystem.force();
+    stream << QString(project.rodSystem().nameCable().data());
+    // Parameters of supports
+    Support const& support = project.support();
+    stream << support.longitudinalStiffness()
+           << support.verticalStiffness();
+    // 2. Write the computation parameters
+    stream << options.numCalcModes() << options.numDampModes() << options.stepModes() << options.tolTrunc();
+}
+
+//! Write properties of a cable
+void writeCable(QDataStream& stream, Cable const& cable)
+{
+    stream << QString::fromStdString(cable.name) << cable.bendingStiffness << cable.torsionalStiffness << cable.massPerLength
+           << cable.youngsModulus << cable.area;
+}
+
+//! Read properties of a cable
+bool readCable(QDataStream& stream, Cable& cable)
+{
+    QString name;
+    stream >> name >> cable.bendingStiffness >> cable.torsionalStiffness >> cable.massPerLength >> cable.youngsModulus >> cable.area;
+    cable.name = name.toStdString();
+    return stream.status() == QDataStream::Ok;
+}
+
+//! Round an offset up to the alignment of sections
+qint64 alignOffset(qint64 offset)
+{
+    return (offset + skAlignment - 1) / skAlignment * skAlignment;
+}
+
+//! Compute the CRC-32 checksum of a section by means of the reflected polynomial used by zlib
+quint32 computeChecksum(QByteArray const& data)
+{
+    static std::array<quint32, 256> const skTable = []()
+    {
+        std::array<quint32, 256> table;
+        for (quint32 i = 0; i != table.size(); ++i)
+        {
+            quint32 value = i;
+            for (int k = 0; k != 8; ++k)
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            table[i] = value;
+        }
+        return table;
+    }();
+    quint32 result = 0xFFFFFFFFu;
+    for (char byte : data)
+        result = skTable[(result ^ (quint8)byte) & 0xFF] ^ (result >> 8);
+    return result ^ 0xFFFFFFFFu;
+}
@@ -10,6 +10,7 @@
 
 #include <QString>
 #include <QPair>
+#include <QDataStream>
 #include "solutionoptions.h"
 
 namespace RSE
@@ -20,23 +21,46 @@ namespace Core
 
 class Project;
 class DataBaseCables;
+struct Cable;
 
 using IOPair = QPair<Project*, RSE::Solution::SolutionOptions*>;
 
-//! Class to save the project and solution data
+/*!
+ * \brief Class to save the project and solution data
+ *
+ * A project file begins with a header followed by a table of contents. Each entry of the table specifies a tag, offset,
+ * size and CRC-32 checksum of a section. Files of the previous version, whose checksums are CRC-16, are still read, while
+ * files of newer versions are rejected. Sections are aligned to 8 bytes, so that a file can be mapped to memory and read in place.
+ * Only the section of parameters is required, others hold derived data which is recomputed, if the section is absent or damaged.
+ * Files written before the sections were introduced consist of the parameters only and are still supported.
+ */
 class IO
 {
 public:
+    //! Tags of sections
+    enum SectionTag : quint32
+    {
+        kParameters   = 0x5041524D, // PARM
+        kCable        = 0x4341424C, // CABL
+        kTemplateData = 0x544D504C, // TMPL
+        kCalcState    = 0x43414C43  // CALC
+    };
     IO(QString const& lastPath);
     ~IO() = default;
     QString const& lastPath() const { return mLastPath; }
     QString const& extension() const { return mkProjectExtension; }
     void saveAs(QString const& pathFile, Project& project, Solution::SolutionOptions& options);
     IOPair open(QString const& pathFile, DataBaseCables const& dataBaseCables);
+    QString const& errorString() const { return mErrorString; }
+
+private:
+    IOPair readParameters(QDataStream& stream, QString const& name, DataBaseCables const& dataBaseCables, Cable const* pCable);
 
 private:
     const QString mkProjectExtension = ".rse";
     QString mLastPath;
+    //! Reason why the last file could not be opened
+    QString mErrorString;
 };
 
 }
@@ -0,0 +1,345 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the JobScheduler class
+ */
+
+#include <algorithm>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QThread>
+#include "jobscheduler.h"
+#include "project.h"
+#include "solutionoptions.h"
+
+using namespace RSE::Core;
+using namespace RSE::Solution;
+
+static bool isShared(QFileInfo const& info);
+
+//! Wall-clock duration of a job, ms. The duration of a running job is measured up to now
+qint64 SolverJob::duration() const
+{
+    if (!startedTime.isValid())
+        return 0;
+    return startedTime.msecsTo(finishedTime.isValid() ? finishedTime : QDateTime::currentDateTime());
+}
+
+//! Name of a state of a job
+QString SolverJob::stateName(State state)
+{
+    switch (state)
+    {
+    case kQueued:
+        return "Queued";
+    case kRunning:
+        return "Running";
+    case kDone:
+        return "Done";
+    case kFailed:
+        return "Failed";
+    case kCancelled:
+        return "Cancelled";
+    }
+    return QString();
+}
+
+/*!
+ * \brief Construct a scheduler
+ * \param rootPath Directory which contains the solver
+ * \param relativeInputPath Directory of inputs relative to the root one
+ * \param relativeOutputPath Directory of results relative to the root one
+ * \param scratchPath Directory where the directories of jobs are created
+ */
+JobScheduler::JobScheduler(QString const& rootPath, QString const& relativeInputPath, QString const& relativeOutputPath,
+                           QString const& scratchPath, QObject* pParent)
+    : QObject(pParent)
+    , mRelativeInputPath(relativeInputPath)
+    , mRelativeOutputPath(relativeOutputPath)
+    , mSolverName(SolverLauncher::skNameRodSystemSolver)
+    , mMaxConcurrentJobs(std::max(QThread::idealThreadCount(), 1))
+{
+    QChar separator = QDir::separator();
+    mRootPath = QFileInfo(rootPath).absoluteFilePath();
+    if (!mRootPath.endsWith(separator))
+        mRootPath.append(separator);
+    mScratchPath = QFileInfo(scratchPath).absoluteFilePath();
+    if (!mScratchPath.endsWith(separator))
+        mScratchPath.append(separator);
+    mpWatcher = new QFileSystemWatcher(this);
+    connect(mpWatcher, &QFileSystemWatcher::directoryChanged, this, &JobScheduler::checkStatuses);
+    connect(mpWatcher, &QFileSystemWatcher::fileChanged, this, &JobScheduler::checkStatuses);
+}
+
+JobScheduler::~JobScheduler()
+{
+    for (auto [id, pProcess] : mProcesses)
+    {
+        pProcess->disconnect(this);
+        pProcess->kill();
+        pProcess->waitForFinished();
+        delete pProcess;
+    }
+}
+
+/*!
+ * \brief Queue the solution of a project
+ *
+ * The inputs are written immediately, so that the project can be modified while the job is waiting
+ * \return Identifier of the job
+ */
+int JobScheduler::submit(Project& project, SolutionOptions const& options)
+{
+    SolverJob job;
+    job.id = ++mLastID;
+    job.name = project.name();
+    job.queuedTime = QDateTime::currentDateTime();
+    job.directory = mScratchPath + QString("job-%1").arg(job.id, 4, 10, QChar('0')) + QDir::separator();
+    if (prepareDirectory(job))
+    {
+        CalcDataReport report = project.writeCalcData(job.directory + mRelativeInputPath, options);
+        if (!report.failedFiles.isEmpty())
+        {
+            job.state = SolverJob::kFailed;
+            job.message = QString("Could not write the input files: %1").arg(report.failedFiles.join(", "));
+        }
+    }
+    if (job.isFinished())
+        job.finishedTime = job.queuedTime;
+    emit jobAboutToBeAdded(mJobs.size());
+    mJobs.push_back(job);
+    emit jobAdded(mJobs.size() - 1);
+    if (job.isFinished())
+        emit jobFinished(job.id);
+    schedule();
+    return job.id;
+}
+
+/*!
+ * \brief Create the scratch directory of a job
+ *
+ * Only the solver, libraries and read-only files of the root directory are linked, if it is supported. The other files are copied,
+ * since the solver writes its outputs into its working directory, and writing through a link would modify the shared file.
+ * The template inputs are copied, since they are overwritten by the project data
+ */
+bool JobScheduler::prepareDirectory(SolverJob& job)
+{
+    QDir directory(job.directory);
+    if (directory.exists())
+        directory.removeRecursively();
+    if (!directory.mkpath(mRelativeInputPath) || !directory.mkpath(mRelativeOutputPath))
+    {
+        job.state = SolverJob::kFailed;
+        job.message = QString("Could not create the directory %1").arg(job.directory);
+        return false;
+    }
+    // Files of the root directory
+    QFileInfoList rootFiles = QDir(mRootPath).entryInfoList(QDir::Files);
+    for (QFileInfo const& info : rootFiles)
+    {
+        if (info.fileName() == SolverLauncher::skFileNameStatus)
+            continue;
+        QString pathFile = job.directory + info.fileName();
+        bool isOk = false;
+#ifndef Q_OS_WINDOWS
+        if (isShared(info))
+            isOk = QFile::link(info.absoluteFilePath(), pathFile);
+        else
+#endif
+            isOk = QFile::copy(info.absoluteFilePath(), pathFile);
+        if (!isOk)
+        {
+            job.state = SolverJob::kFailed;
+            job.message = QString("Could not place the file %1 into the directory of the job").arg(info.fileName());
+            return false;
+        }
+    }
+    // Template inputs
+    QFileInfoList inputFiles = QDir(mRootPath + mRelativeInputPath).entryInfoList(QDir::Files);
+    for (QFileInfo const& info : inputFiles)
+    {
+        if (!QFile::copy(info.absoluteFilePath(), job.directory + mRelativeInputPath + info.fileName()))
+        {
+            job.state = SolverJob::kFailed;
+            job.message = QString("Could not copy the input file %1").arg(info.fileName());
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Cancel a job which is either queued or running
+void JobScheduler::cancel(int id)
+{
+    int iJob = findJob(id);
+    if (iJob < 0 || mJobs[iJob].isFinished())
+        return;
+    finishJob(iJob, SolverJob::kCancelled, "Cancelled by the user");
+}
+
+//! Cancel all the jobs which are not finished yet
+void JobScheduler::cancelAll()
+{
+    // Queued jobs go first, so that they are not started when running ones are cancelled
+    for (SolverJob::State state : {SolverJob::kQueued, SolverJob::kRunning})
+    {
+        for (int iJob = 0; iJob != (int)mJobs.size(); ++iJob)
+        {
+            if (mJobs[iJob].state == state)
+                finishJob(iJob, SolverJob::kCancelled, "Cancelled by the user");
+        }
+    }
+}
+
+//! Forget the finished jobs and remove their directories
+void JobScheduler::clearFinished()
+{
+    emit jobsAboutToBeCleared();
+    auto iterEnd = std::stable_partition(mJobs.begin(), mJobs.end(), [](SolverJob const& job) { return !job.isFinished(); });
+    for (auto iter = iterEnd; iter != mJobs.end(); ++iter)
+        QDir(iter->directory).removeRecursively();
+    mJobs.erase(iterEnd, mJobs.end());
+    emit jobsCleared();
+}
+
+//! Retrieve a job by its identifier
+SolverJob const* JobScheduler::job(int id) const
+{
+    int iJob = findJob(id);
+    return iJob < 0 ? nullptr : &mJobs[iJob];
+}
+
+//! Specify the number of jobs to be run at the same time
+void JobScheduler::setMaxConcurrentJobs(int maxConcurrentJobs)
+{
+    mMaxConcurrentJobs = std::max(maxConcurrentJobs, 1);
+    schedule();
+}
+
+//! Find the index of a job, -1 is returned if it is not found
+int JobScheduler::findJob(int id) const
+{
+    auto iter = std::find_if(mJobs.begin(), mJobs.end(), [id](SolverJob const& job) { return job.id == id; });
+    return iter == mJobs.end() ? -1 : iter - mJobs.begin();
+}
+
+//! Start the queued jobs in the order of submission while there are free slots
+void JobScheduler::schedule()
+{
+    for (int iJob = 0; iJob != (int)mJobs.size() && numRunning() < mMaxConcurrentJobs; ++iJob)
+    {
+        if (mJobs[iJob].state == SolverJob::kQueued)
+            startJob(iJob);
+    }
+}
+
+//! Run the solver in the directory of a job
+void JobScheduler::startJob(int iJob)
+{
+    SolverJob& job = mJobs[iJob];
+    int id = job.id;
+    QProcess* pProcess = new QProcess();
+    pProcess->setProcessChannelMode(QProcess::MergedChannels);
+    pProcess->setWorkingDirectory(job.directory);
+    mLauncher.setup(pProcess, job.directory + mSolverName);
+    connect(pProcess, &QProcess::readyRead, this, [this, id, pProcess]() { emit outputSent(id, pProcess->readAll()); });
+    connect(pProcess, &QProcess::finished, this,
+            [this, id](int exitCode, QProcess::ExitStatus exitStatus) { processFinished(id, exitCode, exitStatus); });
+    connect(pProcess, &QProcess::errorOccurred, this,
+            [this, id, pProcess](QProcess::ProcessError error)
+            {
+                int iJob = findJob(id);
+                if (error == QProcess::FailedToStart && iJob >= 0 && mJobs[iJob].state == SolverJob::kRunning)
+                    finishJob(iJob, SolverJob::kFailed, pProcess->errorString());
+            });
+    mProcesses[id] = pProcess;
+    job.state = SolverJob::kRunning;
+    job.startedTime = QDateTime::currentDateTime();
+    mpWatcher->addPath(job.directory);
+    emit jobChanged(iJob);
+    pProcess->start();
+}
+
+/*!
+ * \brief Complete the running jobs whose status files are written
+ *
+ * Directories are watched to catch the creation of status files, which are watched afterwards to catch their modification
+ */
+void JobScheduler::checkStatuses()
+{
+    QStringList watchedFiles = mpWatcher->files();
+    for (int iJob = 0; iJob != (int)mJobs.size(); ++iJob)
+    {
+        SolverJob const& job = mJobs[iJob];
+        if (job.state != SolverJob::kRunning)
+            continue;
+        QString pathFile = job.directory + SolverLauncher::skFileNameStatus;
+        if (!watchedFiles.contains(pathFile) && QFileInfo::exists(pathFile))
+            mpWatcher->addPath(pathFile);
+        if (SolverLauncher::readRodSystemStatus(job.directory) >= 0)
+            finishJob(iJob, SolverJob::kDone);
+    }
+}
+
+//! Process the termination of a solver
+void JobScheduler::processFinished(int id, int exitCode, QProcess::ExitStatus exitStatus)
+{
+    int iJob = findJob(id);
+    if (iJob < 0 || mJobs[iJob].state != SolverJob::kRunning)
+        return;
+    if (SolverLauncher::readRodSystemStatus(mJobs[iJob].directory) >= 0)
+        finishJob(iJob, SolverJob::kDone);
+    else if (exitStatus == QProcess::CrashExit)
+        finishJob(iJob, SolverJob::kFailed, "The solver crashed");
+    else
+        finishJob(iJob, SolverJob::kFailed, QString("The solver exited with code %1 without writing the status").arg(exitCode));
+}
+
+/*!
+ * \brief Record the result of a job, release its process and start the next queued one
+ *
+ * A process which is still running is killed without waiting for it, and it is deleted once it has finished
+ */
+void JobScheduler::finishJob(int iJob, SolverJob::State state, QString const& message)
+{
+    SolverJob& job = mJobs[iJob];
+    bool isRunning = job.state == SolverJob::kRunning;
+    job.state = state;
+    job.message = message;
+    job.finishedTime = QDateTime::currentDateTime();
+    if (isRunning)
+    {
+        mpWatcher->removePaths({job.directory, job.directory + SolverLauncher::skFileNameStatus});
+        auto iter = mProcesses.find(job.id);
+        if (iter != mProcesses.end())
+        {
+            QProcess* pProcess = iter->second;
+            mProcesses.erase(iter);
+            pProcess->disconnect(this);
+            if (pProcess->state() != QProcess::NotRunning)
+            {
+                connect(pProcess, &QProcess::finished, pProcess, &QObject::deleteLater);
+                pProcess->kill();
+            }
+            else
+            {
+                pProcess->deleteLater();
+            }
+        }
+        job.status = SolverLauncher::readRodSystemStatus(job.directory);
+        job.resultFiles = QDir(job.directory + mRelativeOutputPath).entryList(QDir::Files, QDir::Name);
+    }
+    emit jobChanged(iJob);
+    emit jobFinished(job.id);
+    schedule();
+}
+
+//! Check if a file of the root directory is never written by the solver, so that jobs may share it
+bool isShared(QFileInfo const& info)
+{
+    QString suffix = info.suffix().toLower();
+    return info.isExecutable() || suffix == "exe" || suffix == "dll" || !info.isWritable();
+}
@@ -0,0 +1,137 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the JobScheduler class
+ */
+
+#ifndef JOBSCHEDULER_H
+#define JOBSCHEDULER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QProcess>
+#include <map>
+#include <vector>
+#include "solverlauncher.h"
+
+class QFileSystemWatcher;
+
+namespace RSE
+{
+
+namespace Core
+{
+class Project;
+}
+
+namespace Solution
+{
+
+class SolutionOptions;
+
+//! Calculation of a rod system performed in its own directory
+struct SolverJob
+{
+    enum State
+    {
+        kQueued,
+        kRunning,
+        kDone,
+        kFailed,
+        kCancelled
+    };
+    bool isFinished() const { return state >= kDone; }
+    qint64 duration() const;
+    static QString stateName(State state);
+
+    //! Unique identifier
+    int id;
+    //! Name of the project solved
+    QString name;
+    State state = kQueued;
+    //! Scratch directory where the solver is run
+    QString directory;
+    QDateTime queuedTime;
+    QDateTime startedTime;
+    QDateTime finishedTime;
+    //! Status written by the solver, negative if it is absent
+    int status = -1;
+    //! Description of a failure
+    QString message;
+    //! Files produced in the output directory
+    QStringList resultFiles;
+};
+
+/*!
+ * \brief Scheduler which runs several solutions of rod systems concurrently
+ *
+ * Each job gets a scratch directory which mirrors the root one: the solver and other files it never writes are linked,
+ * while the rest of the files are copied and the template inputs are overwritten by the project data. So, jobs never share files they modify.
+ * Completion of a job is detected through notifications on its status file and the termination of its process
+ */
+class JobScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    JobScheduler(QString const& rootPath, QString const& relativeInputPath, QString const& relativeOutputPath,
+                 QString const& scratchPath, QObject* pParent = nullptr);
+    ~JobScheduler();
+    int submit(Core::Project& project, SolutionOptions const& options);
+    void cancel(int id);
+    void cancelAll();
+    void clearFinished();
+    std::vector<SolverJob> const& jobs() const { return mJobs; }
+    SolverJob const* job(int id) const;
+    int numRunning() const { return mProcesses.size(); }
+    int maxConcurrentJobs() const { return mMaxConcurrentJobs; }
+    void setMaxConcurrentJobs(int maxConcurrentJobs);
+    QString const& solverName() const { return mSolverName; }
+    void setSolverName(QString const& solverName) { mSolverName = solverName; }
+    SolverLauncher const& launcher() const { return mLauncher; }
+    void setLauncher(SolverLauncher const& launcher) { mLauncher = launcher; }
+
+signals:
+    void jobAboutToBeAdded(int iJob);
+    void jobAdded(int iJob);
+    void jobChanged(int iJob);
+    void jobFinished(int id);
+    void jobsAboutToBeCleared();
+    void jobsCleared();
+    void outputSent(int id, QByteArray data);
+
+private:
+    int findJob(int id) const;
+    bool prepareDirectory(SolverJob& job);
+    void schedule();
+    void startJob(int iJob);
+    void finishJob(int iJob, SolverJob::State state, QString const& message = QString());
+    void processFinished(int id, int exitCode, QProcess::ExitStatus exitStatus);
+    void checkStatuses();
+
+private:
+    QString mRootPath;
+    QString mRelativeInputPath;
+    QString mRelativeOutputPath;
+    QString mScratchPath;
+    //! Name of the solver executable located in the root directory
+    QString mSolverName;
+    SolverLauncher mLauncher;
+    int mMaxConcurrentJobs;
+    int mLastID = 0;
+    //! Jobs in the order of submission
+    std::vector<SolverJob> mJobs;
+    //! Processes of the running jobs indexed by identifiers of jobs
+    std::map<int, QProcess*> mProcesses;
+    //! Watcher of the directories of the running jobs
+    QFileSystemWatcher* mpWatcher;
+};
+
+}
+
+}
+
+#endif // JOBSCHEDULER_H
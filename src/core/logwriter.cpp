@@ -0,0 +1,65 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the LogWriter class
+ */
+
+#include <QFile>
+#include "logwriter.h"
+
+using namespace RSE::Core;
+
+//! Start the writing thread and truncate the log file
+LogWriter::LogWriter(QString const& pathFile, QObject* pParent)
+    : QObject(pParent)
+    , mPathFile(pathFile)
+{
+    mpContext = new QObject();
+    mpContext->moveToThread(&mThread);
+    connect(&mThread, &QThread::finished, mpContext, &QObject::deleteLater);
+    mThread.start(QThread::LowPriority);
+    QMetaObject::invokeMethod(mpContext, [this]()
+    {
+        mpFile = std::make_unique<QFile>(mPathFile);
+        if (!mpFile->open(QIODevice::WriteOnly | QIODevice::Truncate))
+            mpFile.reset();
+    });
+}
+
+//! Write the pending data and stop the thread
+LogWriter::~LogWriter()
+{
+    QMetaObject::invokeMethod(mpContext, [this]()
+    {
+        mpFile.reset();
+        QThread::currentThread()->quit();
+    });
+    mThread.wait();
+}
+
+//! Append data to the log
+void LogWriter::write(QByteArray const& data)
+{
+    QMetaObject::invokeMethod(mpContext, [this, data]()
+    {
+        if (mpFile)
+            mpFile->write(data);
+    });
+}
+
+//! Copy the log with all the data written before
+void LogWriter::copy(QString const& pathFile)
+{
+    QMetaObject::invokeMethod(mpContext, [this, pathFile]()
+    {
+        bool isOk = false;
+        if (mpFile)
+        {
+            mpFile->flush();
+            QFile::remove(pathFile);
+            isOk = QFile::copy(mPathFile, pathFile);
+        }
+        emit copied(pathFile, isOk);
+    });
+}
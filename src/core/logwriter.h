@@ -0,0 +1,52 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the LogWriter class
+ */
+
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include <QObject>
+#include <QThread>
+#include <QByteArray>
+#include <memory>
+
+class QFile;
+
+namespace RSE::Core
+{
+
+/*!
+ * \brief Writer of a log file which does not block the caller
+ *
+ * Data is written to the file by a dedicated thread in the order it is passed. Copies of the log are made
+ * once the data passed before is written.
+ */
+class LogWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    LogWriter(QString const& pathFile, QObject* pParent = nullptr);
+    ~LogWriter();
+    QString const& pathFile() const { return mPathFile; }
+    void write(QByteArray const& data);
+    void copy(QString const& pathFile);
+
+signals:
+    void copied(QString const& pathFile, bool isOk);
+
+private:
+    QString const mPathFile;
+    QThread mThread;
+    //! Object which executes operations in the writing thread
+    QObject* mpContext;
+    //! File which is accessed by the writing thread only
+    std::unique_ptr<QFile> mpFile;
+};
+
+}
+
+#endif // LOGWRITER_H
@@ -0,0 +1,36 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Implementation of the MatrixDataObject class
+ */
+
+#include "matrixdataobject.h"
+
+using namespace RSE::Core;
+
+std::atomic<quint32> MatrixDataObject::smNumInstances = 0;
+const IndexType skNumElements = 3;
+
+//! Construct a matrix data object
+MatrixDataObject::MatrixDataObject(QString const& name)
+    : AbstractDataObject(kMatrix, name, skNumElements, skNumElements)
+{
+    ++smNumInstances;
+}
+
+//! Decrease a number of instances while being destroyed
+MatrixDataObject::~MatrixDataObject()
+{
+    --smNumInstances;
+}
+
+//! Clone a matrix data object
+AbstractDataObject* MatrixDataObject::clone() const
+{
+    MatrixDataObject* obj = new MatrixDataObject(mName);
+    obj->mpItems = mpItems;
+    obj->mID = mID;
+    --smNumInstances;
+    return obj;
+}
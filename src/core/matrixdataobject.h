@@ -0,0 +1,31 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the MatrixDataObject class
+ */
+
+#ifndef MATRIXDATAOBJECT_H
+#define MATRIXDATAOBJECT_H
+
+#include "abstractdataobject.h"
+
+namespace RSE::Core
+{
+
+//! Matrix data object
+class MatrixDataObject : public AbstractDataObject
+{
+public:
+    MatrixDataObject(QString const& name);
+    ~MatrixDataObject();
+    AbstractDataObject* clone() const override;
+    static quint32 numberInstances() { return smNumInstances; }
+
+private:
+    static std::atomic<quint32> smNumInstances;
+};
+
+}
+
+#endif // MATRIXDATAOBJECT_H
@@ -0,0 +1,120 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the PrnReader class
+ */
+
+#include <QFile>
+#include "prnreader.h"
+
+using namespace RSE::Core;
+
+//! Map the content of an opened file
+PrnReader::PrnReader(QFile& file)
+    : mpFile(&file)
+    , mName(file.fileName())
+{
+    qint64 size = file.size();
+    if (size > 0)
+        mpMappedData = file.map(0, size);
+    if (mpMappedData)
+    {
+        mpCurrent = reinterpret_cast<char const*>(mpMappedData);
+        mpEnd = mpCurrent + size;
+    }
+    else
+    {
+        mContent = file.readAll();
+        mpCurrent = mContent.constData();
+        mpEnd = mpCurrent + mContent.size();
+    }
+}
+
+//! Parse the content stored in memory
+PrnReader::PrnReader(QByteArray const& content, QString const& name)
+    : mContent(content)
+    , mName(name)
+{
+    mpCurrent = mContent.constData();
+    mpEnd = mpCurrent + mContent.size();
+}
+
+PrnReader::~PrnReader()
+{
+    if (mpMappedData)
+        mpFile->unmap(mpMappedData);
+}
+
+//! Read the rest of the current line excluding the line break
+bool PrnReader::readLine(std::string_view& line)
+{
+    if (mpCurrent == mpEnd)
+        return false;
+    char const* pBegin = mpCurrent;
+    while (mpCurrent != mpEnd && *mpCurrent != '\n')
+        ++mpCurrent;
+    char const* pEnd = mpCurrent;
+    if (pEnd != pBegin && *(pEnd - 1) == '\r')
+        --pEnd;
+    if (mpCurrent != mpEnd)
+    {
+        ++mpCurrent;
+        ++mLineNumber;
+    }
+    line = std::string_view(pBegin, pEnd - pBegin);
+    return true;
+}
+
+//! Skip the rest of the current line
+void PrnReader::skipLine()
+{
+    std::string_view line;
+    readLine(line);
+}
+
+//! Check if there are no tokens left
+bool PrnReader::atEnd()
+{
+    skipWhiteSpace();
+    return mpCurrent == mpEnd;
+}
+
+//! Remember the first error occurred
+void PrnReader::setError(QString const& message)
+{
+    if (!mErrorString.isEmpty())
+        return;
+    mErrorString = QString("%1 at line %2").arg(message, QString::number(mLineNumber));
+    if (!mName.isEmpty())
+        mErrorString += QString(" of %1").arg(mName);
+}
+
+//! Skip whitespaces including line breaks
+void PrnReader::skipWhiteSpace()
+{
+    while (mpCurrent != mpEnd)
+    {
+        char symbol = *mpCurrent;
+        if (symbol == '\n')
+            ++mLineNumber;
+        else if (symbol != ' ' && symbol != '\t' && symbol != '\r' && symbol != '\f' && symbol != '\v')
+            break;
+        ++mpCurrent;
+    }
+}
+
+//! Retrieve the next sequence of characters separated by whitespaces
+std::string_view PrnReader::readToken()
+{
+    skipWhiteSpace();
+    char const* pBegin = mpCurrent;
+    while (mpCurrent != mpEnd)
+    {
+        char symbol = *mpCurrent;
+        if (symbol == ' ' || symbol == '\n' || symbol == '\t' || symbol == '\r' || symbol == '\f' || symbol == '\v')
+            break;
+        ++mpCurrent;
+    }
+    return std::string_view(pBegin, mpCurrent - pBegin);
+}
@@ -0,0 +1,90 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the PrnReader class
+ */
+
+#ifndef PRNREADER_H
+#define PRNREADER_H
+
+#include <QByteArray>
+#include <QString>
+#include <charconv>
+#include <string_view>
+#include <type_traits>
+
+class QFile;
+
+namespace RSE::Core
+{
+
+/*!
+ * \brief Parser of text files read by the solver
+ *
+ * The content of a file is mapped into memory and numbers separated by whitespaces are parsed in place.
+ * The number of the current line is tracked to report errors.
+ */
+class PrnReader
+{
+public:
+    PrnReader(QFile& file);
+    PrnReader(QByteArray const& content, QString const& name = QString());
+    ~PrnReader();
+    template<typename T> bool read(T& value);
+    bool readLine(std::string_view& line);
+    void skipLine();
+    bool atEnd();
+    int lineNumber() const { return mLineNumber; }
+    QString const& errorString() const { return mErrorString; }
+    void setError(QString const& message);
+
+private:
+    void skipWhiteSpace();
+    std::string_view readToken();
+
+private:
+    //! File whose content is mapped
+    QFile* mpFile = nullptr;
+    //! Pointer to the mapped content
+    uchar* mpMappedData = nullptr;
+    //! Content which is read if the file cannot be mapped
+    QByteArray mContent;
+    //! Name of a source used in error messages
+    QString mName;
+    //! Current character
+    char const* mpCurrent = nullptr;
+    //! End of the content
+    char const* mpEnd = nullptr;
+    //! Number of the current line starting from one
+    int mLineNumber = 1;
+    //! Description of the first error
+    QString mErrorString;
+};
+
+//! Read a number separated by whitespaces
+template<typename T>
+inline bool PrnReader::read(T& value)
+{
+    static_assert(std::is_arithmetic_v<T>, "Only numbers can be read");
+    std::string_view token = readToken();
+    if (token.empty())
+    {
+        setError("Unexpected end of data");
+        return false;
+    }
+    if (token.size() > 1 && token.front() == '+')
+        token.remove_prefix(1);
+    char const* pEnd = token.data() + token.size();
+    auto result = std::from_chars(token.data(), pEnd, value);
+    if (result.ec != std::errc() || result.ptr != pEnd)
+    {
+        setError(QString("Could not parse the number '%1'").arg(QString::fromUtf8(token.data(), token.size())));
+        return false;
+    }
+    return true;
+}
+
+}
+
+#endif // PRNREADER_H
@@ -0,0 +1,60 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the PrnWriter class
+ */
+
+#include <QFile>
+#include <cmath>
+#include "prnwriter.h"
+
+using namespace RSE::Core;
+
+PrnWriter::PrnWriter(int fieldWidth, int precision)
+    : mkFieldWidth(fieldWidth)
+    , mkPrecision(precision)
+{
+
+}
+
+//! Write a floating-point value in the same way as QString::number(value, 'g', precision) does
+void PrnWriter::write(double value)
+{
+    if (std::isnan(value))
+    {
+        char const kNaN[] = "nan";
+        writeField(kNaN, kNaN + 3);
+        return;
+    }
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::general, mkPrecision);
+    writeField(buffer, result.ptr);
+}
+
+//! Finish a line. The line break is aligned as any other field
+void PrnWriter::endLine()
+{
+    char const kEndLine = '\n';
+    writeField(&kEndLine, &kEndLine + 1);
+}
+
+//! Write the buffer to a file using a single call
+bool PrnWriter::save(QString const& pathFile) const
+{
+    QFile file(pathFile);
+    if (!file.open(QIODeviceBase::WriteOnly))
+        return false;
+    bool isOk = file.write(mBuffer) == mBuffer.size();
+    file.close();
+    return isOk;
+}
+
+//! Write a text padded from the left to the width of a field
+void PrnWriter::writeField(char const* pBegin, char const* pEnd)
+{
+    qsizetype length = pEnd - pBegin;
+    if (length < mkFieldWidth)
+        mBuffer.append(mkFieldWidth - length, ' ');
+    mBuffer.append(pBegin, length);
+}
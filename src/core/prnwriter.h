@@ -0,0 +1,63 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the PrnWriter class
+ */
+
+#ifndef PRNWRITER_H
+#define PRNWRITER_H
+
+#include <QByteArray>
+#include <QString>
+#include <charconv>
+#include <type_traits>
+#include "constants.h"
+
+namespace RSE::Core
+{
+
+/*!
+ * \brief Formatter of text files read by the solver
+ *
+ * Values are right-aligned in fields of the fixed width, as QTextStream does, so that the output is byte-identical to the
+ * one produced by the stream. The text is accumulated in a single buffer which is written to a file at once.
+ */
+class PrnWriter
+{
+public:
+    PrnWriter(int fieldWidth, int precision = RSE::Constants::kWritingPrecision);
+    ~PrnWriter() = default;
+    template<typename T> void write(T value);
+    void write(double value);
+    void endLine();
+    void reserve(qsizetype size) { mBuffer.reserve(size); }
+    void clear() { mBuffer.clear(); }
+    QByteArray const& buffer() const { return mBuffer; }
+    bool save(QString const& pathFile) const;
+
+private:
+    void writeField(char const* pBegin, char const* pEnd);
+
+private:
+    //! Width of a field
+    int const mkFieldWidth;
+    //! Number of significant digits of floating-point values
+    int const mkPrecision;
+    //! Text written
+    QByteArray mBuffer;
+};
+
+//! Write an integer value
+template<typename T>
+inline void PrnWriter::write(T value)
+{
+    static_assert(std::is_integral_v<T>, "Only integer and floating-point values are supported");
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    writeField(buffer, result.ptr);
+}
+
+}
+
+#endif // PRNWRITER_H
@@ -6,27 +6,30 @@
  */
 
 #include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QHash>
 #include <QLocale>
+#include <algorithm>
 #include "project.h"
 #include "scalardataobject.h"
 #include "vectordataobject.h"
-#include "fileutilities.h"
+#include "templatecache.h"
+#include "prnwriter.h"
 #include "solutionoptions.h"
 
 using namespace RSE::Core;
 using namespace RSE::Solution;
 
-static const QString skFileNameScalar  = "w1.prn";
-static const QString skFileNameVector  = "w3.prn";
-static const QString skFileNameProject = "PROJ_ID.prn";
-static const QString skFileNameRods    = "RODS.prn";
-static const QString skFileNameProgram = "PROG.prn";
-static const int     skFieldWidth      = 30;
+static const int skFieldWidth = 30;
 
 void clearDataObjects(DataObjects& dataObjects);
-QStringList readAllLines(QString const& path, QString const& fileName);
+qsizetype estimateTextSize(DataObjects const& dataObjects);
 void replaceStringEntry(QString& string, int numSkipEntries, QString subString);
-void writeAllLines(QStringList const& lines, QString const& path, QString const& fileName);
+QByteArray joinLines(QStringList const& lines);
+static void writeVector(QDataStream& stream, std::vector<double> const& values);
+static bool readVector(QDataStream& stream, std::vector<double>& values);
+static bool hasKeys(AbstractDataObject const* pDataObject, int firstKey, int lastKey);
 
 Project::Project(QString const& name, DataBaseCables dataBaseCables, Damper damper, RodSystem rodSystem, Support support)
     : mName(name), mDamper(damper), mRodSystem(rodSystem), mSupport(support), mDataBaseCables(dataBaseCables)
@@ -38,99 +41,300 @@ Project::~Project()
 {
     clearDataObjects(mScalarDataObjects);
     clearDataObjects(mVectorDataObjects);
+    clearDataObjects(mMatrixDataObjects);
+    clearDataObjects(mSurfaceDataObjects);
 }
 
-//! Read template data
-void Project::readTemplateData(QString const& path)
+/*!
+ * \brief Read template data
+ *
+ * The template is parsed once and then cached. Data objects of a project share items with the cached ones until modified.
+ * The data read before an error occurred is kept
+ * \return true if the template has been read entirely, false otherwise
+ */
+bool Project::readTemplateData(QString const& path, QString* pErrorString)
 {
-    // Import data objects
-    mScalarDataObjects.clear();
-    mVectorDataObjects.clear();
-    importDataObjects(path, skFileNameScalar);
-    importDataObjects(path, skFileNameVector);
+    std::shared_ptr<ProjectTemplate const> pTemplate = TemplateCache::instance().get(path);
+    // Clone data objects
+    clearDataObjects(mScalarDataObjects);
+    clearDataObjects(mVectorDataObjects);
+    clearDataObjects(mMatrixDataObjects);
+    clearDataObjects(mSurfaceDataObjects);
+    for (AbstractDataObject const* pObject : pTemplate->scalarDataObjects)
+        mScalarDataObjects.push_back(pObject->clone());
+    for (AbstractDataObject const* pObject : pTemplate->vectorDataObjects)
+        mVectorDataObjects.push_back(pObject->clone());
+    for (AbstractDataObject const* pObject : pTemplate->matrixDataObjects)
+        mMatrixDataObjects.push_back(pObject->clone());
+    for (AbstractDataObject const* pObject : pTemplate->surfaceDataObjects)
+        mSurfaceDataObjects.push_back(pObject->clone());
     // Set the project identifier
-    readProjectID(path);
-    // Read the file named RODS
-    mRods = readAllLines(path, skFileNameRods);
-    // Read the file named PROG
-    mProgram = readAllLines(path, skFileNameProgram);
+    mProjectID = pTemplate->projectID;
+    // Copy the content of the files named RODS and PROG
+    mRods = pTemplate->rods;
+    mProgram = pTemplate->program;
+    mTemplateStamps = pTemplate->stamps;
+    mIsTemplateChanged = true;
+    if (pErrorString)
+        *pErrorString = pTemplate->errorString;
+    return pTemplate->errorString.isEmpty();
 }
 
-//! Create a data object with the specified type
-AbstractDataObject* Project::addDataObject(AbstractDataObject::ObjectType type)
+//! Check whether the template files located in the directory have been modified since the template data was read
+bool Project::isTemplateOutdated(QString const& path) const
 {
-    QString name;
-    AbstractDataObject* pObject = nullptr;
-    switch (type)
+    return mTemplateStamps != TemplateCache::stamps(path);
+}
+
+/*!
+ * \brief Write the computational data
+ *
+ * Only the quantities which depend on the parameters changed since the previous writing are recomputed.
+ * Files are rewritten only if their content differs from the one written before.
+ */
+CalcDataReport Project::writeCalcData(QString const& path, SolutionOptions const& options)
+{
+    CalcDataReport report;
+    CalcDataInputs inputs = calcDataInputs(options);
+    report.changes = inputs.compare(mWrittenInputs);
+    if (mIsTemplateChanged)
+        report.changes |= kTemplateChange;
+    // Compute the parameters of spans
+    if (!mSpans || (report.changes & (kCableChange | kGeometryChange)))
+    {
+        mSpans = mRodSystem.computeSpans();
+        report.isSpansComputed = true;
+    }
+    // Modify the data objects
+    bool isScalarModified = report.changes & (kTemplateChange | kCableChange | kDamperChange);
+    bool isVectorModified = report.changes & (kTemplateChange | kCableChange | kGeometryChange | kDamperChange | kSupportChange);
+    if (isScalarModified)
+        modifyScalarDataObjects();
+    if (isVectorModified && !modifyVectorDataObjects(*mSpans))
+    {
+        // Nothing is written, so that the files of the previous writing stay consistent
+        report.failedFiles.push_back(ProjectTemplate::skFileNameVector);
+        report.errorString = QString("The template does not provide the items for %1 rods").arg(mRodSystem.numRods());
+        mSpans.reset();
+        return report;
+    }
+    // Write the data objects
+    if (isScalarModified || !isWritten(path + ProjectTemplate::skFileNameScalar))
+        saveFile(path, ProjectTemplate::skFileNameScalar, writeDataObjects(mScalarDataObjects), report);
+    else
+        report.skippedFiles.push_back(ProjectTemplate::skFileNameScalar);
+    if (isVectorModified || !isWritten(path + ProjectTemplate::skFileNameVector))
+        saveFile(path, ProjectTemplate::skFileNameVector, writeDataObjects(mVectorDataObjects), report);
+    else
+        report.skippedFiles.push_back(ProjectTemplate::skFileNameVector);
+    // The matrix and surface data objects are not affected by the project parameters and are optional
+    std::pair<DataObjects const*, QString> const optionalObjects[] = {{&mMatrixDataObjects, ProjectTemplate::skFileNameMatrix},
+                                                                      {&mSurfaceDataObjects, ProjectTemplate::skFileNameSurface}};
+    for (auto const& [pDataObjects, fileName] : optionalObjects)
     {
-    case AbstractDataObject::ObjectType::kScalar:
-        name = "Scalar " + QString::number(ScalarDataObject::numberInstances() + 1);
-        pObject = new ScalarDataObject(name);
-        mScalarDataObjects.push_back(pObject);
-        break;
-    case AbstractDataObject::ObjectType::kVector:
-        name = "Vector " + QString::number(VectorDataObject::numberInstances() + 1);
-        pObject = new VectorDataObject(name);
-        mVectorDataObjects.push_back(pObject);
-        break;
-    default:
-        break;
+        if (pDataObjects->empty())
+            continue;
+        if ((report.changes & kTemplateChange) || !isWritten(path + fileName))
+            saveFile(path, fileName, writeDataObjects(*pDataObjects), report);
+        else
+            report.skippedFiles.push_back(fileName);
     }
-    return pObject;
+    // Rewrite the data of the rods and program
+    saveFile(path, ProjectTemplate::skFileNameRods, writeRods(), report);
+    saveFile(path, ProjectTemplate::skFileNameProgram, writeProgram(mRodSystem.numRods(), options.numCalcModes()), report);
+    mWrittenInputs = inputs;
+    mIsTemplateChanged = false;
+    return report;
 }
 
-//! Import several data objects from a file
-void Project::importDataObjects(QString const& path, QString const& fileName)
+//! Collect the parameters the computational data depends on
+Project::CalcDataInputs Project::calcDataInputs(SolutionOptions const& options) const
 {
-    auto [type, pFile] = Utilities::File::getDataObjectFile(path, fileName);
-    if (pFile == nullptr)
-        return;
-    QTextStream stream(pFile.data());
-    quint32 numDataObjects;
-    stream.readLine();
-    stream >> numDataObjects;
-    stream.readLine();
-    for (quint32 iDataObject = 0; iDataObject != numDataObjects; ++iDataObject)
+    CalcDataInputs inputs;
+    inputs.nameCable = mRodSystem.nameCable();
+    inputs.distances = mRodSystem.distances();
+    inputs.force = mRodSystem.force();
+    inputs.springLength = mDamper.springLength();
+    inputs.springStiffness = mDamper.springStiffness();
+    inputs.longitudinalStiffness = mSupport.longitudinalStiffness();
+    inputs.verticalStiffness = mSupport.verticalStiffness();
+    inputs.numCalcModes = options.numCalcModes();
+    return inputs;
+}
+
+//! Find the groups of parameters which differ
+int Project::CalcDataInputs::compare(CalcDataInputs const& another) const
+{
+    int changes = kNoChange;
+    if (nameCable != another.nameCable)
+        changes |= kCableChange;
+    if (distances != another.distances || force != another.force)
+        changes |= kGeometryChange;
+    if (springLength != another.springLength || springStiffness != another.springStiffness)
+        changes |= kDamperChange;
+    if (longitudinalStiffness != another.longitudinalStiffness || verticalStiffness != another.verticalStiffness)
+        changes |= kSupportChange;
+    if (numCalcModes != another.numCalcModes)
+        changes |= kModesChange;
+    return changes;
+}
+
+//! Write the template data, including the modifications made, to a binary stream
+void Project::serializeTemplateData(QDataStream& stream) const
+{
+    stream << (qint32)mProjectID << mRods << mProgram;
+    for (DataObjects const* pDataObjects : {&mScalarDataObjects, &mVectorDataObjects, &mMatrixDataObjects, &mSurfaceDataObjects})
     {
-        AbstractDataObject* pDataObject = addDataObject(type);
-        pDataObject->import(stream);
+        stream << (quint32)pDataObjects->size();
+        for (AbstractDataObject const* pObject : *pDataObjects)
+            stream << *pObject;
     }
-    pFile->close();
+    stream << (quint32)mTemplateStamps.size();
+    for (qint64 stamp : mTemplateStamps)
+        stream << stamp;
 }
 
-//! Read the identifier of a project
-void Project::readProjectID(QString const& path)
+//! Read the template data from a binary stream. The data is left intact, if the stream is corrupted
+bool Project::deserializeTemplateData(QDataStream& stream)
 {
-    QFile file(path + skFileNameProject);
-    if (!file.open(QIODeviceBase::ReadOnly))
-        return;
-    QTextStream stream(&file);
-    qint64 id;
-    stream >> id;
-    mProjectID = id;
-    file.close();
+    qint32 projectID;
+    QStringList rods, program;
+    stream >> projectID >> rods >> program;
+    // The matrix and surface data objects are absent in the files written before they were introduced
+    DataObjects dataObjects[4];
+    for (DataObjects& objects : dataObjects)
+    {
+        if (&objects >= &dataObjects[2] && stream.atEnd())
+            break;
+        quint32 numObjects = 0;
+        stream >> numObjects;
+        for (quint32 i = 0; i != numObjects && stream.status() == QDataStream::Ok; ++i)
+        {
+            quint32 type;
+            QString name;
+            stream >> type >> name;
+            AbstractDataObject* pObject = createDataObject((AbstractDataObject::ObjectType)type);
+            if (!pObject)
+            {
+                stream.setStatus(QDataStream::ReadCorruptData);
+                break;
+            }
+            pObject->setName(name);
+            pObject->deserialize(stream);
+            objects.push_back(pObject);
+        }
+    }
+    // The stamps of the template files are absent in the files written before they were introduced
+    std::vector<qint64> stamps;
+    if (!stream.atEnd())
+    {
+        quint32 numStamps = 0;
+        stream >> numStamps;
+        for (quint32 i = 0; i != numStamps && stream.status() == QDataStream::Ok; ++i)
+        {
+            qint64 stamp;
+            stream >> stamp;
+            stamps.push_back(stamp);
+        }
+    }
+    if (stream.status() != QDataStream::Ok)
+    {
+        for (DataObjects& objects : dataObjects)
+            clearDataObjects(objects);
+        return false;
+    }
+    clearDataObjects(mScalarDataObjects);
+    clearDataObjects(mVectorDataObjects);
+    clearDataObjects(mMatrixDataObjects);
+    clearDataObjects(mSurfaceDataObjects);
+    mScalarDataObjects = std::move(dataObjects[0]);
+    mVectorDataObjects = std::move(dataObjects[1]);
+    mMatrixDataObjects = std::move(dataObjects[2]);
+    mSurfaceDataObjects = std::move(dataObjects[3]);
+    mProjectID = projectID;
+    mRods = std::move(rods);
+    mProgram = std::move(program);
+    mTemplateStamps = std::move(stamps);
+    mIsTemplateChanged = true;
+    return true;
 }
 
-//! Write the computational data
-void Project::writeCalcData(QString const& path, SolutionOptions const& options)
+//! Write the state of the previous writing of the computational data to a binary stream
+void Project::serializeCalcState(QDataStream& stream) const
 {
-    Spans spans = mRodSystem.computeSpans();
-    // Modify the data objects
-    modifyScalarDataObjects();
-    modifyVectorDataObjects(spans);
-    // Write the data objects
-    writeDataObjects(mScalarDataObjects, path, skFileNameScalar);
-    writeDataObjects(mVectorDataObjects, path, skFileNameVector);
-    // Rewrite the data of the rods and program
-    writeRods(path, skFileNameRods);
-    writeProgram(path, skFileNameProgram, mRodSystem.numRods(), options.numCalcModes());
+    // Parameters of spans
+    stream << mSpans.has_value();
+    if (mSpans)
+    {
+        writeVector(stream, mSpans->u0);
+        writeVector(stream, mSpans->uL);
+        writeVector(stream, mSpans->L);
+        stream << mSpans->projectedForce << (qint32)mSpans->numIterations << mSpans->isConverged;
+    }
+    // Parameters used
+    stream << mIsTemplateChanged;
+    stream << QString::fromStdString(mWrittenInputs.nameCable);
+    writeVector(stream, mWrittenInputs.distances);
+    stream << mWrittenInputs.force << mWrittenInputs.springLength << mWrittenInputs.springStiffness
+           << mWrittenInputs.longitudinalStiffness << mWrittenInputs.verticalStiffness << (qint32)mWrittenInputs.numCalcModes;
+    // Files written
+    stream << (quint32)mWrittenFiles.size();
+    for (auto const& [pathFile, file] : mWrittenFiles)
+        stream << pathFile << (quint64)file.hash << file.size << file.modified;
+}
+
+//! Read the state of the previous writing of the computational data from a binary stream
+bool Project::deserializeCalcState(QDataStream& stream)
+{
+    bool isSpans;
+    std::optional<Spans> spans;
+    stream >> isSpans;
+    if (isSpans)
+    {
+        qint32 numIterations;
+        spans.emplace(0);
+        readVector(stream, spans->u0);
+        readVector(stream, spans->uL);
+        readVector(stream, spans->L);
+        stream >> spans->projectedForce >> numIterations >> spans->isConverged;
+        spans->numIterations = numIterations;
+    }
+    bool isTemplateChanged;
+    CalcDataInputs inputs;
+    QString nameCable;
+    qint32 numCalcModes;
+    stream >> isTemplateChanged >> nameCable;
+    readVector(stream, inputs.distances);
+    stream >> inputs.force >> inputs.springLength >> inputs.springStiffness
+           >> inputs.longitudinalStiffness >> inputs.verticalStiffness >> numCalcModes;
+    inputs.nameCable = nameCable.toStdString();
+    inputs.numCalcModes = numCalcModes;
+    std::map<QString, WrittenFile> writtenFiles;
+    quint32 numFiles = 0;
+    stream >> numFiles;
+    for (quint32 i = 0; i != numFiles && stream.status() == QDataStream::Ok; ++i)
+    {
+        QString pathFile;
+        quint64 hash;
+        WrittenFile file;
+        stream >> pathFile >> hash >> file.size >> file.modified;
+        file.hash = hash;
+        writtenFiles[pathFile] = file;
+    }
+    if (stream.status() != QDataStream::Ok)
+        return false;
+    mSpans = std::move(spans);
+    mWrittenInputs = std::move(inputs);
+    mWrittenFiles = std::move(writtenFiles);
+    mIsTemplateChanged = isTemplateChanged || !hasTemplateData();
+    return true;
 }
 
 //! Modify scalar data objects
 void Project::modifyScalarDataObjects()
 {
     // Изменение объектов
-    Cable const& cable = mDataBaseCables.getItem(mRodSystem.nameCable());
+    Cable const& cable = mRodSystem.cable();
     // EJ
     mScalarDataObjects[0]->setArrayValue(0.0, cable.bendingStiffness);
     // GJ
@@ -143,13 +347,19 @@ void Project::modifyScalarDataObjects()
     mScalarDataObjects[5]->setArrayValue(0.0, mDamper.springLength() * mDamper.springStiffness());
 }
 
-//! Modify vector data objects
-void Project::modifyVectorDataObjects(Spans const& spans)
+/*!
+ * \brief Modify vector data objects
+ * \return Whether the template provides the items for all the rods and devices. Nothing is modified otherwise
+ */
+bool Project::modifyVectorDataObjects(Spans const& spans)
 {
     int kNumElements = 3;
-    // Coordinates of cables
     int numRods = mRodSystem.numRods();
     AbstractDataObject* pRodCoordinates = mVectorDataObjects[0];
+    AbstractDataObject* pDeviceCoordinates = mVectorDataObjects[1];
+    if (!hasKeys(pRodCoordinates, 1, 2 * numRods) || !hasKeys(pDeviceCoordinates, 0, 2 * numRods - 3))
+        return false;
+    // Coordinates of cables
     double sumLength = 0.0;
     int k = 1;
     for (int i = 0; i != numRods; ++i)
@@ -160,7 +370,6 @@ void Project::modifyVectorDataObjects(Spans const& spans)
         k += 2;
     }
     // Coordinates of devices
-    AbstractDataObject* pDeviceCoordinates = mVectorDataObjects[1];
     k = 0;
     for (int i = 0; i != numRods - 1; ++i)
     {
@@ -208,44 +417,52 @@ void Project::modifyVectorDataObjects(Spans const& spans)
     }
     pRestStiffness->setArrayValue(keys[1], 0.0);
     pRestStiffness->changeItemKey(keys[1], newKey);
+    return true;
 }
 
-//! Write data objects to a file
-void Project::writeDataObjects(DataObjects const& dataObjects, QString const& path, QString const& fileName)
+//! Write data objects to a text
+QByteArray Project::writeDataObjects(DataObjects const& dataObjects)
 {
-    // Open a file for writing
-    QFile file(path + fileName);
-    if (!file.open(QIODeviceBase::WriteOnly))
-        return;
-    QTextStream stream(&file);
-    stream.setFieldAlignment(QTextStream::AlignRight);
-    stream.setFieldWidth(skFieldWidth);
+    PrnWriter writer(skFieldWidth);
+    writer.reserve(estimateTextSize(dataObjects));
     // 1. Identifier of the project
-    stream << mProjectID;
-    stream << Qt::endl;
+    writer.write(mProjectID);
+    writer.endLine();
     // 2. Number of scalar data objects
-    stream << dataObjects.size();
-    stream << Qt::endl;
+    writer.write(dataObjects.size());
+    writer.endLine();
     // 3. Data of objects
     for (auto const& item : dataObjects)
-        item->write(stream);
-    file.close();
+        item->write(writer);
+    return writer.buffer();
 }
 
-//! Write data of rods
-void Project::writeRods(QString const& path, QString const& fileName)
+//! Estimate the number of characters needed to write data objects
+qsizetype estimateTextSize(DataObjects const& dataObjects)
+{
+    qsizetype numFields = 4;
+    for (auto const& item : dataObjects)
+    {
+        quint32 numItems = item->numberItems();
+        IndexType numRows = item->numberItemRows();
+        numFields += 3 + numItems * (1 + numRows * (item->numberItemCols() + 1));
+    }
+    return numFields * skFieldWidth;
+}
+
+//! Write data of rods to a text
+QByteArray Project::writeRods()
 {
     int NP = (mRodSystem.numRods() - 1) * 3 + 1;
     // Substitute the number of rods
     QString subString = QString::number(NP);
     QString& line = mRods[1];
     replaceStringEntry(line, 0, subString);
-    // Save the change
-    writeAllLines(mRods, path, fileName);
+    return joinLines(mRods);
 }
 
-//! Write data of a program
-void Project::writeProgram(QString const& path, QString const& fileName, int numRods, int numModes)
+//! Write data of a program to a text
+QByteArray Project::writeProgram(int numRods, int numModes)
 {
     QString subString;
     // Substitue the boundary condition for the last rod
@@ -261,8 +478,56 @@ void Project::writeProgram(QString const& path, QString const& fileName, int num
         iBoundary = 7; // Forbid the rotation along the axis
     subString = QString::number(iBoundary);
     replaceStringEntry(mProgram[8], 3, subString);
-    // Save the changes
-    writeAllLines(mProgram, path, fileName);
+    return joinLines(mProgram);
+}
+
+//! Check if a file has not been modified since it was written by the project
+bool Project::isWritten(QString const& pathFile) const
+{
+    auto iter = mWrittenFiles.find(pathFile);
+    if (iter == mWrittenFiles.end())
+        return false;
+    QFileInfo info(pathFile);
+    return info.exists() && info.size() == iter->second.size && info.lastModified().toMSecsSinceEpoch() == iter->second.modified;
+}
+
+//! Save the content to a file unless the file already holds it
+void Project::saveFile(QString const& path, QString const& fileName, QByteArray const& content, CalcDataReport& report)
+{
+    QString pathFile = path + fileName;
+    std::size_t hash = qHash(content);
+    if (isWritten(pathFile) && mWrittenFiles[pathFile].hash == hash)
+    {
+        report.skippedFiles.push_back(fileName);
+        return;
+    }
+    mWrittenFiles.erase(pathFile);
+    QFile file(pathFile);
+    bool isOk = file.open(QIODeviceBase::WriteOnly) && file.write(content) == content.size();
+    file.close();
+    if (!isOk)
+    {
+        report.failedFiles.push_back(fileName);
+        return;
+    }
+    QFileInfo info(pathFile);
+    mWrittenFiles[pathFile] = {hash, info.size(), info.lastModified().toMSecsSinceEpoch()};
+    report.writtenFiles.push_back(fileName);
+}
+
+//! Represent the report as a single line
+QString CalcDataReport::toString() const
+{
+    QString result = QString("Spans: %1").arg(isSpansComputed ? "computed" : "reused");
+    if (!writtenFiles.isEmpty())
+        result += QString(". Written: %1").arg(writtenFiles.join(", "));
+    if (!skippedFiles.isEmpty())
+        result += QString(". Unchanged: %1").arg(skippedFiles.join(", "));
+    if (!failedFiles.isEmpty())
+        result += QString(". Failed: %1").arg(failedFiles.join(", "));
+    if (!errorString.isEmpty())
+        result += QString(". Error: %1").arg(errorString);
+    return result;
 }
 
 //! Replace a substring after specified number of skips
@@ -308,31 +573,16 @@ void replaceStringEntry(QString& string, int numSkipEntries, QString subString)
     }
 }
 
-//! Read all the lines from a file
-QStringList readAllLines(QString const& path, QString const& fileName)
+//! Join all the lines terminated by the line feed
+QByteArray joinLines(QStringList const& lines)
 {
-    QStringList lines;
-    QFile file(path + fileName);
-    if (!file.open(QIODeviceBase::ReadOnly))
-        return lines;
-    QTextStream stream(&file);
-    QString tString;
-    while (stream.readLineInto(&tString))
-        lines.push_back(tString);
-    file.close();
-    return lines;
-}
-
-//! Write all the lines to a file
-void writeAllLines(QStringList const& lines, QString const& path, QString const& fileName)
-{
-    QFile file(path + fileName);
-    if (!file.open(QIODeviceBase::WriteOnly))
-        return;
-    QTextStream stream(&file);
+    QByteArray content;
     for (auto const& line : lines)
-        stream << line << Qt::endl;
-    file.close();
+    {
+        content.append(line.toUtf8());
+        content.append('\n');
+    }
+    return content;
 }
 
 //! Helper function to clear a container consisted of pointers to data objects
@@ -342,3 +592,31 @@ void clearDataObjects(DataObjects& dataObjects)
         delete *iter;
     dataObjects.clear();
 }
+
+//! Write values preceded by their number
+void writeVector(QDataStream& stream, std::vector<double> const& values)
+{
+    stream << (quint32)values.size();
+    writeBlock(stream, values.data(), values.size());
+}
+
+//! Read values preceded by their number
+bool readVector(QDataStream& stream, std::vector<double>& values)
+{
+    quint32 numValues = 0;
+    stream >> numValues;
+    values.resize(stream.status() == QDataStream::Ok ? numValues : 0);
+    return readBlock(stream, values.data(), values.size());
+}
+
+//! Check whether a data object contains the items for all the keys in the range
+bool hasKeys(AbstractDataObject const* pDataObject, int firstKey, int lastKey)
+{
+    std::vector<DataKeyType> const& keys = pDataObject->keys();
+    for (int key = firstKey; key <= lastKey; ++key)
+    {
+        if (!std::binary_search(keys.begin(), keys.end(), key))
+            return false;
+    }
+    return true;
+}
@@ -9,6 +9,8 @@
 #define PROJECT_H
 
 #include <QString>
+#include <map>
+#include <optional>
 #include "abstractdataobject.h"
 #include "damper.h"
 #include "rodsystem.h"
@@ -28,7 +30,35 @@ namespace Core
 class ScalarDataObject;
 class VectorDataObject;
 
-using DataObjects = std::vector<AbstractDataObject*>;
+//! Groups of parameters the computational data depends on
+enum CalcDataChange
+{
+    kNoChange       = 0,
+    kTemplateChange = 1 << 0,
+    kCableChange    = 1 << 1,
+    kGeometryChange = 1 << 2,
+    kDamperChange   = 1 << 3,
+    kSupportChange  = 1 << 4,
+    kModesChange    = 1 << 5
+};
+
+//! Summary of writing the computational data
+struct CalcDataReport
+{
+    QString toString() const;
+    //! Groups of parameters changed since the previous writing
+    int changes = kNoChange;
+    //! Flag which indicates whether the parameters of spans were recomputed
+    bool isSpansComputed = false;
+    //! Files which were rewritten
+    QStringList writtenFiles;
+    //! Files which were left intact, since their content had not changed
+    QStringList skippedFiles;
+    //! Files which could not be written
+    QStringList failedFiles;
+    //! Reason why the data could not be computed
+    QString errorString;
+};
 
 class Project
 {
@@ -42,20 +72,47 @@ public:
     Support& support() { return mSupport; }
     DataBaseCables const& dataBaseCables() const { return mDataBaseCables; }
     // IO
-    void readTemplateData(QString const& path);
-    void writeCalcData(QString const& path, Solution::SolutionOptions const& options);
+    bool readTemplateData(QString const& path, QString* pErrorString = nullptr);
+    CalcDataReport writeCalcData(QString const& path, Solution::SolutionOptions const& options);
+    // Computed state
+    bool isTemplateOutdated(QString const& path) const;
+    bool hasTemplateData() const { return !mScalarDataObjects.empty() || !mVectorDataObjects.empty() || !mMatrixDataObjects.empty() || !mSurfaceDataObjects.empty(); }
+    void serializeTemplateData(QDataStream& stream) const;
+    bool deserializeTemplateData(QDataStream& stream);
+    void serializeCalcState(QDataStream& stream) const;
+    bool deserializeCalcState(QDataStream& stream);
 
 private:
-    AbstractDataObject* addDataObject(AbstractDataObject::ObjectType type);
-    void importDataObjects(QString const& path, QString const& fileName);
-    void readProjectID(QString const& path);
+    //! Parameters used to write the computational data
+    struct CalcDataInputs
+    {
+        int compare(CalcDataInputs const& another) const;
+        std::string nameCable;
+        std::vector<double> distances;
+        double force = 0.0;
+        double springLength = 0.0;
+        double springStiffness = 0.0;
+        double longitudinalStiffness = 0.0;
+        double verticalStiffness = 0.0;
+        int numCalcModes = 0;
+    };
+    //! State of a file written
+    struct WrittenFile
+    {
+        std::size_t hash;
+        qint64 size;
+        qint64 modified;
+    };
+    CalcDataInputs calcDataInputs(Solution::SolutionOptions const& options) const;
     // Modify data objects
     void modifyScalarDataObjects();
-    void modifyVectorDataObjects(Spans const& spans);
+    bool modifyVectorDataObjects(Spans const& spans);
     // IO
-    void writeDataObjects(DataObjects const& dataObjects, QString const& path, QString const& fileName);
-    void writeRods(QString const& path, QString const& fileName);
-    void writeProgram(QString const& path, QString const& fileName, int numRods, int numCalcModes);
+    QByteArray writeDataObjects(DataObjects const& dataObjects);
+    QByteArray writeRods();
+    QByteArray writeProgram(int numRods, int numCalcModes);
+    bool isWritten(QString const& pathFile) const;
+    void saveFile(QString const& path, QString const& fileName, QByteArray const& content, CalcDataReport& report);
 
 private:
     //! Name of a project
@@ -71,12 +128,24 @@ private:
     //! Data objects
     DataObjects mScalarDataObjects;
     DataObjects mVectorDataObjects;
+    DataObjects mMatrixDataObjects;
+    DataObjects mSurfaceDataObjects;
     //! Project identifier
     int mProjectID;
     //! Content of the file named RODS
     QStringList mRods;
     //! Content of the file name PROG
     QStringList mProgram;
+    //! Modification times and sizes of the template files the data was read from
+    std::vector<qint64> mTemplateStamps;
+    //! Flag which indicates whether the template has been read since the previous writing
+    bool mIsTemplateChanged = true;
+    //! Parameters used in the previous writing
+    CalcDataInputs mWrittenInputs;
+    //! Parameters of spans computed in the previous writing
+    std::optional<Spans> mSpans;
+    //! Files written, accessed by their paths
+    std::map<QString, WrittenFile> mWrittenFiles;
     //! Project extension
     static const QString skProjectExtension;
 };
@@ -0,0 +1,287 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the ResultCache class
+ */
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <algorithm>
+#include "resultcache.h"
+
+using namespace RSE::Solution;
+
+static QString const skFileNameManifest = "manifest.txt";
+static QString const skSuffixIncomplete = ".tmp";
+
+ResultCache::ResultCache(QString const& cachePath, qint64 maxSize, int maxNumEntries)
+    : mMaxSize(maxSize)
+    , mMaxNumEntries(maxNumEntries)
+{
+    mCachePath = QFileInfo(cachePath).absoluteFilePath();
+    if (!mCachePath.endsWith('/'))
+        mCachePath.append('/');
+    QDir().mkpath(mCachePath);
+    mPool.setMaxThreadCount(1);
+    scan();
+}
+
+//! Wait for the files being copied, so that no entry is left half-written
+ResultCache::~ResultCache()
+{
+    mPool.waitForDone();
+}
+
+/*!
+ * \brief Hash relative paths and contents of files
+ *
+ * Absent files are hashed as empty ones, so that their appearance changes the key.
+ * Files of the same name in different subdirectories are distinguished, while the key does not depend on the root directory
+ * \param rootPath Directory the paths of files are relative to
+ * \param salt Additional data which the result depends on, such as stamps of solvers
+ */
+QByteArray ResultCache::computeKey(QString const& rootPath, QStringList const& relativePathFiles, QByteArray const& salt)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(salt);
+    QDir root(rootPath);
+    for (QString const& relativePathFile : relativePathFiles)
+    {
+        QFile file(root.filePath(relativePathFile));
+        hash.addData(QDir::cleanPath(relativePathFile).toUtf8());
+        QByteArray size = QByteArray::number(file.exists() ? file.size() : -1);
+        hash.addData(size);
+        if (file.open(QIODevice::ReadOnly))
+            hash.addData(&file);
+    }
+    return hash.result().toHex();
+}
+
+//! Identify the version of a file, such as an executable, without reading it
+QByteArray ResultCache::fileStamp(QString const& pathFile)
+{
+    QFileInfo info(pathFile);
+    if (!info.exists())
+        return QByteArray();
+    return info.fileName().toUtf8() + ':' + QByteArray::number(info.size()) + ':'
+           + QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+}
+
+bool ResultCache::contains(QByteArray const& key) const
+{
+    return mEntries.find(key) != mEntries.end();
+}
+
+/*!
+ * \brief Start copying the files produced into a new entry
+ *
+ * The files should not be modified until the insertion is completed, which is signalled by inserted()
+ * \param rootPath Directory the paths of files are relative to
+ * \return Whether the insertion has been started
+ */
+bool ResultCache::insert(QByteArray const& key, QString const& rootPath, QStringList const& relativePathFiles)
+{
+    QDir root(rootPath);
+    qint64 size = 0;
+    for (QString const& relativePathFile : relativePathFiles)
+        size += QFileInfo(root.filePath(relativePathFile)).size();
+    if (key.isEmpty() || relativePathFiles.isEmpty() || size > mMaxSize)
+        return false;
+    // Complete the entry in its own directory before it replaces the previous one
+    QString incompletePath = QString("%1.%2%3").arg(entryPath(key)).arg(++mNumInserted).arg(skSuffixIncomplete);
+    Entry entry{relativePathFiles, size, QDateTime()};
+    QString sourcePath = root.absolutePath();
+    mPool.start([this, key, sourcePath, incompletePath, entry]()
+    {
+        bool isOk = copyFiles(sourcePath, incompletePath, entry.relativePathFiles);
+        if (isOk)
+        {
+            QFile manifest(QDir(incompletePath).filePath(skFileNameManifest));
+            isOk = manifest.open(QIODevice::WriteOnly);
+            if (isOk)
+            {
+                QTextStream stream(&manifest);
+                for (QString const& relativePathFile : entry.relativePathFiles)
+                    stream << relativePathFile << '\n';
+            }
+        }
+        QMetaObject::invokeMethod(this, [=, this]() { completeInsert(key, incompletePath, entry, isOk); }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+/*!
+ * \brief Start copying the files of an entry to their places
+ *
+ * The completion is signalled by restored(). A damaged entry is removed
+ * \return Whether the restoration has been started
+ */
+bool ResultCache::restore(QByteArray const& key, QString const& rootPath)
+{
+    auto iter = mEntries.find(key);
+    if (iter == mEntries.end())
+        return false;
+    QString sourcePath = entryPath(key);
+    QString targetPath = QDir(rootPath).absolutePath();
+    QStringList relativePathFiles = iter->second.relativePathFiles;
+    mPool.start([this, key, sourcePath, targetPath, relativePathFiles]()
+    {
+        bool isOk = copyFiles(sourcePath, targetPath, relativePathFiles);
+        QMetaObject::invokeMethod(this, [=, this]() { completeRestore(key, isOk); }, Qt::QueuedConnection);
+    });
+    return true;
+}
+
+//! Wait for all the operations started to be completed
+void ResultCache::waitForDone()
+{
+    mPool.waitForDone();
+    QCoreApplication::sendPostedEvents(this);
+}
+
+void ResultCache::remove(QByteArray const& key)
+{
+    mEntries.erase(key);
+    QDir(entryPath(key)).removeRecursively();
+}
+
+void ResultCache::clear()
+{
+    while (!mEntries.empty())
+        remove(mEntries.begin()->first);
+}
+
+//! Total size of files stored, bytes
+qint64 ResultCache::size() const
+{
+    qint64 result = 0;
+    for (auto const& [key, entry] : mEntries)
+        result += entry.size;
+    return result;
+}
+
+void ResultCache::setLimits(qint64 maxSize, int maxNumEntries)
+{
+    mMaxSize = maxSize;
+    mMaxNumEntries = maxNumEntries;
+    evict(QByteArray());
+}
+
+//! Retrieve the entries which have been completed and remove the rest
+void ResultCache::scan()
+{
+    mEntries.clear();
+    QFileInfoList infos = QDir(mCachePath).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (QFileInfo const& info : infos)
+    {
+        QDir directory(info.absoluteFilePath());
+        QFile manifest(directory.filePath(skFileNameManifest));
+        if (info.fileName().endsWith(skSuffixIncomplete) || !manifest.open(QIODevice::ReadOnly))
+        {
+            directory.removeRecursively();
+            continue;
+        }
+        Entry entry;
+        entry.lastUsed = QFileInfo(manifest).lastModified();
+        QTextStream stream(&manifest);
+        QString line;
+        while (stream.readLineInto(&line))
+        {
+            if (line.isEmpty())
+                continue;
+            entry.relativePathFiles.push_back(line);
+            entry.size += QFileInfo(directory.filePath(line)).size();
+        }
+        mEntries[info.fileName().toUtf8()] = entry;
+    }
+    evict(QByteArray());
+}
+
+//! Remove the least recently used entries until the limits are satisfied
+void ResultCache::evict(QByteArray const& keepKey)
+{
+    std::vector<std::pair<QDateTime, QByteArray>> usage;
+    for (auto const& [key, entry] : mEntries)
+    {
+        if (key != keepKey)
+            usage.push_back({entry.lastUsed, key});
+    }
+    std::sort(usage.begin(), usage.end());
+    qint64 totalSize = size();
+    for (auto const& [lastUsed, key] : usage)
+    {
+        if (totalSize <= mMaxSize && (int)mEntries.size() <= mMaxNumEntries)
+            break;
+        totalSize -= mEntries[key].size;
+        remove(key);
+    }
+}
+
+//! Make the entry copied by the worker visible
+void ResultCache::completeInsert(QByteArray const& key, QString const& incompletePath, Entry const& entry, bool isOk)
+{
+    remove(key);
+    QString path = entryPath(key);
+    if (!isOk || !QDir().rename(incompletePath, path))
+    {
+        QDir(incompletePath).removeRecursively();
+        emit inserted(key, false);
+        return;
+    }
+    mEntries[key] = {entry.relativePathFiles, entry.size, QDateTime::currentDateTime()};
+    evict(key);
+    emit inserted(key, true);
+}
+
+//! Mark the entry restored by the worker as used or remove it, if it is damaged
+void ResultCache::completeRestore(QByteArray const& key, bool isOk)
+{
+    auto iter = mEntries.find(key);
+    if (!isOk)
+    {
+        remove(key);
+    }
+    else if (iter != mEntries.end())
+    {
+        QDateTime time = QDateTime::currentDateTime();
+        QFile manifest(QDir(entryPath(key)).filePath(skFileNameManifest));
+        if (manifest.open(QIODevice::Append))
+            manifest.setFileTime(time, QFileDevice::FileModificationTime);
+        iter->second.lastUsed = time;
+    }
+    emit restored(key, isOk);
+}
+
+QString ResultCache::entryPath(QByteArray const& key) const
+{
+    return mCachePath + QString::fromLatin1(key);
+}
+
+//! Copy files between directories by their relative paths
+bool ResultCache::copyFiles(QString const& sourcePath, QString const& targetPath, QStringList const& relativePathFiles)
+{
+    QDir source(sourcePath);
+    QDir target(targetPath);
+    for (QString const& relativePathFile : relativePathFiles)
+    {
+        if (!copyFile(source.filePath(relativePathFile), target.filePath(relativePathFile)))
+            return false;
+    }
+    return true;
+}
+
+//! Copy a file replacing the existing one and creating the directories needed
+bool ResultCache::copyFile(QString const& sourcePathFile, QString const& targetPathFile)
+{
+    QFileInfo target(targetPathFile);
+    if (!QDir().mkpath(target.absolutePath()))
+        return false;
+    if (target.exists())
+        QFile::remove(targetPathFile);
+    return QFile::copy(sourcePathFile, targetPathFile);
+}
@@ -0,0 +1,87 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the ResultCache class
+ */
+
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QDateTime>
+#include <QThreadPool>
+#include <map>
+
+namespace RSE::Solution
+{
+
+/*!
+ * \brief Cache of the files produced by solvers, which are identified by hashes of their inputs
+ *
+ * Each entry is a directory holding copies of the files along with a manifest which lists their paths relative to the root one.
+ * Entries are completed in a temporary directory before they become visible. The manifest is touched each time the entry is used,
+ * so that the least recently used entries are evicted once the limits of size or number of entries are exceeded.
+ * Files are copied by a worker thread one operation after another, and the completion of each operation is signalled
+ */
+class ResultCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    ResultCache(QString const& cachePath, qint64 maxSize = skDefaultMaxSize, int maxNumEntries = skDefaultMaxNumEntries);
+    ~ResultCache();
+    static QByteArray computeKey(QString const& rootPath, QStringList const& relativePathFiles, QByteArray const& salt = QByteArray());
+    static QByteArray fileStamp(QString const& pathFile);
+    bool contains(QByteArray const& key) const;
+    bool insert(QByteArray const& key, QString const& rootPath, QStringList const& relativePathFiles);
+    bool restore(QByteArray const& key, QString const& rootPath);
+    void waitForDone();
+    void remove(QByteArray const& key);
+    void clear();
+    int numEntries() const { return mEntries.size(); }
+    qint64 size() const;
+    qint64 maxSize() const { return mMaxSize; }
+    int maxNumEntries() const { return mMaxNumEntries; }
+    void setLimits(qint64 maxSize, int maxNumEntries);
+
+    static qint64 const skDefaultMaxSize = 4ll << 30;
+    static int const skDefaultMaxNumEntries = 64;
+
+signals:
+    void inserted(QByteArray const& key, bool isOk);
+    void restored(QByteArray const& key, bool isOk);
+
+private:
+    //! Description of an entry
+    struct Entry
+    {
+        QStringList relativePathFiles;
+        qint64 size = 0;
+        QDateTime lastUsed;
+    };
+    void scan();
+    void evict(QByteArray const& keepKey);
+    void completeInsert(QByteArray const& key, QString const& incompletePath, Entry const& entry, bool isOk);
+    void completeRestore(QByteArray const& key, bool isOk);
+    QString entryPath(QByteArray const& key) const;
+    static bool copyFiles(QString const& sourcePath, QString const& targetPath, QStringList const& relativePathFiles);
+    static bool copyFile(QString const& sourcePathFile, QString const& targetPathFile);
+
+private:
+    QString mCachePath;
+    qint64 mMaxSize;
+    int mMaxNumEntries;
+    std::map<QByteArray, Entry> mEntries;
+    //! Number of entries inserted, so that each insertion is completed in its own directory
+    int mNumInserted = 0;
+    //! Single worker, so that files are copied in the order the operations are requested
+    QThreadPool mPool;
+};
+
+}
+
+#endif // RESULTCACHE_H
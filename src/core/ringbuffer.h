@@ -0,0 +1,96 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the RingBuffer class
+ */
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <algorithm>
+#include <vector>
+
+namespace RSE::Core
+{
+
+/*!
+ * \brief Sequence of a fixed capacity which drops the oldest items when new ones do not fit
+ *
+ * Items are accessed from the oldest to the newest one. The storage is allocated once as the buffer fills up.
+ */
+template<typename T>
+class RingBuffer
+{
+public:
+    RingBuffer(int capacity);
+    ~RingBuffer() = default;
+    int size() const { return mSize; }
+    int capacity() const { return mCapacity; }
+    bool isEmpty() const { return mSize == 0; }
+    bool isFull() const { return mSize == mCapacity; }
+    T& operator[](int index) { return mItems[(mStart + index) % mCapacity]; }
+    T const& operator[](int index) const { return mItems[(mStart + index) % mCapacity]; }
+    T& back() { return (*this)[mSize - 1]; }
+    void push(T item);
+    void popFront(int numItems);
+    void clear();
+
+private:
+    int const mCapacity;
+    //! Storage which grows up to the capacity
+    std::vector<T> mItems;
+    //! Position of the oldest item
+    int mStart = 0;
+    int mSize = 0;
+};
+
+template<typename T>
+RingBuffer<T>::RingBuffer(int capacity)
+    : mCapacity(std::max(capacity, 1))
+{
+
+}
+
+//! Append an item overwriting the oldest one, if the buffer is full
+template<typename T>
+void RingBuffer<T>::push(T item)
+{
+    if ((int)mItems.size() < mCapacity)
+    {
+        mItems.push_back(std::move(item));
+        ++mSize;
+        return;
+    }
+    int iItem = (mStart + mSize) % mCapacity;
+    mItems[iItem] = std::move(item);
+    if (mSize == mCapacity)
+        mStart = (mStart + 1) % mCapacity;
+    else
+        ++mSize;
+}
+
+//! Remove the oldest items
+template<typename T>
+void RingBuffer<T>::popFront(int numItems)
+{
+    numItems = std::clamp(numItems, 0, mSize);
+    for (int i = 0; i != numItems; ++i)
+        (*this)[i] = T();
+    mStart = (mStart + numItems) % mCapacity;
+    mSize -= numItems;
+}
+
+//! Remove all the items and release the storage
+template<typename T>
+void RingBuffer<T>::clear()
+{
+    mItems.clear();
+    mItems.shrink_to_fit();
+    mStart = 0;
+    mSize = 0;
+}
+
+}
+
+#endif // RINGBUFFER_H
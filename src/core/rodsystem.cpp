@@ -6,15 +6,17 @@
  */
 
 #include <functional>
+#include <algorithm>
+#include <limits>
+#include <cmath>
 #include <stdlib.h>
 #include <stdio.h>
 #include <gsl/gsl_multiroots.h>
+#include <gsl/gsl_linalg.h>
 #include "rodsystem.h"
 #include "constants.h"
 #include "databasecables.h"
 
-using IntegralFun = std::function<double(double)>;
-
 using namespace RSE::Core;
 using namespace RSE::Constants;
 
@@ -26,17 +28,6 @@ RodSystem::RodSystem(std::vector<double> distances, Cable const& cable, double f
     setCable(cable);
 }
 
-//! Compute integral using the MidPoint rule
-double integrate(IntegralFun const& f, double const& a, double const& b, int const& n)
-{
-    if (n <= 0) return 0;
-    double integral = 0;
-    double h = (b - a) / n;
-    for (int i = 0; i != n; ++i)
-        integral += f(a + h * (i + 0.5));
-    return integral * h;
-}
-
 double x1(double u, double u0, double uL)
 {
     return (u - u0) / (sinh(uL) - sinh(u0));
@@ -62,16 +53,18 @@ double Nf(double u, double u0, double uL)
     return cosh(u) / (sinh(uL) - sinh(u0));
 }
 
+/*!
+ * \brief Compute the stretched length of a rod
+ *
+ * The integral of the squared tension over the rod is evaluated analytically:
+ * int(cosh(u)^2, u0, uL) = (uL - u0) / 2 + (sinh(2 * uL) - sinh(2 * u0)) / 4
+ */
 double LL(double L, double u0, double uL, RodSystemParameters const* pParameters)
 {
-    const int kNumIntegrationSteps = 1000;
-    IntegralFun funSystem = [&pParameters, &u0, &uL, &L](double u)
-    {
-        double numerator = pow(Nf(u, u0, uL), 2.0) * pParameters->massPerLength * pow(L, 2.0) * kGravitationalAcceleration;
-        double denominator = pParameters->youngsModulus * pParameters->area;
-        return numerator / denominator;
-    };
-    return L + integrate(funSystem, u0, uL, kNumIntegrationSteps);
+    double integral = (uL - u0) / 2.0 + (sinh(2.0 * uL) - sinh(2.0 * u0)) / 4.0;
+    double numerator = pParameters->massPerLength * pow(L, 2.0) * kGravitationalAcceleration * integral;
+    double denominator = pow(sinh(uL) - sinh(u0), 2.0) * pParameters->youngsModulus * pParameters->area;
+    return L + numerator / denominator;
 }
 
 double projForce(double u0, double uL, double L, RodSystemParameters const* pParameters)
@@ -79,6 +72,58 @@ double projForce(double u0, double uL, double L, RodSystemParameters const* pPar
     return Q1(u0, uL) * pParameters->massPerLength * LL(L, u0, uL, pParameters) * kGravitationalAcceleration;
 }
 
+/*!
+ * \brief Approximate parameters of a rod by means of the parabolic sag
+ *
+ * Supports are located at the same level, so every rod is symmetric and its end tension equals the stretching force.
+ * The horizontal tension H follows from T = H + w * f, where f = w * d^2 / (8 * H) is the parabolic sag.
+ * The elongation is taken into account by solving the length equation for the found shape.
+ * \return false if the force is too low to hold the rod, true otherwise
+ */
+bool approximateParabolic(double distance, RodSystemParameters const* pParameters, double& u0, double& uL, double& L)
+{
+    double T = pParameters->force;
+    double w = pParameters->massPerLength * kGravitationalAcceleration;
+    double EA = pParameters->youngsModulus * pParameters->area;
+    if (T <= 0.0 || w <= 0.0 || EA <= 0.0 || distance <= 0.0)
+        return false;
+    double discriminant = pow(T, 2.0) - pow(w * distance, 2.0) / 2.0;
+    if (discriminant < 0.0)
+        return false;
+    double H = (T + sqrt(discriminant)) / 2.0;
+    // Shape of a rod
+    double a = w * distance / (2.0 * H);
+    u0 = -a;
+    uL = a;
+    // Stretched length is related to unstretched one as LL = L + c * L^2
+    double LL = distance * sinh(a) / a;
+    double c = w * (a + sinh(a) * cosh(a)) / (4.0 * pow(sinh(a), 2.0) * EA);
+    L = 2.0 * LL / (1.0 + sqrt(1.0 + 4.0 * c * LL));
+    return true;
+}
+
+/*!
+ * \brief Check whether a factorized matrix is singular
+ *
+ * The matrix is treated as singular, if a diagonal entry of its upper triangular factor is not finite or vanishes relative
+ * to the largest one
+ */
+bool isSingular(gsl_matrix const* pLU)
+{
+    std::size_t n = pLU->size1;
+    double minDiagonal = std::numeric_limits<double>::max();
+    double maxDiagonal = 0.0;
+    for (std::size_t i = 0; i != n; ++i)
+    {
+        double value = std::abs(gsl_matrix_get(pLU, i, i));
+        if (!std::isfinite(value))
+            return true;
+        minDiagonal = std::min(minDiagonal, value);
+        maxDiagonal = std::max(maxDiagonal, value);
+    }
+    return !(minDiagonal > n * std::numeric_limits<double>::epsilon() * maxDiagonal);
+}
+
 //! System of equations
 int equations(const gsl_vector* pState, void* pVoidParameters, gsl_vector* pFun)
 {
@@ -141,32 +186,85 @@ int equations(const gsl_vector* pState, void* pVoidParameters, gsl_vector* pFun)
 //! Compute characteristics of spans
 Spans RodSystem::computeSpans()
 {
-    const int kMaxIter            = 1000;
-    const double kTolResidual     = 1e-7;
-    const double kApproxU0        = -1e-3;
-    const double kApproxUL        = 1e-3;
-    const double kApproxDeltaSpan = 1;
+    const std::size_t kMaxNumCached = 16;
 
-    // Create an object to aggregate the results
     int numRods = mParameters.numRods;
-    Spans spans(numRods);
     if (numRods == 0)
         return Spans(numRods);
 
-    // Set the solution function
-    size_t n = 3 * numRods;
-    gsl_multiroot_function f = {&equations, n, &mParameters};
+    // Reuse the solution if the same system has already been solved
+    std::size_t hashParameters = hash();
+    auto iterCached = std::find_if(mCache.begin(), mCache.end(),
+                                   [this, hashParameters](CachedSpans const& item) { return isSame(item, hashParameters); });
+    if (iterCached != mCache.end())
+    {
+        Spans spans = iterCached->spans;
+        std::rotate(mCache.begin(), iterCached, iterCached + 1);
+        spans.numIterations = 0;
+        return spans;
+    }
 
-    // Specify the initial values of parameters to be optimized
-    gsl_vector* pState = gsl_vector_alloc(n);
-    int iLast = 0;
-    for (int iRod = 0; iRod != mParameters.numRods; ++iRod)
+    // Start from the closest solution obtained before
+    gsl_vector* pState = gsl_vector_alloc(3 * numRods);
+    setApproximation(pState, findClosest());
+    Spans spans = solveSpans(pState);
+    gsl_vector_free(pState);
+
+    // Remember the converged solution
+    if (spans.isConverged)
     {
-        gsl_vector_set(pState, iLast, kApproxU0);
-        gsl_vector_set(pState, iLast + 1, kApproxUL);
-        gsl_vector_set(pState, iLast + 2, mParameters.distances[iRod] + kApproxDeltaSpan);
-        iLast += 3;
+        mCache.push_front({hashParameters, mParameters, mCable.name, spans});
+        if (mCache.size() > kMaxNumCached)
+            mCache.pop_back();
     }
+    return spans;
+}
+
+/*!
+ * \brief Compute characteristics of spans starting from the specified solution
+ *
+ * The cache is neither used nor modified, so that the function suits for computing many perturbed systems.
+ * If the number of rods differs from the approximation, the solution is started from scratch.
+ */
+Spans RodSystem::computeSpans(Spans const& approximation)
+{
+    int numRods = mParameters.numRods;
+    if (numRods == 0)
+        return Spans(numRods);
+    gsl_vector* pState = gsl_vector_alloc(3 * numRods);
+    if ((int)approximation.L.size() == numRods)
+    {
+        int iLast = 0;
+        for (int iRod = 0; iRod != numRods; ++iRod)
+        {
+            gsl_vector_set(pState, iLast,     approximation.u0[iRod]);
+            gsl_vector_set(pState, iLast + 1, approximation.uL[iRod]);
+            gsl_vector_set(pState, iLast + 2, approximation.L[iRod]);
+            iLast += 3;
+        }
+    }
+    else
+    {
+        setApproximation(pState, nullptr);
+    }
+    Spans spans = solveSpans(pState);
+    gsl_vector_free(pState);
+    return spans;
+}
+
+//! Solve the system of equations starting from the specified state
+Spans RodSystem::solveSpans(gsl_vector const* pState)
+{
+    const int kMaxIter        = 1000;
+    const double kTolResidual = 1e-7;
+
+    // Create an object to aggregate the results
+    int numRods = mParameters.numRods;
+    Spans spans(numRods);
+
+    // Set the solution function
+    size_t n = 3 * numRods;
+    gsl_multiroot_function f = {&equations, n, &mParameters};
 
     // Compute the starting error
     size_t iter = 0;
@@ -175,8 +273,8 @@ Spans RodSystem::computeSpans()
     gsl_multiroot_fsolver_set (pSolver, &f, pState);
 
     // Solve the system
-    int status;
-    do
+    int status = gsl_multiroot_test_residual(pSolver->f, kTolResidual);
+    while (status == GSL_CONTINUE && iter < kMaxIter)
     {
         ++iter;
         status = gsl_multiroot_fsolver_iterate(pSolver);
@@ -185,10 +283,9 @@ Spans RodSystem::computeSpans()
             break;
         status = gsl_multiroot_test_residual(pSolver->f, kTolResidual);
     }
-    while (status == GSL_CONTINUE && iter < kMaxIter);
 
     // Solve the solution
-    iLast = 0;
+    int iLast = 0;
     for (int iRod = 0; iRod != numRods; ++iRod)
     {
         spans.u0[iRod] = gsl_vector_get(pSolver->x, iLast);
@@ -197,12 +294,279 @@ Spans RodSystem::computeSpans()
         iLast += 3;
     }
     spans.projectedForce = projForce(spans.u0[0], spans.uL[0], spans.L[0], &mParameters);
+    spans.numIterations = iter;
+    spans.isConverged = status == GSL_SUCCESS;
     // Free the working objects
     gsl_multiroot_fsolver_free(pSolver);
-    gsl_vector_free (pState);
     return spans;
 }
 
+/*!
+ * \brief Compute derivatives of spans with respect to parameters of a rod system
+ *
+ * The implicit function theorem is applied to the converged solution: dx/dp = -J^(-1) * dF/dp.
+ * So, the Jacobian is evaluated and factorized once, and all the parameters are processed as right-hand sides.
+ * Rows of the resulting matrix correspond to lengths of rods followed by the projected force.
+ * Columns correspond to distances between supports followed by the stretching force and axial stiffness (EA).
+ * \return Matrix of derivatives or an empty one, if the spans do not correspond to the rod system or the Jacobian is singular
+ */
+Array<double> RodSystem::computeSensitivity(Spans const& spans)
+{
+    const double kRelStep = GSL_SQRT_DBL_EPSILON;
+
+    int numRods = mParameters.numRods;
+    if ((int)spans.L.size() != numRods || (int)spans.u0.size() != numRods || (int)spans.uL.size() != numRods)
+        return Array<double>();
+    int numParameters = numRods + 2;
+    int iForce = numRods;
+    int iStiffness = numRods + 1;
+    Array<double> sensitivity(numRods + 1, numParameters);
+    if (numRods == 0)
+        return sensitivity;
+
+    // Set the state and residuals
+    size_t n = 3 * numRods;
+    gsl_multiroot_function f = {&equations, n, &mParameters};
+    gsl_vector* pState = gsl_vector_alloc(n);
+    gsl_vector* pFun = gsl_vector_alloc(n);
+    int iLast = 0;
+    for (int iRod = 0; iRod != numRods; ++iRod)
+    {
+        gsl_vector_set(pState, iLast,     spans.u0[iRod]);
+        gsl_vector_set(pState, iLast + 1, spans.uL[iRod]);
+        gsl_vector_set(pState, iLast + 2, spans.L[iRod]);
+        iLast += 3;
+    }
+    equations(pState, &mParameters, pFun);
+
+    // Factorize the Jacobian
+    int signum;
+    gsl_matrix* pJacobian = gsl_matrix_alloc(n, n);
+    gsl_permutation* pPermutation = gsl_permutation_alloc(n);
+    gsl_multiroot_fdjacobian(&f, pState, pFun, kRelStep, pJacobian);
+    gsl_linalg_LU_decomp(pJacobian, pPermutation, &signum);
+    if (isSingular(pJacobian))
+    {
+        gsl_permutation_free(pPermutation);
+        gsl_matrix_free(pJacobian);
+        gsl_vector_free(pFun);
+        gsl_vector_free(pState);
+        return Array<double>();
+    }
+
+    // Derivatives of the equations with respect to the axial stiffness
+    RodSystemParameters parameters = mParameters;
+    double stepStiffness = kRelStep * mParameters.youngsModulus;
+    gsl_vector* pForwardFun = gsl_vector_alloc(n);
+    gsl_vector* pBackwardFun = gsl_vector_alloc(n);
+    parameters.youngsModulus = mParameters.youngsModulus + stepStiffness;
+    equations(pState, &parameters, pForwardFun);
+    parameters.youngsModulus = mParameters.youngsModulus - stepStiffness;
+    equations(pState, &parameters, pBackwardFun);
+    double stepEA = 2.0 * stepStiffness * mParameters.area;
+
+    // Derivatives of the projected force with respect to the state of the first rod and the axial stiffness
+    double u0 = spans.u0[0];
+    double uL = spans.uL[0];
+    double L  = spans.L[0];
+    double dForceState[3];
+    for (int k = 0; k != 3; ++k)
+    {
+        double step = kRelStep * std::max(std::abs(gsl_vector_get(pState, k)), 1.0);
+        double shift[3] = {0.0, 0.0, 0.0};
+        shift[k] = step;
+        double forward = projForce(u0 + shift[0], uL + shift[1], L + shift[2], &mParameters);
+        double backward = projForce(u0 - shift[0], uL - shift[1], L - shift[2], &mParameters);
+        dForceState[k] = (forward - backward) / (2.0 * step);
+    }
+    parameters.youngsModulus = mParameters.youngsModulus + stepStiffness;
+    double dForceStiffness = projForce(u0, uL, L, &parameters);
+    parameters.youngsModulus = mParameters.youngsModulus - stepStiffness;
+    dForceStiffness = (dForceStiffness - projForce(u0, uL, L, &parameters)) / stepEA;
+
+    // Solve the linear systems: J * dx/dp = -dF/dp
+    gsl_vector* pRightSide = gsl_vector_alloc(n);
+    gsl_vector* pDerivative = gsl_vector_alloc(n);
+    for (int jParameter = 0; jParameter != numParameters; ++jParameter)
+    {
+        gsl_vector_set_zero(pRightSide);
+        if (jParameter < numRods)
+        {
+            gsl_vector_set(pRightSide, 2 * jParameter + 1, 1.0);
+        }
+        else if (jParameter == iForce)
+        {
+            gsl_vector_set(pRightSide, 2 * numRods, 1.0);
+        }
+        else
+        {
+            for (size_t i = 0; i != n; ++i)
+                gsl_vector_set(pRightSide, i, -(gsl_vector_get(pForwardFun, i) - gsl_vector_get(pBackwardFun, i)) / stepEA);
+        }
+        gsl_linalg_LU_solve(pJacobian, pPermutation, pRightSide, pDerivative);
+        // Lengths of rods
+        for (int iRod = 0; iRod != numRods; ++iRod)
+            sensitivity[iRod][jParameter] = gsl_vector_get(pDerivative, 3 * iRod + 2);
+        // Projected force
+        double dForce = 0.0;
+        for (int k = 0; k != 3; ++k)
+            dForce += dForceState[k] * gsl_vector_get(pDerivative, k);
+        if (jParameter == iStiffness)
+            dForce += dForceStiffness;
+        sensitivity[numRods][jParameter] = dForce;
+    }
+
+    // Free the working objects
+    gsl_vector_free(pDerivative);
+    gsl_vector_free(pRightSide);
+    gsl_vector_free(pBackwardFun);
+    gsl_vector_free(pForwardFun);
+    gsl_permutation_free(pPermutation);
+    gsl_matrix_free(pJacobian);
+    gsl_vector_free(pFun);
+    gsl_vector_free(pState);
+    return sensitivity;
+}
+
+/*!
+ * \brief Specify the initial values of parameters to be optimized
+ *
+ * If there is no appropriate solution, the parabolic or constant approximation is used.
+ * Otherwise, the state of a rod is taken from the cached rod with the same index.
+ * When the number of rods differs, the cached rod with the closest distance is selected instead.
+ * The cached state is copied as it is, if the rod has not been changed.
+ * Otherwise, the cached state is scaled by the ratio of the parabolic approximations for the current and cached parameters,
+ * so that changes of the distance, force and cable are accounted for, while the coupling of rods is kept.
+ * If the parabolic approximation does not exist or the constant guess is chosen, the state is scaled by the ratio of distances.
+ */
+void RodSystem::setApproximation(gsl_vector* pState, CachedSpans const* pCached) const
+{
+    const double kApproxU0        = -1e-3;
+    const double kApproxUL        = 1e-3;
+    const double kApproxDeltaSpan = 1;
+
+    int numRods = mParameters.numRods;
+    bool isParabolic = mInitialGuess == kParabolicGuess;
+    double u0Parabolic, uLParabolic, LParabolic, u0CachedParabolic, uLCachedParabolic, LCachedParabolic;
+    bool isSameLoading = pCached && pCached->nameCable == mCable.name && pCached->parameters.force == mParameters.force;
+    int iLast = 0;
+    double u0, uL, L;
+    for (int iRod = 0; iRod != numRods; ++iRod)
+    {
+        double distance = mParameters.distances[iRod];
+        if (pCached)
+        {
+            std::vector<double> const& cachedDistances = pCached->parameters.distances;
+            int iCached = iRod;
+            if (pCached->parameters.numRods != numRods)
+            {
+                auto iterClosest = std::min_element(cachedDistances.begin(), cachedDistances.end(),
+                                                    [distance](double first, double second) { return std::abs(first - distance) < std::abs(second - distance); });
+                iCached = iterClosest - cachedDistances.begin();
+            }
+            double ratio = cachedDistances[iCached] > 0.0 ? distance / cachedDistances[iCached] : 1.0;
+            u0 = pCached->spans.u0[iCached];
+            uL = pCached->spans.uL[iCached];
+            L  = pCached->spans.L[iCached];
+            if (!isSameLoading || ratio != 1.0)
+            {
+                if (isParabolic && approximateParabolic(distance, &mParameters, u0Parabolic, uLParabolic, LParabolic)
+                    && approximateParabolic(cachedDistances[iCached], &pCached->parameters, u0CachedParabolic, uLCachedParabolic, LCachedParabolic))
+                {
+                    u0 *= u0Parabolic / u0CachedParabolic;
+                    uL *= uLParabolic / uLCachedParabolic;
+                    L  *= LParabolic / LCachedParabolic;
+                }
+                else
+                {
+                    u0 *= ratio;
+                    uL *= ratio;
+                    L  *= ratio;
+                }
+            }
+        }
+        else if (!isParabolic || !approximateParabolic(distance, &mParameters, u0, uL, L))
+        {
+            u0 = kApproxU0;
+            uL = kApproxUL;
+            L  = distance + kApproxDeltaSpan;
+        }
+        gsl_vector_set(pState, iLast, u0);
+        gsl_vector_set(pState, iLast + 1, uL);
+        gsl_vector_set(pState, iLast + 2, L);
+        iLast += 3;
+    }
+}
+
+//! Combine hashes of all parameters which affect the solution
+std::size_t RodSystem::hash() const
+{
+    std::size_t result = 0;
+    auto combine = [&result](std::size_t value) { result ^= value + 0x9e3779b9 + (result << 6) + (result >> 2); };
+    std::hash<double> hashDouble;
+    for (double const& distance : mParameters.distances)
+        combine(hashDouble(distance));
+    combine(hashDouble(mParameters.force));
+    combine(hashDouble(mParameters.massPerLength));
+    combine(hashDouble(mParameters.youngsModulus));
+    combine(hashDouble(mParameters.area));
+    combine(std::hash<std::string>()(mCable.name));
+    return result;
+}
+
+//! Check if the cached solution was obtained for the current parameters
+bool RodSystem::isSame(CachedSpans const& cached, std::size_t hash) const
+{
+    RodSystemParameters const& parameters = cached.parameters;
+    return cached.hash == hash
+           && cached.nameCable == mCable.name
+           && parameters.distances == mParameters.distances
+           && parameters.force == mParameters.force
+           && parameters.massPerLength == mParameters.massPerLength
+           && parameters.youngsModulus == mParameters.youngsModulus
+           && parameters.area == mParameters.area;
+}
+
+/*!
+ * \brief Find the cached solution which is the closest to the current parameters
+ *
+ * The measure is the sum of squared relative differences of the force, cable properties and distances.
+ * Solutions with a different number of rods are only taken if nothing else is cached.
+ */
+CachedSpans const* RodSystem::findClosest() const
+{
+    auto relativeDifference = [](double first, double second)
+    {
+        double scale = std::max(std::abs(first), std::abs(second));
+        return scale > 0.0 ? std::pow((first - second) / scale, 2.0) : 0.0;
+    };
+    CachedSpans const* pClosest = nullptr;
+    double minMeasure = std::numeric_limits<double>::max();
+    bool isClosestSameSize = false;
+    for (CachedSpans const& cached : mCache)
+    {
+        RodSystemParameters const& parameters = cached.parameters;
+        bool isSameSize = parameters.numRods == mParameters.numRods;
+        if (isClosestSameSize && !isSameSize)
+            continue;
+        double measure = relativeDifference(parameters.force, mParameters.force)
+                         + relativeDifference(parameters.massPerLength, mParameters.massPerLength)
+                         + relativeDifference(parameters.youngsModulus * parameters.area, mParameters.youngsModulus * mParameters.area);
+        if (isSameSize)
+        {
+            for (int iRod = 0; iRod != mParameters.numRods; ++iRod)
+                measure += relativeDifference(parameters.distances[iRod], mParameters.distances[iRod]);
+        }
+        if ((isSameSize && !isClosestSameSize) || measure < minMeasure)
+        {
+            pClosest = &cached;
+            minMeasure = measure;
+            isClosestSameSize = isSameSize;
+        }
+    }
+    return pClosest;
+}
+
 //! Specify distances between supports
 void RodSystem::setDistances(std::vector<double> const& distances)
 {
@@ -213,7 +577,7 @@ void RodSystem::setDistances(std::vector<double> const& distances)
 //! Modify the cable used in the rod system
 void RodSystem::setCable(Cable const& cable)
 {
-    mNameCable                = cable.name;
+    mCable                    = cable;
     mParameters.massPerLength = cable.massPerLength;
     mParameters.youngsModulus = cable.youngsModulus;
     mParameters.area          = cable.area;
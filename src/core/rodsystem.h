@@ -10,13 +10,14 @@
 
 #include <QString>
 #include <vector>
+#include <deque>
 #include <gsl/gsl_vector.h>
+#include "array.h"
+#include "databasecables.h"
 
 namespace RSE::Core
 {
 
-struct Cable;
-
 //! Computed parameters of spans
 struct Spans
 {
@@ -29,7 +30,11 @@ struct Spans
     //! Length of a rod, m
     std::vector<double> L;
     //! Projected stretching force, N
-    double projectedForce;
+    double projectedForce = 0.0;
+    //! Number of iterations performed by the solver
+    int numIterations = 0;
+    //! Flag which indicates whether the residual tolerance was reached
+    bool isConverged = false;
 };
 
 //! Parameters of a rod system
@@ -49,26 +54,61 @@ struct RodSystemParameters
     int numRods = 0;
 };
 
+//! Converged solution stored to be reused
+struct CachedSpans
+{
+    //! Hash of parameters
+    std::size_t hash;
+    //! Parameters the solution was obtained for
+    RodSystemParameters parameters;
+    //! Name of a cable
+    std::string nameCable;
+    //! Computed parameters of spans
+    Spans spans;
+};
+
 class RodSystem
 {
 public:
+    //! Approaches to construct the initial state of rods
+    enum InitialGuess
+    {
+        kConstantGuess,
+        kParabolicGuess
+    };
     RodSystem(std::vector<double> distances, Cable const& cable, double force);
     // Get parameters of a system
     std::vector<double> const& distances() const { return mParameters.distances; }
-    std::string const& nameCable() const { return mNameCable; }
+    std::string const& nameCable() const { return mCable.name; }
+    Cable const& cable() const { return mCable; }
     double force() const { return mParameters.force; }
     int numRods() const { return mParameters.numRods; }
     double massPerLength() const { return mParameters.massPerLength; }
+    InitialGuess initialGuess() const { return mInitialGuess; }
     // Set parameters of a system
     void setDistances(std::vector<double> const& distances);
     void setCable(Cable const& cable);
     void setForce(double force) { mParameters.force = force; };
+    void setInitialGuess(InitialGuess initialGuess) { mInitialGuess = initialGuess; }
     // Compute parameters of spans
     Spans computeSpans();
+    Spans computeSpans(Spans const& approximation);
+    Array<double> computeSensitivity(Spans const& spans);
+    void clearCache() { mCache.clear(); }
+
+private:
+    std::size_t hash() const;
+    bool isSame(CachedSpans const& cached, std::size_t hash) const;
+    CachedSpans const* findClosest() const;
+    void setApproximation(gsl_vector* pState, CachedSpans const* pCached) const;
+    Spans solveSpans(gsl_vector const* pState);
 
 private:
     RodSystemParameters mParameters;
-    std::string mNameCable;
+    Cable mCable;
+    InitialGuess mInitialGuess = kParabolicGuess;
+    //! Recently converged solutions, the latest one goes first
+    std::deque<CachedSpans> mCache;
 };
 
 }
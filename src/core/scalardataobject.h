@@ -20,12 +20,10 @@ public:
     ScalarDataObject(QString const& name);
     ~ScalarDataObject();
     AbstractDataObject* clone() const override;
-    DataItemType& addItem(DataValueType key) override;
     static quint32 numberInstances() { return smNumInstances; }
-    void import(QTextStream& stream) override;
 
 private:
-    static quint32 smNumInstances;
+    static std::atomic<quint32> smNumInstances;
 };
 
 }
@@ -7,18 +7,27 @@
 
 #include <QFileInfo>
 #include <QDir>
+#include <QDirIterator>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <algorithm>
 #include "solutionoptions.h"
 #include "solutionmanager.h"
+#include "resultcache.h"
 
 using namespace RSE::Core;
 using namespace RSE::Solution;
 
-static QString const skNameRodSystemSolver       = "KLPALGSYSx64.exe";
 static QString const skNameOptimizationSolver    = "OptimalDamping.exe";
 static QString const skNameExporter              = "KLPExport.exe";
 static QString const skNameVisualizer            = "VisualizationX64.exe";
-static QString const skFileNameStatus            = "Status.txt";
 static QString const skFileNameOptimizationInput = "dampinput.txt";
+static QString const skFileNameRodSystemMetrics  = "RodSystemMetrics.csv";
+static QString const skFileNameOptimizerMetrics   = "OptimizationMetrics.csv";
+//! Default limits of durations of stages, s
+static int const skTimeoutRunning                = 4 * 3600;
+static int const skTimeoutExporting              = 600;
+static int const skTimeoutOptimizing             = 4 * 3600;
 
 SolutionManager::SolutionManager(QString const& rootPath, QString const& relativeInputPath, QString const& relativeOutputPath)
 {
@@ -28,122 +37,384 @@ SolutionManager::SolutionManager(QString const& rootPath, QString const& relativ
         mRootPath.append(separator);
     mInputPath  = mRootPath + relativeInputPath;
     mOutputPath = mRootPath + relativeOutputPath;
+    mpStatusWatcher = new QFileSystemWatcher(this);
+    connect(mpStatusWatcher, &QFileSystemWatcher::directoryChanged, this, &SolutionManager::processStatusChange);
+    connect(mpStatusWatcher, &QFileSystemWatcher::fileChanged, this, &SolutionManager::processStatusChange);
+    // Limit durations of stages
+    mTimeouts.fill(0);
+    mTimeouts[kRunning]    = skTimeoutRunning;
+    mTimeouts[kExporting]  = skTimeoutExporting;
+    mTimeouts[kOptimizing] = skTimeoutOptimizing;
+    mpStageTimer = new QTimer(this);
+    mpStageTimer->setSingleShot(true);
+    connect(mpStageTimer, &QTimer::timeout, this, &SolutionManager::processTimeout);
 }
 
 SolutionManager::~SolutionManager()
 {
     delete mpRodSystemSolver;
     delete mpOptimizationSolver;
+    delete mpExporter;
 }
 
 //! Stop the solution process
 void SolutionManager::stopSolution()
 {
-    // Interrupt the solution of a rod system
-    if (mpRodSystemSolver)
+    if (isActive())
+        setState(kFailed, "Interrupted by the user");
+    terminateProcesses();
+}
+
+//! Interrupt all the processes without reporting their termination
+void SolutionManager::terminateProcesses()
+{
+    mpStageTimer->stop();
+    unwatchStatus();
+    // Files may be overwritten while they are copied, so the results being stored are discarded
+    if (!mStoringKey.isEmpty())
     {
-        mpRodSystemSolver->close();
-        delete mpRodSystemSolver;
-        mpRodSystemSolver = nullptr;
+        mDiscardedKeys.insert(mStoringKey);
+        mStoringKey.clear();
     }
-    // Interrupt the optimizer
-    if (mpOptimizationSolver)
+    for (QProcess** ppProcess : {&mpRodSystemSolver, &mpExporter, &mpOptimizationSolver})
     {
-        mpOptimizationSolver->close();
-        delete mpOptimizationSolver;
-        mpOptimizationSolver = nullptr;
+        if (!*ppProcess)
+            continue;
+        (*ppProcess)->disconnect(this);
+        (*ppProcess)->close();
+        delete *ppProcess;
+        *ppProcess = nullptr;
     }
 }
 
-//! Solve a rod system
-void SolutionManager::solveRodSystem(Project& project, SolutionOptions const& options)
+//! Interrupt the stage which lasts longer than its timeout
+void SolutionManager::processTimeout()
 {
-    if (mpRodSystemSolver)
+    if (!isActive())
+        return;
+    State state = mState;
+    setState(kFailed, QString("%1 has not finished in %2 s").arg(stateName(state)).arg(mTimeouts[state]));
+    terminateProcesses();
+}
+
+//! Name of a state of the solution process
+QString SolutionManager::stateName(State state)
+{
+    switch (state)
     {
-        mpRodSystemSolver->close();
-        delete mpRodSystemSolver;
+    case kIdle:
+        return "Idle";
+    case kQueued:
+        return "Queued";
+    case kPreprocessing:
+        return "Preprocessing";
+    case kRunning:
+        return "Running";
+    case kExporting:
+        return "Exporting";
+    case kOptimizing:
+        return "Optimizing";
+    case kCaching:
+        return "Caching";
+    case kDone:
+        return "Done";
+    case kFailed:
+        return "Failed";
     }
+    return QString();
+}
+
+/*!
+ * \brief Switch the solution process to a new state
+ *
+ * The transition is time stamped and reported along with the time elapsed since the process was queued.
+ * The timeout of an active stage is started, while durations of all the stages are reported once the process is finished
+ */
+void SolutionManager::setState(State state, QString const& message)
+{
+    QDateTime time = QDateTime::currentDateTime();
+    if (state == kQueued)
+    {
+        mTransitions.clear();
+        mClock.start();
+    }
+    qint64 elapsed = mClock.isValid() ? mClock.elapsed() : 0;
+    mTransitions.push_back({state, time, elapsed, message});
+    mState = state;
+    // Limit the duration of the stage
+    mpStageTimer->stop();
+    if (isActive() && mTimeouts[state] > 0)
+        mpStageTimer->start(mTimeouts[state] * 1000);
+    // Report the transition
+    QString text = QString("[%1] %2").arg(time.toString("hh:mm:ss.zzz"), stateName(state));
+    if (mTransitions.size() > 1)
+        text += QString(" (+%1 s)").arg(elapsed / 1000.0, 0, 'f', 3);
+    if (!message.isEmpty())
+        text += ": " + message;
+    if (state == kDone || state == kFailed)
+    {
+        QStringList durations;
+        for (auto const& [stage, duration] : stageDurations())
+            durations.push_back(QString("%1 %2 s").arg(stateName(stage)).arg(duration / 1000.0, 0, 'f', 3));
+        text += QString("\nStages: %1").arg(durations.join(", "));
+    }
+    emit outputSent((text + '\n').toUtf8());
+    emit stateChanged(state);
+}
+
+//! Wall-clock durations of the stages passed since the process was queued, ms
+std::vector<std::pair<SolutionManager::State, qint64>> SolutionManager::stageDurations() const
+{
+    std::vector<std::pair<State, qint64>> result;
+    for (std::size_t i = 1; i < mTransitions.size(); ++i)
+        result.push_back({mTransitions[i - 1].state, mTransitions[i].elapsed - mTransitions[i - 1].elapsed});
+    return result;
+}
+
+//! Solve a rod system
+void SolutionManager::solveRodSystem(Project& project, SolutionOptions const& options)
+{
+    terminateProcesses();
+    setState(kQueued);
     // Configure the process
-    QString program = mRootPath + skNameRodSystemSolver;
     mpRodSystemSolver = new QProcess();
-    mpRodSystemSolver->setProgram(program);
+    mLauncher.setup(mpRodSystemSolver, mRootPath + SolverLauncher::skNameRodSystemSolver);
     mpRodSystemSolver->setProcessChannelMode(QProcess::MergedChannels);
     mpRodSystemSolver->setWorkingDirectory(mRootPath);
     // Specify signals & slots
     connect(mpRodSystemSolver, &QProcess::readyRead, this, &SolutionManager::processRodSystemStream);
+    connect(mpRodSystemSolver, &QProcess::finished, this, &SolutionManager::processRodSystemFinished);
+    connect(mpRodSystemSolver, &QProcess::errorOccurred, this, &SolutionManager::processError);
     // Write the input data
-    project.writeCalcData(mInputPath, options);
+    setState(kPreprocessing);
+    CalcDataReport report = project.writeCalcData(mInputPath, options);
+    emit outputSent((report.toString() + '\n').toUtf8());
+    if (!report.failedFiles.isEmpty())
+    {
+        setState(kFailed, "Could not write the input data");
+        return;
+    }
+    // Restore the results of the same input data solved previously
+    mIsOptimization = false;
+    mRodSystemKey.clear();
+    if (restoreResults(rodSystemKey()))
+        return;
+    prepareResults();
+    runRodSystemSolver();
+}
+
+//! Run the rod system solver once its input data are written
+void SolutionManager::runRodSystemSolver()
+{
+    // Remove the status of the previous solution and wait for the new one to be written
+    QFile::remove(mRootPath + SolverLauncher::skFileNameStatus);
+    watchStatus();
     // Run the solver
-#ifdef Q_OS_WINDOWS
+    mTelemetry.start();
+    setState(kRunning);
     mpRodSystemSolver->start();
-#elif defined(Q_OS_LINUX)
-    mpRodSystemSolver->startDetached("wine", {program}, mRootPath);
-#endif
 }
 
-//! Check if the solution process if finished
-int SolutionManager::getRodSystemStatus()
+//! Watch the directory where the status file appears, the file itself, if it exists, and the directory of results
+void SolutionManager::watchStatus()
 {
-    int status = -1;
-    QFile file(mRootPath + skFileNameStatus);
-    if (!file.open(QIODeviceBase::ReadOnly))
-        return status;
-    QTextStream stream(&file);
-    stream >> status;
-    return status;
+    mpStatusWatcher->addPath(mRootPath);
+    QString pathFile = mRootPath + SolverLauncher::skFileNameStatus;
+    if (QFileInfo::exists(pathFile))
+        mpStatusWatcher->addPath(pathFile);
+    mResultFiles.clear();
+    if (QFileInfo::exists(mOutputPath))
+    {
+        for (QString const& fileName : QDir(mOutputPath).entryList(QDir::Files))
+            mResultFiles.insert(fileName);
+        mpStatusWatcher->addPath(mOutputPath);
+    }
 }
 
-//! Process the output of the rod system solver
-void SolutionManager::processRodSystemStream()
+//! Stop watching the status of the solution
+void SolutionManager::unwatchStatus()
+{
+    QStringList paths = mpStatusWatcher->files() + mpStatusWatcher->directories();
+    if (!paths.isEmpty())
+        mpStatusWatcher->removePaths(paths);
+}
+
+/*!
+ * \brief Check the status file once it is created or modified
+ *
+ * A file which is replaced rather than modified is not watched anymore, so it is added again on the directory notification
+ */
+void SolutionManager::processStatusChange()
+{
+    if (mState != kRunning)
+        return;
+    QString pathFile = mRootPath + SolverLauncher::skFileNameStatus;
+    if (!mpStatusWatcher->files().contains(pathFile) && QFileInfo::exists(pathFile))
+        mpStatusWatcher->addPath(pathFile);
+    reportResultFiles();
+    if (SolverLauncher::readRodSystemStatus(mRootPath) >= 0)
+        completeRodSystem();
+}
+
+//! Report the result files which have appeared in the output directory since the solution was started
+void SolutionManager::reportResultFiles()
 {
-    emit outputSent(mpRodSystemSolver->readAll());
-    if (mpRodSystemSolver->state() == QProcess::Running && getRodSystemStatus() >= 0)
+    if (mState != kRunning)
+        return;
+    for (QString const& fileName : QDir(mOutputPath).entryList(QDir::Files, QDir::Time | QDir::Reversed))
     {
-        emit rodSystemSolved();
+        if (mResultFiles.insert(fileName).second)
+            emit outputSent(QString("The result file %1 has been written\n").arg(fileName).toUtf8());
+    }
+}
+
+/*!
+ * \brief Finish the solution of a rod system which has written its status
+ *
+ * Nonzero status means that the solver has failed, so neither the results are stored nor the solution is reported.
+ * Otherwise, the solution is reported once its results are stored
+ */
+void SolutionManager::completeRodSystem()
+{
+    reportResultFiles();
+    unwatchStatus();
+    processTelemetry(mTelemetry.finish());
+    if (mpRodSystemSolver && mpRodSystemSolver->state() == QProcess::Running)
         mpRodSystemSolver->kill();
+    int status = SolverLauncher::readRodSystemStatus(mRootPath);
+    if (status != 0)
+    {
+        setState(kFailed, QString("The solver finished with status %1").arg(status));
+        return;
     }
+    mRodSystemKey = mCacheKey;
+    saveTelemetry(skFileNameRodSystemMetrics);
+    if (!storeResults())
+        finishSolution();
+}
+
+//! Process the termination of the rod system solver before it has written its status
+void SolutionManager::processRodSystemFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    if (mState != kRunning)
+        return;
+    if (SolverLauncher::readRodSystemStatus(mRootPath) >= 0)
+    {
+        completeRodSystem();
+        return;
+    }
+    unwatchStatus();
+    if (exitStatus == QProcess::CrashExit)
+        setState(kFailed, "The solver crashed");
+    else
+        setState(kFailed, QString("The solver exited with code %1 without writing the status").arg(exitCode));
+}
+
+//! Fail the solution if a solver could not be started or crashed
+void SolutionManager::processError(QProcess::ProcessError error)
+{
+    if (error != QProcess::FailedToStart || !isActive())
+        return;
+    QProcess* pProcess = qobject_cast<QProcess*>(sender());
+    unwatchStatus();
+    setState(kFailed, pProcess ? pProcess->errorString() : QString("Could not start the solver"));
+}
+
+//! Process the output of the rod system solver
+void SolutionManager::processRodSystemStream()
+{
+    QByteArray data = mpRodSystemSolver->readAll();
+    std::vector<TelemetrySample> samples = mTelemetry.parse(data);
+    emit outputSent(std::move(data));
+    processTelemetry(samples);
 }
 
 //! Optimize viscosities of dampers as to damp selected set of modes
 void SolutionManager::solveOptimization(Project& project, SolutionOptions const& options)
 {
-    if (mpOptimizationSolver)
+    terminateProcesses();
+    setState(kQueued);
+    // Prepare the input data for optimization
+    setState(kPreprocessing);
+    int numDampers = project.rodSystem().numRods() - 1;
+    writeOptimizationInput(mOutputPath + skFileNameOptimizationInput, numDampers, options);
+    int stepModes = options.stepModes();
+    mNumExpectedModeSteps = stepModes > 0 ? (options.numDampModes() + stepModes - 1) / stepModes : -1;
+    mIsOptimization = true;
+    if (restoreResults(optimizationKey()))
+        return;
+    prepareResults();
+    // The optimizer is run once the export is finished
+    runExporter();
+}
+
+//! Export mode shapes and DOFs for the optimizer
+void SolutionManager::runExporter()
+{
+    mpExporter = new QProcess();
+    mpExporter->setWorkingDirectory(mOutputPath);
+    mLauncher.setup(mpExporter, mOutputPath + skNameExporter);
+    connect(mpExporter, &QProcess::finished, this, &SolutionManager::processExportFinished);
+    connect(mpExporter, &QProcess::errorOccurred, this, &SolutionManager::processError);
+    setState(kExporting);
+    mpExporter->start();
+}
+
+//! Proceed to the optimization once the export is finished
+void SolutionManager::processExportFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    if (mState != kExporting)
+        return;
+    mpExporter->deleteLater();
+    mpExporter = nullptr;
+    if (exitStatus == QProcess::CrashExit)
+    {
+        setState(kFailed, "The exporter crashed");
+        return;
+    }
+    if (exitCode != 0)
     {
-        mpOptimizationSolver->close();
-        delete mpOptimizationSolver;
+        setState(kFailed, QString("The exporter exited with code %1").arg(exitCode));
+        return;
     }
-    // Configure the optimization process
-    QString program = mOutputPath + skNameOptimizationSolver;
+    runOptimizer();
+}
+
+//! Run the optimizer of viscosities
+void SolutionManager::runOptimizer()
+{
     mpOptimizationSolver = new QProcess();
     mpOptimizationSolver->setProcessChannelMode(QProcess::MergedChannels);
     mpOptimizationSolver->setWorkingDirectory(mOutputPath);
-#ifdef Q_OS_WINDOWS
-    mpOptimizationSolver->setProgram(program);
-#elif defined(Q_OS_LINUX)
-    mpOptimizationSolver->setProgram("wine");
-    mpOptimizationSolver->setArguments({program});
-#endif
+    mLauncher.setup(mpOptimizationSolver, mOutputPath + skNameOptimizationSolver);
     // Set signals & slots
     connect(mpOptimizationSolver, &QProcess::readyRead, this, &SolutionManager::processOptimizationStream);
-    // Prepare the input data for optimization
-    int numDampers = project.rodSystem().numRods() - 1;
-    writeOptimizationInput(mOutputPath + skFileNameOptimizationInput, numDampers, options);
-    runParserProcess();
-    // Run the optimizer
+    connect(mpOptimizationSolver, &QProcess::finished, this, &SolutionManager::processOptimizationFinished);
+    connect(mpOptimizationSolver, &QProcess::errorOccurred, this, &SolutionManager::processError);
+    mTelemetry.start(mNumExpectedModeSteps);
+    setState(kOptimizing);
     mpOptimizationSolver->start();
 }
 
-//! Process the optimization output
+/*!
+ * \brief Process the optimization output
+ *
+ * The steps and completion are detected by the lines parsed, so that labels split between chunks of the output are not missed
+ */
 void SolutionManager::processOptimizationStream()
 {
-    QString const newStepLabel = "Mode optimization step";
-    QString const finishedLabel = "Optimization finished";
     QByteArray message = mpOptimizationSolver->readAll();
+    std::vector<TelemetrySample> samples = mTelemetry.parse(message);
     // Check the solution state
-    bool isNewStep = QString(message).contains(newStepLabel, Qt::CaseInsensitive);
-    bool isFinished = QString(message).contains(finishedLabel, Qt::CaseInsensitive);
+    auto hasEvent = [&samples](TelemetrySample::Event event)
+    {
+        return std::any_of(samples.begin(), samples.end(), [event](TelemetrySample const& sample) { return sample.event == event; });
+    };
+    bool isNewStep = hasEvent(TelemetrySample::kModeStep);
+    bool isFinished = hasEvent(TelemetrySample::kFinished);
     // Send the current state
     emit outputSent(std::move(message));
+    processTelemetry(samples);
     // Send the signals
     if (mpOptimizationSolver->state() == QProcess::Running)
     {
@@ -151,30 +422,209 @@ void SolutionManager::processOptimizationStream()
             emit optimizationStepPerformed();
         if (isFinished)
         {
-            emit optimizationSolved();
+            saveTelemetry(skFileNameOptimizerMetrics);
+            if (!storeResults())
+                finishSolution();
             mpOptimizationSolver->kill();
         }
     }
 }
 
-//! Prepare data for the optimization process
-void SolutionManager::runParserProcess()
+//! Process the termination of the optimizer before it has reported the completion
+void SolutionManager::processOptimizationFinished(int exitCode, QProcess::ExitStatus exitStatus)
 {
-    // Configure the process
-    QString program = mOutputPath + skNameExporter;
-    QProcess* pProcess = new QProcess();
-    pProcess->setWorkingDirectory(mOutputPath);
-#ifdef Q_OS_WINDOWS
-    pProcess->setProgram(program);
-#elif defined(Q_OS_LINUX)
-    pProcess->setProgram("wine");
-    pProcess->setArguments({program});
-#endif
-    // Export modeshapes and DOFs
-    pProcess->start();
-    while (pProcess->waitForFinished()) { }
-    pProcess->close();
-    delete pProcess;
+    if (mState != kOptimizing)
+        return;
+    processTelemetry(mTelemetry.finish());
+    if (exitStatus == QProcess::NormalExit && exitCode == 0)
+    {
+        saveTelemetry(skFileNameOptimizerMetrics);
+        if (!storeResults())
+            finishSolution();
+        return;
+    }
+    setState(kFailed, QString("The optimizer exited with code %1").arg(exitCode));
+}
+
+/*!
+ * \brief Hash the input data of the rod system solver
+ *
+ * All the files of the input directory are taken into account along with the version of the solver
+ * \return Key of the results or an empty array, if the results are not cached
+ */
+QByteArray SolutionManager::rodSystemKey() const
+{
+    if (!mpResultCache)
+        return QByteArray();
+    QDir input(mInputPath);
+    QStringList relativePathFiles;
+    QDirIterator iter(mInputPath, QDir::Files, QDirIterator::Subdirectories);
+    while (iter.hasNext())
+        relativePathFiles.push_back(input.relativeFilePath(iter.next()));
+    relativePathFiles.sort();
+    return ResultCache::computeKey(mInputPath, relativePathFiles,
+                                   ResultCache::fileStamp(mRootPath + SolverLauncher::skNameRodSystemSolver));
+}
+
+/*!
+ * \brief Hash the input data of the optimizer
+ *
+ * The optimization depends on the results of the rod system solver, so it is cached only when their key is known
+ */
+QByteArray SolutionManager::optimizationKey() const
+{
+    if (!mpResultCache || mRodSystemKey.isEmpty())
+        return QByteArray();
+    QByteArray salt = mRodSystemKey + ResultCache::fileStamp(mOutputPath + skNameExporter)
+                      + ResultCache::fileStamp(mOutputPath + skNameOptimizationSolver);
+    return ResultCache::computeKey(mOutputPath, {skFileNameOptimizationInput}, salt);
+}
+
+//! Set the cache of results and receive the completion of its operations
+void SolutionManager::setResultCache(std::shared_ptr<ResultCache> pResultCache)
+{
+    if (mpResultCache)
+        mpResultCache->disconnect(this);
+    mpResultCache = std::move(pResultCache);
+    if (!mpResultCache)
+        return;
+    connect(mpResultCache.get(), &ResultCache::restored, this, &SolutionManager::processResultsRestored);
+    connect(mpResultCache.get(), &ResultCache::inserted, this, &SolutionManager::processResultsStored);
+}
+
+/*!
+ * \brief Start restoring the results from the cache instead of running the solvers
+ * \return Whether the results are being restored
+ */
+bool SolutionManager::restoreResults(QByteArray const& key)
+{
+    mCacheKey = key;
+    if (!mpResultCache || key.isEmpty() || !mpResultCache->restore(key, mRootPath))
+        return false;
+    setState(kCaching, "Restoring the results from the cache");
+    return true;
+}
+
+//! Remember the state of files before the solution, so that the results can be stored once it is done
+void SolutionManager::prepareResults()
+{
+    mFileStamps.clear();
+    if (!mCacheKey.isEmpty())
+        mFileStamps = stampFiles();
+}
+
+/*!
+ * \brief Start storing the files created or modified during the solution
+ * \return Whether the files are being stored
+ */
+bool SolutionManager::storeResults()
+{
+    if (!mpResultCache || mCacheKey.isEmpty())
+        return false;
+    QStringList relativePathFiles;
+    for (auto const& [relativePathFile, stamp] : stampFiles())
+    {
+        auto iter = mFileStamps.find(relativePathFile);
+        if (iter == mFileStamps.end() || iter->second != stamp)
+            relativePathFiles.push_back(relativePathFile);
+    }
+    QByteArray key = mCacheKey;
+    mCacheKey.clear();
+    mFileStamps.clear();
+    if (!mpResultCache->insert(key, mRootPath, relativePathFiles))
+        return false;
+    mStoringKey = key;
+    setState(kCaching, QString("Storing %1 files in the cache").arg(relativePathFiles.size()));
+    return true;
+}
+
+//! Finish the solution restored from the cache or run the solvers, if the results could not be restored
+void SolutionManager::processResultsRestored(QByteArray const& key, bool isOk)
+{
+    if (mState != kCaching || key != mCacheKey)
+        return;
+    if (isOk)
+    {
+        mCacheKey.clear();
+        if (!mIsOptimization)
+            mRodSystemKey = key;
+        finishSolution("Restored from the cache");
+        return;
+    }
+    emit outputSent("The results could not be restored from the cache\n");
+    prepareResults();
+    if (mIsOptimization)
+        runExporter();
+    else
+        runRodSystemSolver();
+}
+
+//! Finish the solution once its results are stored
+void SolutionManager::processResultsStored(QByteArray const& key, bool isOk)
+{
+    if (mDiscardedKeys.erase(key))
+    {
+        if (isOk)
+            mpResultCache->remove(key);
+        return;
+    }
+    if (mState != kCaching || key != mStoringKey)
+        return;
+    mStoringKey.clear();
+    if (!isOk)
+        emit outputSent("The results could not be stored in the cache\n");
+    finishSolution();
+}
+
+//! Report the solution which has been completed
+void SolutionManager::finishSolution(QString const& message)
+{
+    setState(kDone, message);
+    if (mIsOptimization)
+        emit optimizationSolved();
+    else
+        emit rodSystemSolved();
+}
+
+//! Stamp the files which solvers may produce: the ones of the root directory and the output directory with its subdirectories
+std::map<QString, QByteArray> SolutionManager::stampFiles() const
+{
+    std::map<QString, QByteArray> result;
+    QDir root(mRootPath);
+    for (QFileInfo const& info : root.entryInfoList(QDir::Files))
+        result[info.fileName()] = ResultCache::fileStamp(info.absoluteFilePath());
+    QDirIterator iter(mOutputPath, QDir::Files, QDirIterator::Subdirectories);
+    while (iter.hasNext())
+    {
+        QString pathFile = iter.next();
+        result[root.relativeFilePath(pathFile)] = ResultCache::fileStamp(pathFile);
+    }
+    return result;
+}
+
+//! Report the samples parsed from the output of a solver along with its progress
+void SolutionManager::processTelemetry(std::vector<TelemetrySample> const& samples)
+{
+    if (samples.empty())
+        return;
+    for (TelemetrySample const& sample : samples)
+        emit telemetryReceived(sample);
+    double progress = mTelemetry.progress();
+    if (progress >= 0.0)
+        emit progressChanged(progress, mTelemetry.remainingTime());
+}
+
+//! Write the samples parsed into the output directory, so that they are cached along with the results
+void SolutionManager::saveTelemetry(QString const& fileName)
+{
+    QString pathFile = mOutputPath + fileName;
+    if (mTelemetry.samples().empty())
+    {
+        QFile::remove(pathFile);
+        return;
+    }
+    if (!mTelemetry.write(pathFile))
+        emit outputSent(QString("Could not write the solver metrics to %1\n").arg(pathFile).toUtf8());
 }
 
 //! Write the input data for optimization of viscosities
@@ -197,10 +647,8 @@ void SolutionManager::writeOptimizationInput(QString const& pathFile, int numDam
 //! Run the visualizer of a rod system
 void SolutionManager::runVisualizer()
 {
-    QString program = mOutputPath + skNameVisualizer;
-#ifdef Q_OS_WINDOWS
-    QProcess::startDetached(program, {}, mOutputPath);
-#elif defined(Q_OS_LINUX)
-    QProcess::startDetached("wine", {program}, mOutputPath);
-#endif
+    QProcess process;
+    mLauncher.setup(&process, mOutputPath + skNameVisualizer);
+    process.setWorkingDirectory(mOutputPath);
+    process.startDetached();
 }
@@ -12,47 +12,172 @@
 #include <QProcess>
 #include <QObject>
 #include <QTextStream>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <array>
+#include <vector>
+#include <map>
+#include <memory>
+#include <set>
 #include "project.h"
+#include "solvertelemetry.h"
+#include "solverlauncher.h"
+
+class QFileSystemWatcher;
+class QTimer;
 
 namespace RSE::Solution
 {
 
 class SolutionOptions;
+class ResultCache;
 
-//! Class to control the solution process
+/*!
+ * \brief Class to control the solution process
+ *
+ * The process passes through a sequence of states, each transition is time stamped.
+ * Completion of the rod system solver is detected through notifications on its status file and the termination of the process,
+ * while the result files written by the solver are reported as they appear in the output directory.
+ * Solvers are run by the launcher, such as the compatibility layer, or natively, if the launcher is empty.
+ * The export and optimization are chained asynchronously, so that the caller is never blocked.
+ * Each active stage is interrupted, if it lasts longer than its timeout.
+ * If a result cache is set, the files produced by a solution are stored under the hash of its inputs,
+ * and they are restored instead of running the solvers once the same inputs are given again.
+ * The cache copies files in the background, so the solution is reported once the copying is completed.
+ * The output of the solvers is parsed line by line into telemetry samples, which are reported along with the progress,
+ * and saved next to the results
+ */
 class SolutionManager : public QObject
 {
     Q_OBJECT
 
 public:
+    //! States of the solution process
+    enum State
+    {
+        kIdle,
+        kQueued,
+        kPreprocessing,
+        kRunning,
+        kExporting,
+        kOptimizing,
+        kCaching,
+        kDone,
+        kFailed
+    };
+    Q_ENUM(State)
+
+    //! Transition of the solution process to a state
+    struct Transition
+    {
+        State state;
+        QDateTime time;
+        //! Time elapsed since the process was queued, ms
+        qint64 elapsed;
+        QString message;
+    };
+
     SolutionManager(QString const& rootPath, QString const& relativeInputPath, QString const& relativeOutputPath);
     ~SolutionManager();
     void solveRodSystem(Core::Project& project, SolutionOptions const& options);
     void solveOptimization(Core::Project& project, SolutionOptions const& options);
     void runVisualizer();
+    State state() const { return mState; }
+    bool isActive() const { return mState > kIdle && mState < kDone; }
+    std::vector<Transition> const& transitions() const { return mTransitions; }
+    std::vector<std::pair<State, qint64>> stageDurations() const;
+    int timeout(State state) const { return mTimeouts[state]; }
+    void setTimeout(State state, int seconds) { mTimeouts[state] = seconds; }
+    static QString stateName(State state);
+    std::shared_ptr<ResultCache> const& resultCache() const { return mpResultCache; }
+    void setResultCache(std::shared_ptr<ResultCache> pResultCache);
+    SolverTelemetry const& telemetry() const { return mTelemetry; }
+    SolverLauncher const& launcher() const { return mLauncher; }
+    void setLauncher(SolverLauncher const& launcher) { mLauncher = launcher; }
 
 signals:
     void outputSent(QByteArray);
+    void stateChanged(RSE::Solution::SolutionManager::State state);
     void rodSystemSolved();
     void optimizationSolved();
     void optimizationStepPerformed();
+    void telemetryReceived(RSE::Solution::TelemetrySample const& sample);
+    void progressChanged(double progress, qint64 remainingTime);
 
 public slots:
     void stopSolution();
 
 private:
+    void setState(State state, QString const& message = QString());
     void processRodSystemStream();
+    void processRodSystemFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void processStatusChange();
+    void reportResultFiles();
+    void completeRodSystem();
+    void runRodSystemSolver();
+    void runExporter();
+    void processExportFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void runOptimizer();
     void processOptimizationStream();
-    void runParserProcess();
+    void processOptimizationFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void processError(QProcess::ProcessError error);
+    void processTimeout();
+    void terminateProcesses();
     void writeOptimizationInput(QString const& pathFile, int numDampers, SolutionOptions const& options);
-    int getRodSystemStatus();
+    void watchStatus();
+    void unwatchStatus();
+    QByteArray rodSystemKey() const;
+    QByteArray optimizationKey() const;
+    bool restoreResults(QByteArray const& key);
+    void prepareResults();
+    bool storeResults();
+    void processResultsRestored(QByteArray const& key, bool isOk);
+    void processResultsStored(QByteArray const& key, bool isOk);
+    void finishSolution(QString const& message = QString());
+    std::map<QString, QByteArray> stampFiles() const;
+    void processTelemetry(std::vector<TelemetrySample> const& samples);
+    void saveTelemetry(QString const& fileName);
 
 private:
     QString mRootPath;
     QString mInputPath;
     QString mOutputPath;
+    SolverLauncher mLauncher;
     QProcess* mpRodSystemSolver = nullptr;
     QProcess* mpOptimizationSolver = nullptr;
+    QProcess* mpExporter = nullptr;
+    //! Watcher of the status file and result files written by the rod system solver
+    QFileSystemWatcher* mpStatusWatcher;
+    //! Result files which have already been reported or existed before the solution
+    std::set<QString> mResultFiles;
+    //! Current state of the solution process
+    State mState = kIdle;
+    //! Transitions made since the solution process was queued
+    std::vector<Transition> mTransitions;
+    //! Monotonic clock started when the solution process is queued
+    QElapsedTimer mClock;
+    //! Timer which interrupts the current stage
+    QTimer* mpStageTimer;
+    //! Limits of durations of stages, s. Zero means no limit
+    std::array<int, kFailed + 1> mTimeouts;
+    //! Cache of results shared with other clients
+    std::shared_ptr<ResultCache> mpResultCache;
+    //! Key of the results being computed or restored
+    QByteArray mCacheKey;
+    //! Key of the results being stored
+    QByteArray mStoringKey;
+    //! Keys of the results whose solutions have been interrupted while they were stored, so they may be inconsistent
+    std::set<QByteArray> mDiscardedKeys;
+    //! Whether the optimization is being solved rather than the rod system
+    bool mIsOptimization = false;
+    //! Key of the rod system whose results are located in the output directory
+    QByteArray mRodSystemKey;
+    //! Stamps of the files taken before the solution, so that the files produced are determined afterwards
+    std::map<QString, QByteArray> mFileStamps;
+    //! Parser of the output of the running solver
+    SolverTelemetry mTelemetry;
+    //! Number of mode steps which the optimizer is expected to perform
+    int mNumExpectedModeSteps = -1;
 };
 
 }
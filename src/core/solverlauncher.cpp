@@ -0,0 +1,54 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the SolverLauncher class
+ */
+
+#include <QFile>
+#include <QProcess>
+#include <QTextStream>
+#include "solverlauncher.h"
+
+using namespace RSE::Solution;
+
+const QString SolverLauncher::skNameRodSystemSolver = "KLPALGSYSx64.exe";
+const QString SolverLauncher::skFileNameStatus      = "Status.txt";
+
+//! Run the solvers by means of the compatibility layer on Linux and natively elsewhere
+SolverLauncher::SolverLauncher()
+{
+#ifdef Q_OS_LINUX
+    mProgram = "wine";
+#endif
+}
+
+//! Set a process to run the solver located at the specified path
+void SolverLauncher::setup(QProcess* pProcess, QString const& pathSolver) const
+{
+    if (mProgram.isEmpty() || !pathSolver.endsWith(".exe", Qt::CaseInsensitive))
+    {
+        pProcess->setProgram(pathSolver);
+        pProcess->setArguments(mArguments);
+    }
+    else
+    {
+        pProcess->setProgram(mProgram);
+        pProcess->setArguments(QStringList(pathSolver) + mArguments);
+    }
+}
+
+//! Read the status written by the rod system solver, -1 is returned if it is absent or has not been written completely
+int SolverLauncher::readRodSystemStatus(QString const& directory)
+{
+    int status = -1;
+    QFile file(directory + skFileNameStatus);
+    if (!file.open(QIODeviceBase::ReadOnly))
+        return status;
+    QTextStream stream(&file);
+    stream >> status;
+    // The file is created before the status is written into it
+    if (stream.status() != QTextStream::Ok)
+        return -1;
+    return status;
+}
@@ -0,0 +1,48 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the SolverLauncher class
+ */
+
+#ifndef SOLVERLAUNCHER_H
+#define SOLVERLAUNCHER_H
+
+#include <QString>
+#include <QStringList>
+
+class QProcess;
+
+namespace RSE::Solution
+{
+
+/*!
+ * \brief Way of running the solvers which is shared by the solution manager and the job scheduler
+ *
+ * Windows executables are run by the launcher, such as the compatibility layer, or natively, if the launcher is empty.
+ * The arguments are passed to every solver, so that stand-ins of the solvers can be configured
+ */
+class SolverLauncher
+{
+public:
+    SolverLauncher();
+    ~SolverLauncher() = default;
+    QString const& program() const { return mProgram; }
+    void setProgram(QString const& program) { mProgram = program; }
+    QStringList const& arguments() const { return mArguments; }
+    void setArguments(QStringList const& arguments) { mArguments = arguments; }
+    void setup(QProcess* pProcess, QString const& pathSolver) const;
+    static int readRodSystemStatus(QString const& directory);
+
+    static const QString skNameRodSystemSolver;
+    static const QString skFileNameStatus;
+
+private:
+    //! Program which runs the solvers. Empty one means that the solvers are run natively
+    QString mProgram;
+    QStringList mArguments;
+};
+
+}
+
+#endif // SOLVERLAUNCHER_H
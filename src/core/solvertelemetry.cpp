@@ -0,0 +1,265 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the SolverTelemetry class
+ */
+
+#include <QFile>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <cmath>
+#include "solvertelemetry.h"
+
+using namespace RSE::Solution;
+
+//! Length of a line which is processed even though it has not been terminated
+static qsizetype const skMaxLineLength = 1 << 16;
+//! Number of the recent progress reports used to estimate the remaining time
+static std::size_t const skNumProgressPoints = 32;
+
+static double toNumber(QString const& text);
+static QString toText(int value);
+static QString toText(double value);
+
+SolverTelemetry::SolverTelemetry()
+{
+    start();
+}
+
+//! Forget the output parsed before and restart the clock
+void SolverTelemetry::start(int numExpectedSteps)
+{
+    mClock.start();
+    mPendingLine.clear();
+    mNumLines = 0;
+    mSamples.clear();
+    mNumExpectedSteps = numExpectedSteps;
+    mNumModeSteps = 0;
+    mProgress.clear();
+}
+
+//! Parse a chunk of the output received now
+std::vector<TelemetrySample> SolverTelemetry::parse(QByteArray const& data)
+{
+    return parse(data, mClock.elapsed());
+}
+
+/*!
+ * \brief Parse a chunk of the output received at the specified time
+ * \param data Chunk which may begin and end in the middle of lines
+ * \param elapsed Time elapsed since the parser was started, ms
+ * \return Samples of the lines completed by the chunk
+ */
+std::vector<TelemetrySample> SolverTelemetry::parse(QByteArray const& data, qint64 elapsed)
+{
+    std::vector<TelemetrySample> samples;
+    qsizetype iBegin = 0;
+    qsizetype numBytes = data.size();
+    for (qsizetype i = 0; i != numBytes; ++i)
+    {
+        // Carriage returns are used to redraw the line of progress, so they complete lines as well
+        char symbol = data[i];
+        if (symbol != '\n' && symbol != '\r')
+            continue;
+        mPendingLine.append(data.constData() + iBegin, i - iBegin);
+        processLine(mPendingLine, elapsed, samples);
+        mPendingLine.clear();
+        iBegin = i + 1;
+    }
+    mPendingLine.append(data.constData() + iBegin, numBytes - iBegin);
+    if (mPendingLine.size() > skMaxLineLength)
+    {
+        processLine(mPendingLine, elapsed, samples);
+        mPendingLine.clear();
+    }
+    return samples;
+}
+
+//! Parse the last line of the output which has not been terminated
+std::vector<TelemetrySample> SolverTelemetry::finish()
+{
+    std::vector<TelemetrySample> samples;
+    processLine(mPendingLine, mClock.elapsed(), samples);
+    mPendingLine.clear();
+    return samples;
+}
+
+//! Turn a line into a sample, if it reports anything, and register the progress
+void SolverTelemetry::processLine(QByteArray const& line, qint64 elapsed, std::vector<TelemetrySample>& samples)
+{
+    if (line.trimmed().isEmpty())
+        return;
+    ++mNumLines;
+    TelemetrySample sample;
+    if (!parseLine(line, sample))
+        return;
+    sample.elapsed = elapsed;
+    // Mode steps are counted, if the solver does not number them
+    if (sample.event == TelemetrySample::kModeStep)
+    {
+        if (sample.step < 0)
+            sample.step = mNumModeSteps + 1;
+        mNumModeSteps = sample.step;
+    }
+    // Estimate the fraction of steps done
+    double fraction = -1.0;
+    int numSteps = sample.numSteps > 0 ? sample.numSteps : mNumExpectedSteps;
+    if (sample.step >= 0 && numSteps > 0)
+        fraction = std::min(1.0, (double)sample.step / numSteps);
+    if (sample.event == TelemetrySample::kFinished)
+        fraction = 1.0;
+    if (fraction >= 0.0 && (mProgress.empty() || mProgress.back().second != fraction))
+    {
+        mProgress.push_back({elapsed, fraction});
+        if (mProgress.size() > skNumProgressPoints)
+            mProgress.pop_front();
+    }
+    mSamples.push_back(sample);
+    samples.push_back(sample);
+}
+
+//! Fraction of steps done or a negative value, if it is unknown
+double SolverTelemetry::progress() const
+{
+    if (mProgress.empty())
+        return -1.0;
+    return mProgress.back().second;
+}
+
+/*!
+ * \brief Estimate the time remaining at the last report of progress
+ *
+ * The rate of progress is averaged over the recent reports, so that the startup of a solver does not affect the estimation
+ * \return Time remaining, ms, or a negative value, if the progress is not reported
+ */
+qint64 SolverTelemetry::remainingTime() const
+{
+    if (mProgress.size() < 2)
+        return -1;
+    auto const& [startTime, startFraction] = mProgress.front();
+    auto const& [endTime, endFraction] = mProgress.back();
+    if (endFraction >= 1.0)
+        return 0;
+    double deltaFraction = endFraction - startFraction;
+    qint64 deltaTime = endTime - startTime;
+    if (deltaFraction <= 0.0 || deltaTime <= 0)
+        return -1;
+    return std::llround((1.0 - endFraction) * deltaTime / deltaFraction);
+}
+
+/*!
+ * \brief Write the samples parsed as a table
+ *
+ * Values which have not been reported are left empty, so that the tables of different solvers are read the same way
+ */
+bool SolverTelemetry::write(QString const& pathFile) const
+{
+    static char const* const skEventNames[] = {"progress", "mode step", "finished", "error"};
+    QFile file(pathFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    QTextStream stream(&file);
+    stream << "elapsed,event,step,numSteps,iteration,time,timeStep,residual\n";
+    for (TelemetrySample const& sample : mSamples)
+    {
+        stream << sample.elapsed << ',' << skEventNames[sample.event] << ',' << toText(sample.step) << ','
+               << toText(sample.numSteps) << ',' << toText(sample.iteration) << ',' << toText(sample.time) << ','
+               << toText(sample.timeStep) << ',' << toText(sample.residual) << '\n';
+    }
+    stream.flush();
+    return stream.status() == QTextStream::Ok;
+}
+
+/*!
+ * \brief Extract the quantities reported in a line
+ *
+ * Labels are matched regardless of their case. Numbers may be written in the Fortran notation
+ * \return Whether the line reports anything
+ */
+bool SolverTelemetry::parseLine(QByteArray const& line, TelemetrySample& sample)
+{
+    static QString const skNumber = R"(([-+]?(?:\d+\.?\d*|\.\d+)(?:[eEdD][-+]?\d+)?))";
+    static QString const skCounter = R"(\s*#?\s*(\d+)(?:\s*(?:/|of)\s*(\d+))?)";
+    static auto const skOptions = QRegularExpression::CaseInsensitiveOption;
+    static QRegularExpression const skModeStepExpression(R"(mode\s+optimization\s+step(?:)" + skCounter + ")?", skOptions);
+    static QRegularExpression const skStepExpression(R"(\bstep)" + skCounter, skOptions);
+    static QRegularExpression const skIterationExpression(R"(\biter(?:ation)?s?\s*#?\s*[:=]?\s*(\d+))", skOptions);
+    static QRegularExpression const skTimeStepExpression(R"(\b(?:dt|time\s+step)\s*[:=]\s*)" + skNumber, skOptions);
+    static QRegularExpression const skTimeExpression(R"(\b(?:t|time)\s*[:=]\s*)" + skNumber, skOptions);
+    static QRegularExpression const skResidualExpression(R"(\bresid(?:ual)?(?:\s+norm)?\s*[:=]?\s*)" + skNumber, skOptions);
+    static QRegularExpression const skFinishedExpression(R"(\b(?:optimization|solution)\s+finished\b)", skOptions);
+    static QRegularExpression const skErrorExpression(R"(^\s*error\b)", skOptions);
+    QString text = QString::fromLocal8Bit(line);
+    bool isFound = false;
+    // Counters of steps
+    QRegularExpressionMatch match = skModeStepExpression.match(text);
+    if (match.hasMatch())
+    {
+        sample.event = TelemetrySample::kModeStep;
+        isFound = true;
+    }
+    else
+    {
+        match = skStepExpression.match(text);
+    }
+    if (match.hasMatch())
+    {
+        if (!match.captured(1).isEmpty())
+            sample.step = match.captured(1).toInt();
+        if (!match.captured(2).isEmpty())
+            sample.numSteps = match.captured(2).toInt();
+        isFound = true;
+    }
+    match = skIterationExpression.match(text);
+    if (match.hasMatch())
+    {
+        sample.iteration = match.captured(1).toInt();
+        isFound = true;
+    }
+    // Real-valued quantities
+    std::pair<QRegularExpression const*, double*> const quantities[] = {{&skTimeStepExpression, &sample.timeStep},
+                                                                        {&skTimeExpression, &sample.time},
+                                                                        {&skResidualExpression, &sample.residual}};
+    for (auto const& [pExpression, pValue] : quantities)
+    {
+        match = pExpression->match(text);
+        if (match.hasMatch())
+        {
+            *pValue = toNumber(match.captured(1));
+            isFound = true;
+        }
+    }
+    // Events
+    if (skFinishedExpression.match(text).hasMatch())
+    {
+        sample.event = TelemetrySample::kFinished;
+        isFound = true;
+    }
+    else if (skErrorExpression.match(text).hasMatch())
+    {
+        sample.event = TelemetrySample::kError;
+        isFound = true;
+    }
+    return isFound;
+}
+
+//! Convert a number which may be written in the Fortran notation
+double toNumber(QString const& text)
+{
+    QString value = text;
+    value.replace('d', 'e').replace('D', 'e');
+    return value.toDouble();
+}
+
+//! Represent a counter, leaving unknown values empty
+QString toText(int value)
+{
+    return value < 0 ? QString() : QString::number(value);
+}
+
+//! Represent a real value, leaving unknown values empty
+QString toText(double value)
+{
+    return std::isnan(value) ? QString() : QString::number(value, 'g', 10);
+}
@@ -0,0 +1,87 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the SolverTelemetry class
+ */
+
+#ifndef SOLVERTELEMETRY_H
+#define SOLVERTELEMETRY_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QString>
+#include <deque>
+#include <limits>
+#include <vector>
+
+namespace RSE::Solution
+{
+
+//! Quantities reported by a solver in a line of its output
+struct TelemetrySample
+{
+    //! Events which a line reports
+    enum Event
+    {
+        kProgress,
+        kModeStep,
+        kFinished,
+        kError
+    };
+
+    Event event = kProgress;
+    //! Time elapsed since the parser was started, ms
+    qint64 elapsed = 0;
+    //! Number of the step and the total number of steps. Negative values mean unknown ones
+    int step = -1;
+    int numSteps = -1;
+    int iteration = -1;
+    double time = std::numeric_limits<double>::quiet_NaN();
+    double timeStep = std::numeric_limits<double>::quiet_NaN();
+    double residual = std::numeric_limits<double>::quiet_NaN();
+};
+
+/*!
+ * \brief Incremental parser of the solver output
+ *
+ * Chunks of the output are split into lines, the incomplete last line of a chunk is kept until the rest of it arrives.
+ * Lines which report counters of steps, iterations, residuals or the time step are turned into samples,
+ * while the others are skipped. The fraction of steps done is used to estimate the remaining time
+ * by the rate of the recent progress
+ */
+class SolverTelemetry
+{
+public:
+    SolverTelemetry();
+    void start(int numExpectedSteps = -1);
+    std::vector<TelemetrySample> parse(QByteArray const& data);
+    std::vector<TelemetrySample> parse(QByteArray const& data, qint64 elapsed);
+    std::vector<TelemetrySample> finish();
+    std::vector<TelemetrySample> const& samples() const { return mSamples; }
+    qint64 numLines() const { return mNumLines; }
+    double progress() const;
+    qint64 remainingTime() const;
+    bool write(QString const& pathFile) const;
+    static bool parseLine(QByteArray const& line, TelemetrySample& sample);
+
+private:
+    void processLine(QByteArray const& line, qint64 elapsed, std::vector<TelemetrySample>& samples);
+
+private:
+    QElapsedTimer mClock;
+    //! Beginning of the line which has not been terminated yet
+    QByteArray mPendingLine;
+    qint64 mNumLines;
+    std::vector<TelemetrySample> mSamples;
+    //! Number of steps given beforehand, if the solver does not report it
+    int mNumExpectedSteps;
+    //! Number of mode steps which have not been numbered by the solver
+    int mNumModeSteps;
+    //! Recent fractions of steps done along with the times they were reported at
+    std::deque<std::pair<qint64, double>> mProgress;
+};
+
+}
+
+#endif // SOLVERTELEMETRY_H
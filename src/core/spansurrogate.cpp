@@ -0,0 +1,299 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the SpanSurrogate class
+ */
+
+#include <QFile>
+#include <QFileInfo>
+#include <cmath>
+#include <limits>
+#include "spansurrogate.h"
+#include "databasecables.h"
+
+using namespace RSE::Core;
+
+static quint32 const skSignature = 0x52534553;
+static quint32 const skVersion   = 1;
+//! Extension of the file of tables
+static QString const skExtension = ".spans";
+
+void writeValues(QDataStream& stream, std::vector<double> const& values);
+void readValues(QDataStream& stream, std::vector<double>& values);
+bool isValid(SurrogateGrid const& grid);
+
+//! Tabulate solutions of a single span over the specified grids
+void SpanSurrogate::build(Cable const& cable, SurrogateGrid const& distanceGrid, SurrogateGrid const& forceGrid)
+{
+    const double kNaN = std::numeric_limits<double>::quiet_NaN();
+    const double kInf = std::numeric_limits<double>::infinity();
+
+    mNameCable = cable.name;
+    mDistanceGrid = distanceGrid;
+    mForceGrid = forceGrid;
+    mConstant.clear();
+    mLength.clear();
+    mProjectedForce.clear();
+    mCellError.clear();
+    int numDistances = mDistanceGrid.numNodes;
+    int numForces = mForceGrid.numNodes;
+    if (numDistances < 2 || numForces < 2)
+        return;
+
+    // Solve a single span
+    RodSystem rodSystem({mDistanceGrid.minValue}, cable, mForceGrid.minValue);
+    auto solve = [&rodSystem, kNaN](double distance, double force, double& constant, double& length, double& projectedForce)
+    {
+        rodSystem.setDistances({distance});
+        rodSystem.setForce(force);
+        Spans spans = rodSystem.computeSpans();
+        constant = spans.isConverged ? spans.uL[0] : kNaN;
+        length = spans.isConverged ? spans.L[0] : kNaN;
+        projectedForce = spans.isConverged ? spans.projectedForce : kNaN;
+        return spans.isConverged;
+    };
+
+    // Tabulate the solutions in nodes
+    int numNodes = numDistances * numForces;
+    mConstant.resize(numNodes);
+    mLength.resize(numNodes);
+    mProjectedForce.resize(numNodes);
+    for (int iForce = 0; iForce != numForces; ++iForce)
+    {
+        for (int iDistance = 0; iDistance != numDistances; ++iDistance)
+        {
+            int k = index(iDistance, iForce);
+            solve(mDistanceGrid.value(iDistance), mForceGrid.value(iForce), mConstant[k], mLength[k], mProjectedForce[k]);
+        }
+    }
+
+    // Estimate errors of the interpolation at the centers of cells
+    double constant, length, projectedForce;
+    mCellError.resize((numDistances - 1) * (numForces - 1));
+    for (int iForce = 0; iForce != numForces - 1; ++iForce)
+    {
+        for (int iDistance = 0; iDistance != numDistances - 1; ++iDistance)
+        {
+            double& error = mCellError[cellIndex(iDistance, iForce)];
+            double distance = mDistanceGrid.value(iDistance) + 0.5 * mDistanceGrid.step();
+            double force = mForceGrid.value(iForce) + 0.5 * mForceGrid.step();
+            if (!solve(distance, force, constant, length, projectedForce))
+            {
+                error = kInf;
+                continue;
+            }
+            int k[4] = {index(iDistance, iForce), index(iDistance + 1, iForce), index(iDistance, iForce + 1), index(iDistance + 1, iForce + 1)};
+            double approxLength = 0.25 * (mLength[k[0]] + mLength[k[1]] + mLength[k[2]] + mLength[k[3]]);
+            double approxForce = 0.25 * (mProjectedForce[k[0]] + mProjectedForce[k[1]] + mProjectedForce[k[2]] + mProjectedForce[k[3]]);
+            error = std::max(std::abs(approxLength / length - 1.0), std::abs(approxForce / projectedForce - 1.0));
+            if (std::isnan(error))
+                error = kInf;
+        }
+    }
+}
+
+/*!
+ * \brief Interpolate parameters of spans
+ * \param[out] error Estimated relative error which is infinite if the parameters are out of the table
+ * \return Approximated spans which are marked as converged if the parameters are inside the table
+ */
+Spans SpanSurrogate::interpolate(std::vector<double> const& distances, double force, double& error) const
+{
+    int numRods = distances.size();
+    Spans spans(numRods);
+    error = std::numeric_limits<double>::infinity();
+    if (isEmpty() || force < mForceGrid.minValue || force > mForceGrid.maxValue)
+        return spans;
+
+    // Find the cell along forces
+    double position = (force - mForceGrid.minValue) / mForceGrid.step();
+    int iForce = std::min((int)position, mForceGrid.numNodes - 2);
+    double forceWeight = position - iForce;
+
+    // Interpolate each rod
+    double maxError = 0.0;
+    for (int iRod = 0; iRod != numRods; ++iRod)
+    {
+        double distance = distances[iRod];
+        if (distance < mDistanceGrid.minValue || distance > mDistanceGrid.maxValue)
+            return spans;
+        position = (distance - mDistanceGrid.minValue) / mDistanceGrid.step();
+        int iDistance = std::min((int)position, mDistanceGrid.numNodes - 2);
+        double distanceWeight = position - iDistance;
+        double weights[4] = {(1.0 - distanceWeight) * (1.0 - forceWeight), distanceWeight * (1.0 - forceWeight),
+                             (1.0 - distanceWeight) * forceWeight, distanceWeight * forceWeight
+                            };
+        int k[4] = {index(iDistance, iForce), index(iDistance + 1, iForce), index(iDistance, iForce + 1), index(iDistance + 1, iForce + 1)};
+        double constant = 0.0;
+        double length = 0.0;
+        double projectedForce = 0.0;
+        for (int j = 0; j != 4; ++j)
+        {
+            constant += weights[j] * mConstant[k[j]];
+            length += weights[j] * mLength[k[j]];
+            projectedForce += weights[j] * mProjectedForce[k[j]];
+        }
+        spans.u0[iRod] = -constant;
+        spans.uL[iRod] = constant;
+        spans.L[iRod] = length;
+        if (iRod == 0)
+            spans.projectedForce = projectedForce;
+        maxError = std::max(maxError, mCellError[cellIndex(iDistance, iForce)]);
+    }
+    error = maxError;
+    spans.isConverged = !std::isinf(error);
+    return spans;
+}
+
+/*!
+ * \brief Compute parameters of spans using the table, if it is accurate enough, or the exact solver otherwise
+ * \param[out] pError Estimated relative error, which equals zero if the exact solver is used
+ */
+Spans SpanSurrogate::computeSpans(RodSystem& rodSystem, double tolerance, double* pError) const
+{
+    double error;
+    if (rodSystem.nameCable() == mNameCable)
+    {
+        Spans spans = interpolate(rodSystem.distances(), rodSystem.force(), error);
+        if (spans.isConverged && error <= tolerance)
+        {
+            if (pError)
+                *pError = error;
+            return spans;
+        }
+    }
+    if (pError)
+        *pError = 0.0;
+    return rodSystem.computeSpans();
+}
+
+//! Write several surrogates to a binary file
+bool SpanSurrogate::write(QString const& pathFile, std::vector<SpanSurrogate> const& surrogates)
+{
+    QFile file(pathFile);
+    if (!file.open(QIODeviceBase::WriteOnly))
+        return false;
+    QDataStream stream(&file);
+    stream << skSignature << skVersion << (quint32)surrogates.size();
+    for (auto const& item : surrogates)
+        stream << item;
+    file.close();
+    return true;
+}
+
+/*!
+ * \brief Read all the surrogates from a binary file
+ * \return Surrogates or an empty set, if the file is truncated or any of its tables is inconsistent
+ */
+std::vector<SpanSurrogate> SpanSurrogate::read(QString const& pathFile)
+{
+    std::vector<SpanSurrogate> surrogates;
+    QFile file(pathFile);
+    if (!file.open(QIODeviceBase::ReadOnly))
+        return surrogates;
+    QDataStream stream(&file);
+    quint32 signature, version, numSurrogates;
+    stream >> signature >> version;
+    if (signature != skSignature || version != skVersion)
+        return surrogates;
+    stream >> numSurrogates;
+    for (quint32 i = 0; i != numSurrogates && stream.status() == QDataStream::Ok; ++i)
+    {
+        SpanSurrogate item;
+        stream >> item;
+        surrogates.push_back(std::move(item));
+    }
+    if (stream.status() != QDataStream::Ok)
+        surrogates.clear();
+    file.close();
+    return surrogates;
+}
+
+//! Path to the file of tables which is stored next to the database of cables
+QString SpanSurrogate::pathFile(QString const& pathFileCables)
+{
+    QFileInfo info(pathFileCables);
+    return info.path() + '/' + info.completeBaseName() + skExtension;
+}
+
+//! Check whether the sizes of tables agree with the grids. Tables which have not been built are left empty
+bool SpanSurrogate::isValid() const
+{
+    if (!::isValid(mDistanceGrid) || !::isValid(mForceGrid))
+        return mConstant.empty() && mLength.empty() && mProjectedForce.empty() && mCellError.empty();
+    std::size_t numNodes = (std::size_t)mDistanceGrid.numNodes * mForceGrid.numNodes;
+    std::size_t numCells = (std::size_t)(mDistanceGrid.numNodes - 1) * (mForceGrid.numNodes - 1);
+    return mConstant.size() == numNodes && mLength.size() == numNodes && mProjectedForce.size() == numNodes
+           && mCellError.size() == numCells;
+}
+
+namespace RSE::Core
+{
+
+//! Write a surrogate to a binary stream
+QDataStream& operator<<(QDataStream& stream, SpanSurrogate const& surrogate)
+{
+    stream << QString::fromStdString(surrogate.mNameCable);
+    for (SurrogateGrid const* pGrid : {&surrogate.mDistanceGrid, &surrogate.mForceGrid})
+        stream << pGrid->minValue << pGrid->maxValue << (qint32)pGrid->numNodes;
+    writeValues(stream, surrogate.mConstant);
+    writeValues(stream, surrogate.mLength);
+    writeValues(stream, surrogate.mProjectedForce);
+    writeValues(stream, surrogate.mCellError);
+    return stream;
+}
+
+//! Read a surrogate from a binary stream
+QDataStream& operator>>(QDataStream& stream, SpanSurrogate& surrogate)
+{
+    QString name;
+    qint32 numNodes;
+    stream >> name;
+    surrogate.mNameCable = name.toStdString();
+    for (SurrogateGrid* pGrid : {&surrogate.mDistanceGrid, &surrogate.mForceGrid})
+    {
+        stream >> pGrid->minValue >> pGrid->maxValue >> numNodes;
+        pGrid->numNodes = numNodes;
+    }
+    readValues(stream, surrogate.mConstant);
+    readValues(stream, surrogate.mLength);
+    readValues(stream, surrogate.mProjectedForce);
+    readValues(stream, surrogate.mCellError);
+    if (stream.status() == QDataStream::Ok && !surrogate.isValid())
+        stream.setStatus(QDataStream::ReadCorruptData);
+    return stream;
+}
+
+}
+
+//! Write a set of values preceded by its size
+void writeValues(QDataStream& stream, std::vector<double> const& values)
+{
+    stream << (quint32)values.size();
+    for (double value : values)
+        stream << value;
+}
+
+//! Read a set of values preceded by its size. The size which exceeds the rest of the stream marks it as corrupted
+void readValues(QDataStream& stream, std::vector<double>& values)
+{
+    quint32 numValues = 0;
+    stream >> numValues;
+    QIODevice* pDevice = stream.device();
+    if (stream.status() != QDataStream::Ok || (pDevice && numValues > pDevice->bytesAvailable() / (qint64)sizeof(double)))
+    {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        values.clear();
+        return;
+    }
+    values.resize(numValues);
+    for (double& value : values)
+        stream >> value;
+}
+
+//! Check whether a grid consists of several increasing nodes
+bool isValid(SurrogateGrid const& grid)
+{
+    return grid.numNodes >= 2 && std::isfinite(grid.minValue) && std::isfinite(grid.maxValue) && grid.minValue < grid.maxValue;
+}
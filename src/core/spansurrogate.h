@@ -0,0 +1,85 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the SpanSurrogate class
+ */
+
+#ifndef SPANSURROGATE_H
+#define SPANSURROGATE_H
+
+#include <QString>
+#include <QDataStream>
+#include <vector>
+#include "rodsystem.h"
+
+namespace RSE::Core
+{
+
+struct Cable;
+
+//! Uniform grid of parameter values
+struct SurrogateGrid
+{
+    double step() const { return numNodes > 1 ? (maxValue - minValue) / (numNodes - 1) : 0.0; }
+    double value(int iNode) const { return minValue + iNode * step(); }
+    //! Minimal value
+    double minValue = 0.0;
+    //! Maximal value
+    double maxValue = 0.0;
+    //! Number of nodes
+    int numNodes = 0;
+};
+
+/*!
+ * \brief Tabulated solutions of a single span made of the specified cable
+ *
+ * All the supports are located at the same level, so the tension at the ends of each rod equals the stretching force.
+ * Hence, rods of a system are independent of each other, and a system is approximated span by span.
+ * Solutions are tabulated over distances between supports and stretching forces and interpolated bilinearly.
+ * Tables of all the cables are built offline by the spantable tool and stored in a single file next to the database of cables.
+ */
+class SpanSurrogate
+{
+public:
+    SpanSurrogate() = default;
+    ~SpanSurrogate() = default;
+    bool isEmpty() const { return mLength.empty(); }
+    std::string const& nameCable() const { return mNameCable; }
+    SurrogateGrid const& distanceGrid() const { return mDistanceGrid; }
+    SurrogateGrid const& forceGrid() const { return mForceGrid; }
+    void build(Cable const& cable, SurrogateGrid const& distanceGrid, SurrogateGrid const& forceGrid);
+    Spans interpolate(std::vector<double> const& distances, double force, double& error) const;
+    Spans computeSpans(RodSystem& rodSystem, double tolerance, double* pError = nullptr) const;
+    // IO
+    static bool write(QString const& pathFile, std::vector<SpanSurrogate> const& surrogates);
+    static std::vector<SpanSurrogate> read(QString const& pathFile);
+    static QString pathFile(QString const& pathFileCables);
+    friend QDataStream& operator<<(QDataStream& stream, SpanSurrogate const& surrogate);
+    friend QDataStream& operator>>(QDataStream& stream, SpanSurrogate& surrogate);
+
+private:
+    int index(int iDistance, int iForce) const { return iForce * mDistanceGrid.numNodes + iDistance; }
+    int cellIndex(int iDistance, int iForce) const { return iForce * (mDistanceGrid.numNodes - 1) + iDistance; }
+    bool isValid() const;
+
+private:
+    //! Name of a cable
+    std::string mNameCable;
+    //! Nodes along distances between supports, m
+    SurrogateGrid mDistanceGrid;
+    //! Nodes along stretching forces, N
+    SurrogateGrid mForceGrid;
+    //! Constant at the right end of a rod in each node
+    std::vector<double> mConstant;
+    //! Length of a rod in each node, m
+    std::vector<double> mLength;
+    //! Projected force in each node, N
+    std::vector<double> mProjectedForce;
+    //! Relative error of interpolation at the center of each cell
+    std::vector<double> mCellError;
+};
+
+}
+
+#endif // SPANSURROGATE_H
@@ -0,0 +1,115 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Implementation of the SurfaceDataObject class
+ */
+
+#include <algorithm>
+#include "surfacedataobject.h"
+
+using namespace RSE::Core;
+
+std::atomic<quint32> SurfaceDataObject::smNumInstances = 0;
+const IndexType skNumCoordinates = 2;
+
+//! Construct a surface data object without points
+SurfaceDataObject::SurfaceDataObject(QString const& name)
+    : AbstractDataObject(kSurface, name, 0, skNumCoordinates)
+{
+    mIsVariableRows = true;
+    ++smNumInstances;
+}
+
+//! Decrease a number of instances while being destroyed
+SurfaceDataObject::~SurfaceDataObject()
+{
+    --smNumInstances;
+}
+
+//! Clone a surface data object
+AbstractDataObject* SurfaceDataObject::clone() const
+{
+    SurfaceDataObject* obj = new SurfaceDataObject(mName);
+    obj->mpItems = mpItems;
+    obj->mID = mID;
+    obj->mNumItemRows = mNumItemRows;
+    --smNumInstances;
+    return obj;
+}
+
+//! Change the number of points of all the items. New points repeat the last existing one
+void SurfaceDataObject::setNumberPoints(IndexType numPoints)
+{
+    if (numPoints == mNumItemRows)
+        return;
+    quint32 numItems = numberItems();
+    IndexType oldSize = itemSize();
+    IndexType newSize = numPoints * mNumItemCols;
+    IndexType minSize = std::min(oldSize, newSize);
+    std::vector<DataValueType> values(numItems * newSize, 0.0);
+    for (quint32 iItem = 0; iItem != numItems; ++iItem)
+    {
+        DataValueType const* pSource = itemData(iItem);
+        DataValueType* pDest = &values[iItem * newSize];
+        std::copy_n(pSource, minSize, pDest);
+        if (oldSize == 0)
+            continue;
+        for (IndexType i = minSize; i < newSize; i += mNumItemCols)
+            std::copy_n(pSource + oldSize - mNumItemCols, mNumItemCols, pDest + i);
+    }
+    mpItems->values = std::move(values);
+    mNumItemRows = numPoints;
+}
+
+/*!
+ * \brief Interpolate a surface linearly along abscissas of curves and then between the curves
+ *
+ * Values outside the table are taken from its boundaries
+ */
+DataValueType SurfaceDataObject::interpolate(DataKeyType key, DataValueType x) const
+{
+    std::vector<DataKeyType> const& keys = mpItems->keys;
+    if (keys.empty() || mNumItemRows == 0)
+        return 0.0;
+    quint32 iUpper = std::upper_bound(keys.begin(), keys.end(), key) - keys.begin();
+    if (iUpper == 0)
+        return interpolateItem(0, x);
+    if (iUpper == keys.size())
+        return interpolateItem(iUpper - 1, x);
+    quint32 iLower = iUpper - 1;
+    double weight = (key - keys[iLower]) / (keys[iUpper] - keys[iLower]);
+    return (1.0 - weight) * interpolateItem(iLower, x) + weight * interpolateItem(iUpper, x);
+}
+
+//! Interpolate a curve of an item linearly
+DataValueType SurfaceDataObject::interpolateItem(quint32 iItem, DataValueType x) const
+{
+    DataValueType const* pPoints = itemData(iItem);
+    IndexType numPoints = mNumItemRows;
+    // Find the first point whose abscissa exceeds the specified one
+    IndexType iFirst = 0;
+    IndexType count = numPoints;
+    while (count > 0)
+    {
+        IndexType step = count / 2;
+        IndexType iMiddle = iFirst + step;
+        if (pPoints[iMiddle * skNumCoordinates] <= x)
+        {
+            iFirst = iMiddle + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    if (iFirst == 0)
+        return pPoints[1];
+    if (iFirst == numPoints)
+        return pPoints[(numPoints - 1) * skNumCoordinates + 1];
+    DataValueType const* pLower = &pPoints[(iFirst - 1) * skNumCoordinates];
+    DataValueType const* pUpper = pLower + skNumCoordinates;
+    double weight = (x - pLower[0]) / (pUpper[0] - pLower[0]);
+    return (1.0 - weight) * pLower[1] + weight * pUpper[1];
+}
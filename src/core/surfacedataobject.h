@@ -0,0 +1,42 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the SurfaceDataObject class
+ */
+
+#ifndef SURFACEDATAOBJECT_H
+#define SURFACEDATAOBJECT_H
+
+#include "abstractdataobject.h"
+
+namespace RSE::Core
+{
+
+/*!
+ * \brief Surface data object
+ *
+ * Each item is a curve tabulated by points (x, y) with ascending abscissas, and all the curves contain the same number of points.
+ * Points of all the items are stored row by row in a single block, so that a surface is interpolated without indirections.
+ */
+class SurfaceDataObject : public AbstractDataObject
+{
+public:
+    SurfaceDataObject(QString const& name);
+    ~SurfaceDataObject();
+    AbstractDataObject* clone() const override;
+    IndexType numberPoints() const { return mNumItemRows; }
+    void setNumberPoints(IndexType numPoints);
+    DataValueType interpolate(DataKeyType key, DataValueType x) const;
+    static quint32 numberInstances() { return smNumInstances; }
+
+private:
+    DataValueType interpolateItem(quint32 iItem, DataValueType x) const;
+
+private:
+    static std::atomic<quint32> smNumInstances;
+};
+
+}
+
+#endif // SURFACEDATAOBJECT_H
@@ -0,0 +1,219 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the TemplateCache class
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include "templatecache.h"
+#include "scalardataobject.h"
+#include "vectordataobject.h"
+#include "matrixdataobject.h"
+#include "surfacedataobject.h"
+#include "fileutilities.h"
+#include "prnreader.h"
+
+using namespace RSE::Core;
+
+const QString ProjectTemplate::skFileNameScalar  = "w1.prn";
+const QString ProjectTemplate::skFileNameVector  = "w3.prn";
+const QString ProjectTemplate::skFileNameMatrix  = "w9.prn";
+const QString ProjectTemplate::skFileNameSurface = "xy.prn";
+const QString ProjectTemplate::skFileNameProject = "PROJ_ID.prn";
+const QString ProjectTemplate::skFileNameRods    = "RODS.prn";
+const QString ProjectTemplate::skFileNameProgram = "PROG.prn";
+
+bool importDataObjects(DataObjects& dataObjects, QString const& path, QString const& fileName, QString& errorString);
+int readProjectID(QString const& path);
+QStringList readAllLines(QString const& path, QString const& fileName);
+
+ProjectTemplate::~ProjectTemplate()
+{
+    for (DataObjects* pDataObjects : {&scalarDataObjects, &vectorDataObjects, &matrixDataObjects, &surfaceDataObjects})
+    {
+        for (AbstractDataObject* pObject : *pDataObjects)
+            delete pObject;
+    }
+}
+
+/*!
+ * \brief Read all the template files located in the directory
+ *
+ * Files are read even if the previous ones are damaged, while the first error is kept
+ * \return true if all the files have been read, false otherwise
+ */
+bool ProjectTemplate::read(QString const& path)
+{
+    errorString.clear();
+    // Import data objects
+    QString fileErrorString;
+    auto import = [this, &path, &fileErrorString](DataObjects& dataObjects, QString const& fileName)
+    {
+        if (!importDataObjects(dataObjects, path, fileName, fileErrorString) && errorString.isEmpty())
+            errorString = fileErrorString;
+    };
+    import(scalarDataObjects, skFileNameScalar);
+    import(vectorDataObjects, skFileNameVector);
+    if (QFileInfo::exists(path + skFileNameMatrix))
+        import(matrixDataObjects, skFileNameMatrix);
+    if (QFileInfo::exists(path + skFileNameSurface))
+        import(surfaceDataObjects, skFileNameSurface);
+    // Set the project identifier
+    projectID = readProjectID(path);
+    // Read the file named RODS
+    rods = readAllLines(path, skFileNameRods);
+    // Read the file named PROG
+    program = readAllLines(path, skFileNameProgram);
+    return errorString.isEmpty();
+}
+
+//! Retrieve the only instance of the cache
+TemplateCache& TemplateCache::instance()
+{
+    static TemplateCache cache;
+    return cache;
+}
+
+//! Retrieve the template located in the directory, which is read only if it has not been cached or has been modified since
+std::shared_ptr<ProjectTemplate const> TemplateCache::get(QString const& path)
+{
+    QString key = QDir(path).absolutePath();
+    std::vector<qint64> stamps = TemplateCache::stamps(path);
+    QMutexLocker locker(&mMutex);
+    auto iter = mEntries.find(key);
+    if (iter != mEntries.end() && iter->second.stamps == stamps)
+        return iter->second.pTemplate;
+    std::shared_ptr<ProjectTemplate> pTemplate = std::make_shared<ProjectTemplate>();
+    pTemplate->read(path);
+    pTemplate->stamps = stamps;
+    mEntries[key] = {stamps, pTemplate};
+    return pTemplate;
+}
+
+//! Remove all the templates. The ones which are being used are destroyed after their last users
+void TemplateCache::clear()
+{
+    QMutexLocker locker(&mMutex);
+    mEntries.clear();
+}
+
+//! Number of cached templates
+int TemplateCache::size()
+{
+    QMutexLocker locker(&mMutex);
+    return mEntries.size();
+}
+
+//! Retrieve the modification times and sizes of the template files
+std::vector<qint64> TemplateCache::stamps(QString const& path)
+{
+    std::vector<qint64> stamps;
+    QDir directory(path);
+    for (QString const& fileName : {ProjectTemplate::skFileNameScalar, ProjectTemplate::skFileNameVector, ProjectTemplate::skFileNameMatrix,
+                                    ProjectTemplate::skFileNameSurface, ProjectTemplate::skFileNameProject, ProjectTemplate::skFileNameRods,
+                                    ProjectTemplate::skFileNameProgram})
+    {
+        QFileInfo info(directory.filePath(fileName));
+        if (info.exists())
+        {
+            stamps.push_back(info.lastModified().toMSecsSinceEpoch());
+            stamps.push_back(info.size());
+        }
+        else
+        {
+            stamps.push_back(-1);
+            stamps.push_back(-1);
+        }
+    }
+    return stamps;
+}
+
+//! Create a data object with the specified type
+AbstractDataObject* RSE::Core::createDataObject(AbstractDataObject::ObjectType type)
+{
+    QString name;
+    switch (type)
+    {
+    case AbstractDataObject::ObjectType::kScalar:
+        name = "Scalar " + QString::number(ScalarDataObject::numberInstances() + 1);
+        return new ScalarDataObject(name);
+    case AbstractDataObject::ObjectType::kVector:
+        name = "Vector " + QString::number(VectorDataObject::numberInstances() + 1);
+        return new VectorDataObject(name);
+    case AbstractDataObject::ObjectType::kMatrix:
+        name = "Matrix " + QString::number(MatrixDataObject::numberInstances() + 1);
+        return new MatrixDataObject(name);
+    case AbstractDataObject::ObjectType::kSurface:
+        name = "Surface " + QString::number(SurfaceDataObject::numberInstances() + 1);
+        return new SurfaceDataObject(name);
+    default:
+        return nullptr;
+    }
+}
+
+/*!
+ * \brief Import several data objects from a file
+ * \return true if all the data objects have been imported, false otherwise
+ */
+bool importDataObjects(DataObjects& dataObjects, QString const& path, QString const& fileName, QString& errorString)
+{
+    auto [type, pFile] = RSE::Utilities::File::getDataObjectFile(path, fileName);
+    if (pFile == nullptr)
+    {
+        errorString = QString("Could not open the file %1").arg(fileName);
+        return false;
+    }
+    PrnReader reader(*pFile);
+    quint32 numDataObjects;
+    reader.skipLine();
+    if (!reader.read(numDataObjects))
+    {
+        errorString = QString("%1: %2").arg(fileName, reader.errorString());
+        return false;
+    }
+    reader.skipLine();
+    for (quint32 iDataObject = 0; iDataObject != numDataObjects; ++iDataObject)
+    {
+        AbstractDataObject* pDataObject = createDataObject(type);
+        if (!pDataObject)
+            break;
+        dataObjects.push_back(pDataObject);
+        if (!pDataObject->import(reader))
+        {
+            errorString = QString("%1: data object %2 of %3: %4")
+                              .arg(fileName).arg(iDataObject + 1).arg(numDataObjects).arg(reader.errorString());
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Read the identifier of a project
+int readProjectID(QString const& path)
+{
+    QFile file(path + ProjectTemplate::skFileNameProject);
+    if (!file.open(QIODeviceBase::ReadOnly))
+        return 0;
+    PrnReader reader(file);
+    qint64 id = 0;
+    reader.read(id);
+    return id;
+}
+
+//! Read all the lines of a text file
+QStringList readAllLines(QString const& path, QString const& fileName)
+{
+    QStringList lines;
+    QFile file(path + fileName);
+    if (!file.open(QIODeviceBase::ReadOnly))
+        return lines;
+    PrnReader reader(file);
+    std::string_view line;
+    while (reader.readLine(line))
+        lines.push_back(QString::fromUtf8(line.data(), line.size()));
+    return lines;
+}
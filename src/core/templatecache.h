@@ -0,0 +1,93 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the TemplateCache class
+ */
+
+#ifndef TEMPLATECACHE_H
+#define TEMPLATECACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QMutex>
+#include <map>
+#include <memory>
+#include "abstractdataobject.h"
+
+namespace RSE::Core
+{
+
+//! Parsed content of a template directory
+struct ProjectTemplate
+{
+    ProjectTemplate() = default;
+    ~ProjectTemplate();
+    ProjectTemplate(ProjectTemplate const&) = delete;
+    ProjectTemplate& operator=(ProjectTemplate const&) = delete;
+    bool read(QString const& path);
+    //! Scalar data objects
+    DataObjects scalarDataObjects;
+    //! Vector data objects
+    DataObjects vectorDataObjects;
+    //! Matrix data objects, which are optional
+    DataObjects matrixDataObjects;
+    //! Surface data objects, which are optional
+    DataObjects surfaceDataObjects;
+    //! Project identifier
+    int projectID = 0;
+    //! Content of the file named RODS
+    QStringList rods;
+    //! Content of the file name PROG
+    QStringList program;
+    //! Modification times and sizes of the files the template was read from
+    std::vector<qint64> stamps;
+    //! Description of the first error occurred while reading, which is empty if the template has been read entirely
+    QString errorString;
+    // Names of files
+    static const QString skFileNameScalar;
+    static const QString skFileNameVector;
+    static const QString skFileNameMatrix;
+    static const QString skFileNameSurface;
+    static const QString skFileNameProject;
+    static const QString skFileNameRods;
+    static const QString skFileNameProgram;
+};
+
+/*!
+ * \brief Process-wide cache of parsed templates
+ *
+ * Templates are identified by their directories and invalidated when any of the template files is modified.
+ * Data objects of projects should be cloned from the cached ones, so that they share items until modified.
+ */
+class TemplateCache
+{
+public:
+    static TemplateCache& instance();
+    std::shared_ptr<ProjectTemplate const> get(QString const& path);
+    void clear();
+    static std::vector<qint64> stamps(QString const& path);
+    int size();
+
+private:
+    TemplateCache() = default;
+    ~TemplateCache() = default;
+
+private:
+    //! Cached template and the state of its files
+    struct Entry
+    {
+        std::vector<qint64> stamps;
+        std::shared_ptr<ProjectTemplate const> pTemplate;
+    };
+    //! Guard of the entries
+    QMutex mMutex;
+    //! Templates associated with their directories
+    std::map<QString, Entry> mEntries;
+};
+
+AbstractDataObject* createDataObject(AbstractDataObject::ObjectType type);
+
+}
+
+#endif // TEMPLATECACHE_H
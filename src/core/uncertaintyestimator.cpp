@@ -0,0 +1,293 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the UncertaintyEstimator class
+ */
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <cmath>
+#include <algorithm>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include "uncertaintyestimator.h"
+
+using namespace RSE::Core;
+
+//! Number of values kept as they are before the quantiles are estimated by markers
+static int const skNumExactValues = 256;
+
+//! Streaming accumulator of the mean and variance (Welford's algorithm)
+struct Accumulator
+{
+    void add(double value)
+    {
+        ++count;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+    }
+    double count = 0.0;
+    double mean = 0.0;
+    double m2 = 0.0;
+};
+
+//! Converged samples of a block
+struct BlockSamples
+{
+    //! Values of each output in the order of samples
+    std::vector<std::vector<double>> values;
+    //! Number of samples which have not converged
+    int numFailures = 0;
+};
+
+Statistics computeStatistics(Accumulator const& accumulator, std::vector<QuantileEstimator> const& estimators);
+
+UncertaintyEstimator::UncertaintyEstimator(RodSystem const& rodSystem, Tolerances const& tolerances)
+    : mRodSystem(rodSystem)
+    , mTolerances(tolerances)
+    , mNominalSpans(mRodSystem.computeSpans())
+{
+
+}
+
+/*!
+ * \brief Estimate distributions of spans by means of the Monte Carlo method
+ *
+ * Samples are split into blocks which are processed by several threads.
+ * The generator of each block is seeded by the block index, so results do not depend on the number of threads.
+ * Finished blocks are fed to the streaming estimators in the order of blocks, so that only the blocks which wait for
+ * the preceding ones are kept in memory rather than all the samples.
+ * Samples which have not converged are excluded from the statistics.
+ */
+SpansStatistics UncertaintyEstimator::estimate()
+{
+    const int kBlockSize = 256;
+
+    SpansStatistics statistics;
+    int numRods = mRodSystem.numRods();
+    int numOutputs = numRods + 1;
+    statistics.L.resize(numRods);
+    if (numRods == 0 || mNumSamples <= 0)
+        return statistics;
+
+    // Create the estimators
+    int numBlocks = (mNumSamples + kBlockSize - 1) / kBlockSize;
+    std::vector<Accumulator> accumulators(numOutputs);
+    std::vector<QuantileEstimator> quantileEstimators;
+    for (double probability : mProbabilities)
+        quantileEstimators.emplace_back(probability);
+    std::vector<std::vector<QuantileEstimator>> estimators(numOutputs, quantileEstimators);
+    std::atomic<int> iNextBlock = 0;
+    std::mutex mutex;
+    std::map<int, BlockSamples> pendingBlocks;
+    int iNextMergedBlock = 0;
+
+    // Feed the finished blocks which follow the ones fed before
+    auto mergeBlock = [&](int iBlock, BlockSamples&& block)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingBlocks.emplace(iBlock, std::move(block));
+        auto iter = pendingBlocks.begin();
+        while (iter != pendingBlocks.end() && iter->first == iNextMergedBlock)
+        {
+            for (int iOutput = 0; iOutput != numOutputs; ++iOutput)
+            {
+                for (double value : iter->second.values[iOutput])
+                {
+                    accumulators[iOutput].add(value);
+                    for (QuantileEstimator& estimator : estimators[iOutput])
+                        estimator.add(value);
+                }
+            }
+            statistics.numFailures += iter->second.numFailures;
+            iter = pendingBlocks.erase(iter);
+            ++iNextMergedBlock;
+        }
+    };
+
+    // Process blocks of samples
+    auto processBlocks = [&]()
+    {
+        RodSystem rodSystem = mRodSystem;
+        rodSystem.clearCache();
+        std::vector<double> const& nominalDistances = mRodSystem.distances();
+        std::vector<double> distances(numRods);
+        gsl_rng* pGenerator = gsl_rng_alloc(gsl_rng_mt19937);
+        int iBlock;
+        while ((iBlock = iNextBlock++) < numBlocks)
+        {
+            gsl_rng_set(pGenerator, mSeed + iBlock);
+            int iStartSample = iBlock * kBlockSize;
+            int iEndSample = std::min(iStartSample + kBlockSize, mNumSamples);
+            BlockSamples block;
+            block.values.resize(numOutputs);
+            for (int iSample = iStartSample; iSample != iEndSample; ++iSample)
+            {
+                // Perturb parameters of the system
+                Cable cable = mRodSystem.cable();
+                cable.massPerLength *= 1.0 + gsl_ran_gaussian(pGenerator, mTolerances.massPerLength);
+                cable.youngsModulus *= 1.0 + gsl_ran_gaussian(pGenerator, mTolerances.youngsModulus);
+                cable.area          *= 1.0 + gsl_ran_gaussian(pGenerator, mTolerances.area);
+                for (int iRod = 0; iRod != numRods; ++iRod)
+                    distances[iRod] = nominalDistances[iRod] + gsl_ran_gaussian(pGenerator, mTolerances.distance);
+                rodSystem.setCable(cable);
+                rodSystem.setDistances(distances);
+                // Solve the system starting from the nominal solution
+                Spans spans = rodSystem.computeSpans(mNominalSpans);
+                if (!spans.isConverged)
+                {
+                    ++block.numFailures;
+                    continue;
+                }
+                for (int iRod = 0; iRod != numRods; ++iRod)
+                    block.values[iRod].push_back(spans.L[iRod]);
+                block.values[numRods].push_back(spans.projectedForce);
+            }
+            mergeBlock(iBlock, std::move(block));
+        }
+        gsl_rng_free(pGenerator);
+    };
+    int numThreads = mNumThreads > 0 ? mNumThreads : std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, numBlocks);
+    std::vector<std::thread> threads;
+    for (int i = 0; i != numThreads; ++i)
+        threads.emplace_back(processBlocks);
+    for (auto& thread : threads)
+        thread.join();
+
+    // Evaluate the statistics
+    statistics.numSamples = mNumSamples - statistics.numFailures;
+    for (int iOutput = 0; iOutput != numOutputs; ++iOutput)
+    {
+        Statistics result = computeStatistics(accumulators[iOutput], estimators[iOutput]);
+        if (iOutput < numRods)
+            statistics.L[iOutput] = std::move(result);
+        else
+            statistics.projectedForce = std::move(result);
+    }
+    return statistics;
+}
+
+//! Evaluate moments and quantiles of the values accumulated
+Statistics computeStatistics(Accumulator const& accumulator, std::vector<QuantileEstimator> const& estimators)
+{
+    Statistics statistics;
+    statistics.mean = accumulator.mean;
+    if (accumulator.count > 1)
+        statistics.variance = accumulator.m2 / (accumulator.count - 1);
+    if (accumulator.count == 0)
+        return statistics;
+    for (QuantileEstimator const& estimator : estimators)
+        statistics.quantiles.push_back(estimator.value());
+    return statistics;
+}
+
+QuantileEstimator::QuantileEstimator(double probability)
+    : p(std::clamp(probability, 0.0, 1.0))
+{
+
+}
+
+//! Move the markers towards their desired positions once a value is added
+void QuantileEstimator::add(double value)
+{
+    // The first values are stored as they are
+    if (count < skNumExactValues)
+    {
+        values.push_back(value);
+        if (++count == skNumExactValues)
+            placeMarkers();
+        return;
+    }
+    ++count;
+    // Find the cell the value falls into, extending the extreme markers if needed
+    int k;
+    if (value < q[0])
+    {
+        q[0] = value;
+        k = 0;
+    }
+    else if (value >= q[4])
+    {
+        q[4] = value;
+        k = 3;
+    }
+    else
+    {
+        k = std::upper_bound(q + 1, q + 4, value) - q - 1;
+    }
+    for (int i = k + 1; i != 5; ++i)
+        n[i] += 1.0;
+    for (int i = 0; i != 5; ++i)
+        np[i] += dn[i];
+    // Adjust the heights of the middle markers
+    for (int i = 1; i != 4; ++i)
+    {
+        double delta = np[i] - n[i];
+        if ((delta >= 1.0 && n[i + 1] - n[i] > 1.0) || (delta <= -1.0 && n[i - 1] - n[i] < -1.0))
+        {
+            int sign = delta > 0.0 ? 1 : -1;
+            q[i] = adjust(i, sign);
+            n[i] += sign;
+        }
+    }
+}
+
+//! Place the markers at the order statistics of the values kept and release them
+void QuantileEstimator::placeMarkers()
+{
+    std::sort(values.begin(), values.end());
+    int numValues = values.size();
+    double const desired[] = {0.0, p / 2.0, p, (1.0 + p) / 2.0, 1.0};
+    int iPrevious = -1;
+    for (int i = 0; i != 5; ++i)
+    {
+        // Markers must occupy distinct positions
+        int iValue = std::clamp((int)std::lround(desired[i] * (numValues - 1)), iPrevious + 1, numValues - 5 + i);
+        q[i] = values[iValue];
+        n[i] = iValue + 1;
+        np[i] = 1.0 + desired[i] * (numValues - 1);
+        dn[i] = desired[i];
+        iPrevious = iValue;
+    }
+    values.clear();
+    values.shrink_to_fit();
+}
+
+//! Height of a marker moved by one position: parabolic prediction, if it keeps the markers ordered, linear one otherwise
+double QuantileEstimator::adjust(int i, int sign) const
+{
+    double parabolic = q[i] + sign / (n[i + 1] - n[i - 1])
+                       * ((n[i] - n[i - 1] + sign) * (q[i + 1] - q[i]) / (n[i + 1] - n[i])
+                          + (n[i + 1] - n[i] - sign) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+    if (q[i - 1] < parabolic && parabolic < q[i + 1])
+        return parabolic;
+    return q[i] + sign * (q[i + sign] - q[i]) / (n[i + sign] - n[i]);
+}
+
+//! Estimated quantile. It is interpolated between order statistics, while the values are kept
+double QuantileEstimator::value() const
+{
+    if (count == 0)
+        return 0.0;
+    if (count >= skNumExactValues)
+    {
+        // The extreme markers track the minimum and maximum exactly
+        if (p == 0.0)
+            return q[0];
+        if (p == 1.0)
+            return q[4];
+        return q[2];
+    }
+    std::vector<double> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+    double position = p * (count - 1);
+    int iLower = std::floor(position);
+    int iUpper = std::min(iLower + 1, count - 1);
+    double weight = position - iLower;
+    return sorted[iLower] * (1.0 - weight) + sorted[iUpper] * weight;
+}
@@ -0,0 +1,120 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the UncertaintyEstimator class
+ */
+
+#ifndef UNCERTAINTYESTIMATOR_H
+#define UNCERTAINTYESTIMATOR_H
+
+#include <vector>
+#include "rodsystem.h"
+
+namespace RSE::Core
+{
+
+//! Standard deviations of parameters of a rod system
+struct Tolerances
+{
+    //! Relative deviation of mass per length
+    double massPerLength = 0.0;
+    //! Relative deviation of Youngs modulus
+    double youngsModulus = 0.0;
+    //! Relative deviation of an area of a cross-section
+    double area = 0.0;
+    //! Absolute deviation of distances between supports, m
+    double distance = 0.0;
+};
+
+//! Statistics of a random quantity
+struct Statistics
+{
+    //! Mean value
+    double mean = 0.0;
+    //! Unbiased variance
+    double variance = 0.0;
+    //! Quantiles associated with the requested probabilities. They are exact for a few samples and estimated by the P-square algorithm otherwise
+    std::vector<double> quantiles;
+};
+
+//! Distributions of the computed parameters of spans
+struct SpansStatistics
+{
+    //! Length of each rod, m
+    std::vector<Statistics> L;
+    //! Projected stretching force, N
+    Statistics projectedForce;
+    //! Number of converged samples
+    int numSamples = 0;
+    //! Number of samples which have not converged
+    int numFailures = 0;
+};
+
+/*!
+ * \brief Streaming estimator of a quantile (P-square algorithm by Jain and Chlamtac)
+ *
+ * The first values are kept, so that the quantile of a few values is exact. Afterwards, five markers placed at
+ * the order statistics of those values are moved as new values arrive, so the memory does not grow with their number
+ */
+struct QuantileEstimator
+{
+    QuantileEstimator(double probability);
+    void add(double value);
+    double value() const;
+    void placeMarkers();
+    double adjust(int i, int sign) const;
+    //! Probability of the quantile
+    double p;
+    //! Number of values added
+    int count = 0;
+    //! Values kept until the markers are placed
+    std::vector<double> values;
+    //! Heights of the markers
+    double q[5];
+    //! Actual positions of the markers
+    double n[5];
+    //! Desired positions of the markers and their increments
+    double np[5];
+    double dn[5];
+};
+
+//! Class to propagate uncertainties of parameters of a rod system through the computation of spans
+class UncertaintyEstimator
+{
+public:
+    UncertaintyEstimator(RodSystem const& rodSystem, Tolerances const& tolerances);
+    ~UncertaintyEstimator() = default;
+    // Get parameters of estimation
+    int numSamples() const { return mNumSamples; }
+    int numThreads() const { return mNumThreads; }
+    unsigned long seed() const { return mSeed; }
+    std::vector<double> const& probabilities() const { return mProbabilities; }
+    // Set parameters of estimation
+    void setNumSamples(int numSamples) { mNumSamples = numSamples; }
+    void setNumThreads(int numThreads) { mNumThreads = numThreads; }
+    void setSeed(unsigned long seed) { mSeed = seed; }
+    void setProbabilities(std::vector<double> const& probabilities) { mProbabilities = probabilities; }
+    // Estimate distributions
+    SpansStatistics estimate();
+
+private:
+    //! Nominal rod system
+    RodSystem mRodSystem;
+    //! Deviations of parameters
+    Tolerances mTolerances;
+    //! Nominal solution used as the initial state for every sample
+    Spans mNominalSpans;
+    //! Number of samples
+    int mNumSamples = 10000;
+    //! Number of threads, the number of cores is used by default
+    int mNumThreads = 0;
+    //! Seed of random generators
+    unsigned long mSeed = 0;
+    //! Probabilities to compute quantiles for
+    std::vector<double> mProbabilities = {0.05, 0.5, 0.95};
+};
+
+}
+
+#endif // UNCERTAINTYESTIMATOR_H
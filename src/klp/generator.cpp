@@ -0,0 +1,228 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the Generator class
+ */
+
+#include <QFile>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "generator.h"
+
+using namespace KLP;
+
+// Layout constants which Result relies on
+static int const skStartIndex   = 17;
+static int const skSizeHeader   = 2;
+static int const skNumBytesRod  = 3;
+static int const skStateLength  = 12;
+static int const skFreqLength   = 9;
+static int const skEnergyLength = 3;
+// Type of the entry which finishes a frame
+static short const skEndFrame   = 0;
+// Type of the entry which starts a frame
+static short const skStartFrame = 1;
+
+// Synthetic geometry and dynamics
+static double const skRodLength    = 10.0;
+static double const skSag          = 0.2;
+static double const skAmplitude    = 1e-2;
+static double const skFrequency    = 1.5;
+
+Generator::Generator(GeneratorOptions const& options)
+    : mOptions(options)
+{
+
+}
+
+//! Creation time and identifier of the result
+QByteArray Generator::header() const
+{
+    QByteArray result(skStartIndex, 0);
+    std::memcpy(result.data(), &mOptions.creationTime, sizeof(mOptions.creationTime));
+    std::memcpy(result.data() + sizeof(mOptions.creationTime), &mOptions.ID, sizeof(mOptions.ID));
+    return result;
+}
+
+//! Entries of a frame. The last frame is terminated, so that readers stop there
+QByteArray Generator::frame(int iFrame) const
+{
+    int const kNumNodes = numNodes();
+    int const kNumModes = mOptions.numModes;
+    int const kSets = mOptions.recordSets;
+    double const kTime = time(iFrame);
+    double const kOmega = 2.0 * M_PI * skFrequency;
+    QByteArray result;
+    // Header which holds time
+    std::vector<float> headerData = {(float)(iFrame + 1), (float)kTime, 0.0f, 0.0f};
+    appendEntry(result, -(short)sizeof(float), skStartFrame, (char const*)headerData.data(), headerData.size());
+    // Number of nodes of each rod
+    QByteArray rods(mOptions.numRods * skNumBytesRod, 0);
+    for (int iRod = 0; iRod != mOptions.numRods; ++iRod)
+        std::memcpy(rods.data() + iRod * skNumBytesRod, &mOptions.numNodesRod, skNumBytesRod);
+    appendEntry(result, 1, RecordType::R, rods.constData(), rods.size());
+    std::vector<double> values(kNumNodes);
+    // Geometry
+    if (kSets & kGeometry)
+    {
+        for (int i = 0; i != kNumNodes; ++i)
+            values[i] = parameter(i);
+        appendEntry(result, RecordType::Xi, values);
+        for (int i = 0; i != kNumNodes; ++i)
+            values[i] = parameter(i) * skRodLength;
+        appendEntry(result, RecordType::S, values);
+        for (int i = 0; i != kNumNodes; ++i)
+            values[i] = (i / mOptions.numNodesRod + parameter(i)) * skRodLength;
+        appendEntry(result, RecordType::SS, values);
+        appendEntry(result, RecordType::X1, values);
+        std::fill(values.begin(), values.end(), 0.0);
+        appendEntry(result, RecordType::X2, values);
+        for (int i = 0; i != kNumNodes; ++i)
+            values[i] = -4.0 * skSag * parameter(i) * (1.0 - parameter(i));
+        appendEntry(result, RecordType::X3, values);
+    }
+    // State vector and its derivatives
+    auto computeState = [&](int order, double phase)
+    {
+        std::vector<double> state(skStateLength * kNumNodes);
+        double factor = std::pow(kOmega, order);
+        for (int i = 0; i != kNumNodes; ++i)
+        {
+            double shape = std::sin(M_PI * parameter(i));
+            for (int k = 0; k != skStateLength; ++k)
+                state[i * skStateLength + k] = factor * skAmplitude * shape * std::sin(kOmega * kTime + order * M_PI_2 + k + phase);
+        }
+        return state;
+    };
+    if (kSets & kState)
+    {
+        std::vector<double> coefficients(NondimensionalType::MAX_NONDIM, 1.0);
+        appendEntry(result, RecordType::ND, coefficients);
+        appendEntry(result, RecordType::U, computeState(0, 0.0));
+        appendEntry(result, RecordType::Ul, computeState(0, 0.5));
+        for (int i = 0; i != kNumNodes; ++i)
+            values[i] = skAmplitude * std::cos(M_PI * parameter(i)) * std::sin(kOmega * kTime);
+        appendEntry(result, RecordType::EPS, values);
+    }
+    if (kSets & kDerivatives)
+    {
+        appendEntry(result, RecordType::Ut, computeState(1, 0.0));
+        appendEntry(result, RecordType::Utt, computeState(2, 0.0));
+    }
+    if (kSets & kErrors)
+    {
+        std::vector<double> errors = computeState(0, 0.0);
+        std::transform(errors.begin(), errors.end(), errors.begin(), [](double value) { return 1e-6 * std::abs(value); });
+        appendEntry(result, RecordType::ERR, errors);
+    }
+    // Modal data
+    if ((kSets & kModal) && kNumModes > 0)
+    {
+        std::vector<double> frequencies(skFreqLength * kNumModes, 0.0);
+        std::vector<double> modes(skStateLength * kNumNodes * kNumModes, 0.0);
+        for (int iMode = 0; iMode != kNumModes; ++iMode)
+        {
+            frequencies[iMode * skFreqLength] = (iMode + 1) * skFrequency;
+            for (int i = 0; i != kNumNodes; ++i)
+            {
+                double shape = std::sin((iMode + 1) * M_PI * parameter(i));
+                for (int k = 0; k != skStateLength; ++k)
+                    modes[(iMode * kNumNodes + i) * skStateLength + k] = k < 3 ? shape : 0.0;
+            }
+        }
+        appendEntry(result, RecordType::MF, frequencies);
+        appendEntry(result, RecordType::MV, modes);
+    }
+    // Energy
+    if (kSets & kEnergy)
+    {
+        std::vector<double> energy(skEnergyLength * mOptions.numRods);
+        for (int iRod = 0; iRod != mOptions.numRods; ++iRod)
+        {
+            double kinetic = std::pow(std::cos(kOmega * kTime), 2);
+            double potential = std::pow(std::sin(kOmega * kTime), 2);
+            energy[iRod * skEnergyLength] = kinetic;
+            energy[iRod * skEnergyLength + 1] = potential;
+            energy[iRod * skEnergyLength + 2] = kinetic + potential;
+        }
+        appendEntry(result, RecordType::EN, energy);
+    }
+    // End of the frame
+    appendEntry(result, -(short)sizeof(float), skEndFrame, nullptr, 0);
+    if (iFrame == mOptions.numFrames - 1)
+        result.back() = 0;
+    return result;
+}
+
+//! Content of the whole file
+QByteArray Generator::generate() const
+{
+    QByteArray result = header();
+    for (int iFrame = 0; iFrame != mOptions.numFrames; ++iFrame)
+        result.append(frame(iFrame));
+    return result;
+}
+
+//! Write the whole file frame by frame, so that large results are never held in memory
+bool Generator::write(QString const& pathFile) const
+{
+    QFile file(pathFile);
+    if (!file.open(QIODeviceBase::WriteOnly))
+        return false;
+    QByteArray content = header();
+    if (file.write(content) != content.size())
+        return false;
+    for (int iFrame = 0; iFrame != mOptions.numFrames; ++iFrame)
+    {
+        content = frame(iFrame);
+        if (file.write(content) != content.size())
+            return false;
+    }
+    return true;
+}
+
+//! Write floating-point values of a record in the requested precision
+void Generator::appendEntry(QByteArray& buffer, RecordType type, std::vector<double> const& values) const
+{
+    if (mOptions.isDoublePrecision)
+    {
+        appendEntry(buffer, -(short)sizeof(double), type, (char const*)values.data(), values.size());
+    }
+    else
+    {
+        std::vector<float> floatValues(values.begin(), values.end());
+        appendEntry(buffer, -(short)sizeof(float), type, (char const*)floatValues.data(), floatValues.size());
+    }
+}
+
+/*!
+ * \brief Write an entry followed by the label of continuation
+ *
+ * An entry consists of the size of elements, which is negative for floating-point ones, the number of elements,
+ * the size of the header which holds the type of the record, the header and the data
+ */
+void Generator::appendEntry(QByteArray& buffer, short elementSize, short type, char const* pData, uint length) const
+{
+    ushort const kSizeHeader = skSizeHeader;
+    char const kLabel = 1;
+    char const kReserved[2] = {0, 0};
+    buffer.append((char const*)&elementSize, sizeof(elementSize));
+    buffer.append((char const*)&length, sizeof(length));
+    buffer.append(kReserved, sizeof(kReserved));
+    buffer.append((char const*)&kSizeHeader, sizeof(kSizeHeader));
+    buffer.append((char const*)&type, sizeof(type));
+    if (length > 0)
+        buffer.append(pData, (qsizetype)std::abs(elementSize) * length);
+    buffer.append(kLabel);
+}
+
+//! Parameter of a node along its rod ranging from zero to unity
+double Generator::parameter(int iNode) const
+{
+    int numNodesRod = mOptions.numNodesRod;
+    if (numNodesRod < 2)
+        return 0.0;
+    return (double)(iNode % numNodesRod) / (numNodesRod - 1);
+}
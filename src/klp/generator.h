@@ -0,0 +1,79 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the Generator class
+ */
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <QByteArray>
+#include <QString>
+#include <vector>
+#include "types.h"
+
+namespace KLP
+{
+
+//! Groups of records written to each frame
+enum RecordSet
+{
+    kGeometry    = 1,  // Parameter, natural lengths and coordinates
+    kState       = 2,  // State vector, its projection, strain and nondimensional coefficients
+    kDerivatives = 4,  // Derivatives of the state vector with respect to time
+    kModal       = 8,  // Eigenfrequencies and eigenvectors
+    kEnergy      = 16, // Energy of rods
+    kErrors      = 32, // Computational errors of the state vector
+    kAllRecords  = 63
+};
+
+//! Shape of a synthetic result
+struct GeneratorOptions
+{
+    int numRods = 4;
+    int numNodesRod = 10;
+    int numFrames = 10;
+    int numModes = 6;
+    //! Combination of record sets
+    int recordSets = kGeometry | kState;
+    //! Write values in double precision, as the solver does for some records
+    bool isDoublePrecision = false;
+    double timeStep = 1e-2;
+    //! Creation time written to the header, s since the epoch. It is fixed, so that generated files are reproducible
+    double creationTime = 0.0;
+    uint ID = 1;
+};
+
+/*!
+ * \brief Writer of synthetic KLP files
+ *
+ * Frames are laid out as the solver does: a header entry holding time, entries of the requested records and an entry
+ * which marks the end of the frame. Values are deterministic functions of nodes, modes and time,
+ * so that results are reproducible. Frames can be appended one by one to imitate a growing file.
+ */
+class Generator
+{
+public:
+    Generator(GeneratorOptions const& options);
+    ~Generator() = default;
+    GeneratorOptions const& options() const { return mOptions; }
+    int numNodes() const { return mOptions.numRods * mOptions.numNodesRod; }
+    double time(int iFrame) const { return iFrame * mOptions.timeStep; }
+    QByteArray header() const;
+    QByteArray frame(int iFrame) const;
+    QByteArray generate() const;
+    bool write(QString const& pathFile) const;
+
+private:
+    void appendEntry(QByteArray& buffer, RecordType type, std::vector<double> const& values) const;
+    void appendEntry(QByteArray& buffer, short elementSize, short type, char const* pData, uint length) const;
+    double parameter(int iNode) const;
+
+private:
+    GeneratorOptions const mOptions;
+};
+
+}
+
+#endif // GENERATOR_H
@@ -26,6 +26,7 @@ struct IndexData
     qint64 step = 1;
     //! Partial length of a quantity inside a record
     qint64 partSize = 0;
+    bool operator==(IndexData const& another) const = default;
 };
 
 //! Structure to navigate through records
@@ -39,6 +40,7 @@ struct Index
     quint64 recordShift = 0;
     //! Relative shift of data
     quint64 relativeDataShift = 0;
+    bool operator==(Index const& another) const = default;
 };
 
 }
@@ -6,6 +6,7 @@ HEADERS += \
     $$PWD/framecollection.h \
     $$PWD/frameobject.h \
     $$PWD/frameobjectiterator.h \
+    $$PWD/generator.h \
     $$PWD/index.h \
     $$PWD/result.h \
     $$PWD/types.h
@@ -13,4 +14,5 @@ HEADERS += \
 SOURCES += \
     $$PWD/frameobject.cpp \
     $$PWD/frameobjectiterator.cpp \
+    $$PWD/generator.cpp \
     $$PWD/result.cpp
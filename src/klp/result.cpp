@@ -8,16 +8,40 @@
 #include <QFile>
 #include <QDateTime>
 #include <QFileInfo>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <algorithm>
 #include "result.h"
 
 using namespace KLP;
 
-Result::Result(QString const& pathFile)
+static quint32 const skIndexSignature = 0x4B4C5049; // KLPI
+static quint32 const skIndexVersion   = 1;
+//! Number of bytes at the beginning of a file which are hashed to detect its changes
+static qint64 const skNumHashedBytes  = 4096;
+
+Result::Result(QString const& pathFile, int options)
     : mkPathFile(pathFile)
+    , mkOptions(options)
 {
     update();
 }
 
+/*!
+ * \brief Read the changes of the file which the base result has been read from
+ *
+ * The complete records of the base result are reused, if the file has grown. Otherwise, the file is read anew
+ */
+Result::Result(Result const& base, Change change)
+    : mkPathFile(base.mkPathFile)
+    , mkOptions(base.mkOptions)
+{
+    if (change == kAppended && readAppended(base))
+        buildIndex(&base);
+    else
+        update();
+}
+
 //! Get the object associated with the requested frame
 FloatFrameObject Result::getFrameObject(qint64 iFrame, RecordType type, float normFactor, qint64 shift) const
 {
@@ -30,11 +54,19 @@ FloatFrameObject Result::getFrameObject(qint64 iFrame, RecordType type, float no
     if (indexData.position == 0)
         return nullFrameObject;
     // Construct the resulting object
-    unsigned char* pBuffer = (unsigned char*) mContent.data();
-    float* pData = (float*)&pBuffer[indexData.position] + shift;
+    float const* pData = floatData(indexData.position) + shift;
     return FloatFrameObject(pData, normFactor, indexData.partSize, indexData.step);
 }
 
+//! Get the values of single precision which a record holds, the converted ones are taken from their buffer
+float const* Result::floatData(qint64 position) const
+{
+    auto iter = mConvertedData.find(position);
+    if (iter != mConvertedData.end())
+        return iter->second.data();
+    return (float const*)&buffer()[position];
+}
+
 //! Specify state data for each direction
 void Result::setStateFrameData(StateFrame& state, RecordType type, qint64 iFrame, qint64 iStartData,
                                std::vector<float> const& normFactors) const
@@ -101,19 +133,125 @@ FrameCollection Result::getFrameCollection(qint64 iFrame) const
     return collection;
 }
 
-//! Read all the content of the file
+//! Read all the content of the file or map it to memory
 bool Result::read()
 {
+    // The mapped content must be released before the file is unmapped
+    mContent.clear();
+    mConvertedData.clear();
+    mpMappedFile.reset();
+    std::unique_ptr<QFile> pFile = std::make_unique<QFile>(mkPathFile);
+    if (!pFile->open(QIODeviceBase::ReadOnly))
+    {
+        mStamp = FileStamp();
+        return false;
+    }
+    // The file is stamped beforehand, so that the changes made while it is being read are detected afterwards
+    mStamp = stampFile(*pFile);
+    qint64 size = pFile->size();
+    uchar* pMapped = (mkOptions & kMapped) && size > 0 ? pFile->map(0, size) : nullptr;
+    if (pMapped)
+    {
+        mContent = QByteArray::fromRawData((char const*)pMapped, size);
+        mpMappedFile = std::move(pFile);
+    }
+    else
+    {
+        mContent = pFile->readAll();
+    }
+    return true;
+}
+
+/*!
+ * \brief Read the data appended to the file after the complete records of the base result
+ *
+ * The incomplete record is read again, since it may have been changed. Records converted in place cannot be scanned
+ * again, so such content is read anew. Mapped files are mapped anew as well, since only the pages accessed are loaded
+ */
+bool Result::readAppended(Result const& base)
+{
+    if ((mkOptions & kMapped) || base.mIsConverted || base.mNumCompleteBytes == 0)
+        return false;
     QFile file(mkPathFile);
     if (!file.open(QIODeviceBase::ReadOnly))
         return false;
-    mContent = file.readAll();
-    file.close();
+    mStamp = stampFile(file);
+    if (!file.seek(base.mNumCompleteBytes))
+        return false;
+    mContent = base.mContent.left(base.mNumCompleteBytes);
+    mContent.append(file.readAll());
     return true;
 }
 
-//! Construct an object to navigate through records
-void Result::buildIndex()
+//! Take the size and modification time of a file along with the hash of its beginning
+Result::FileStamp Result::stampFile(QFile& file)
+{
+    FileStamp stamp;
+    stamp.size = file.size();
+    stamp.modified = QFileInfo(file).lastModified().toMSecsSinceEpoch();
+    stamp.headerHash = hashHeader(file, stamp.size);
+    return stamp;
+}
+
+//! Hash the beginning of a file which is never changed, while the file is growing
+QByteArray Result::hashHeader(QFile& file, qint64 size)
+{
+    if (!file.seek(0))
+        return QByteArray();
+    QByteArray header = file.read(std::min(skNumHashedBytes, size));
+    file.seek(0);
+    return QCryptographicHash::hash(header, QCryptographicHash::Sha256);
+}
+
+/*!
+ * \brief Detect changes of the file since it has been read
+ *
+ * A file which is not available is considered to be modified, so that reloading clears the content
+ */
+Result::Change Result::checkChange() const
+{
+    QFile file(mkPathFile);
+    if (mStamp.size < 0 || !file.open(QIODeviceBase::ReadOnly))
+        return kModified;
+    qint64 size = file.size();
+    if (size < mStamp.size || hashHeader(file, mStamp.size) != mStamp.headerHash)
+        return kModified;
+    if (size > mStamp.size)
+        return kAppended;
+    if (QFileInfo(file).lastModified().toMSecsSinceEpoch() != mStamp.modified)
+        return kModified;
+    return kUnchanged;
+}
+
+//! Read the changes into a new object, leaving this one intact
+std::unique_ptr<Result> Result::reload(Change change) const
+{
+    return std::unique_ptr<Result>(new Result(*this, change));
+}
+
+//! Exchange the states of results read from the same file
+void Result::swap(Result& other)
+{
+    std::swap(mpMappedFile, other.mpMappedFile);
+    mContent.swap(other.mContent);
+    mConvertedData.swap(other.mConvertedData);
+    mIndex.swap(other.mIndex);
+    std::swap(mNumTotalRecords, other.mNumTotalRecords);
+    mTime.swap(other.mTime);
+    std::swap(mNumBytesRod, other.mNumBytesRod);
+    std::swap(mIsConverted, other.mIsConverted);
+    std::swap(mStamp, other.mStamp);
+    std::swap(mNumCompleteBytes, other.mNumCompleteBytes);
+    std::swap(mLastFrameState, other.mLastFrameState);
+}
+
+/*!
+ * \brief Construct an object to navigate through records
+ *
+ * The frames preceding the last complete one are final, so they are taken from the base result, if it is specified,
+ * and the content is scanned from the header of its last complete frame on
+ */
+void Result::buildIndex(Result const* pBase)
 {
     // Reading constants
     const int kStartIndex      = 17;
@@ -123,18 +261,25 @@ void Result::buildIndex()
     const short kSizeFloat     = sizeof(float);
 
     // Slice the content data
-    unsigned char* pBuffer = (unsigned char*) mContent.data();
+    unsigned char* pBuffer = buffer();
     qint64 numBuffer = mContent.size();
+    mIsConverted = false;
+    mConvertedData.clear();
+    bool isResumed = pBase && pBase->mLastFrameState.position > 0;
+    ScanState resumeState = isResumed ? pBase->mLastFrameState : ScanState{kStartIndex, 0, 0, 0};
+    qint64 numResumedFrames = resumeState.numTimeOld;
 
     // Count the number of records
-    mNumTotalRecords = 0;
-    qint64 iStartEntry = kStartIndex;
+    mNumTotalRecords = resumeState.numRecords;
+    mNumCompleteBytes = isResumed ? resumeState.position : 0;
+    mLastFrameState = resumeState;
+    qint64 iStartEntry = resumeState.position;
     qint64 jEndEntry = 0;
     short* pStartEntry;
     short* pRecordType;
     uint* pLengthEntry;
     ushort* pHeaderLine;
-    ulong numTime = 0, numTimeOld = 0;
+    ulong numTime = resumeState.numTime, numTimeOld = resumeState.numTimeOld;
     while (iStartEntry < numBuffer)
     {
         ++mNumTotalRecords;
@@ -144,6 +289,7 @@ void Result::buildIndex()
         jEndEntry = iStartEntry + kShiftNumRecords + *pHeaderLine + abs(*pStartEntry) * (qint64) * pLengthEntry;
         if (jEndEntry >= numBuffer)
             break;
+        mNumCompleteBytes = jEndEntry + 1;
         if (*pHeaderLine >= 2)
         {
             pRecordType = (short*)&pBuffer[iStartEntry + kShiftNumRecords];
@@ -152,7 +298,10 @@ void Result::buildIndex()
                 numTime = numTime + 1;
             // Old versions of the KLP file
             if (*pRecordType == 1)
+            {
+                mLastFrameState = {iStartEntry, mNumTotalRecords - 1, (qint64)numTime, (qint64)numTimeOld};
                 numTimeOld = numTimeOld + 1;
+            }
         }
         // Label of the last entry
         if (pBuffer[jEndEntry] == 0)
@@ -162,19 +311,28 @@ void Result::buildIndex()
     if (numTime == 0)
         numTime = numTimeOld;
 
-    // Alocate the mapping structure
-    mNumBytesRod = 3;
+    // Alocate the mapping structure, keeping the frames which are taken from the base result
+    mNumBytesRod = numResumedFrames > 0 ? pBase->mNumBytesRod : 3;
+    if (numResumedFrames > 0)
+    {
+        mIndex.assign(pBase->mIndex.begin(), pBase->mIndex.begin() + numResumedFrames);
+        mTime = pBase->mTime;
+    }
+    else
+    {
+        mIndex.clear();
+    }
     mIndex.resize(mNumTotalRecords);
 
     // Fill in the mapping structure
-    qint64 kk = 0;
+    qint64 kk = numResumedFrames;
     qint64 iRecord = 0;
     qint64 iStartData;
     int iType;
     double* pDoubleValue;
     float* pFloatValue;
-    iStartEntry = kStartIndex;
-    for (qint64 k = 0; k != mNumTotalRecords; ++k)
+    iStartEntry = resumeState.position;
+    for (qint64 k = resumeState.numRecords; k != mNumTotalRecords; ++k)
     {
         pStartEntry = (short*)&pBuffer[iStartEntry];
         pLengthEntry = (uint*)&pBuffer[iStartEntry + 2];
@@ -194,14 +352,22 @@ void Result::buildIndex()
                     mNumBytesRod = 4;
                 ++kk;
             }
-            // Convert double to float, if necessary
+            // Convert double to float, if necessary. The mapped content is read-only, so it is converted into a separate buffer
             if (*pStartEntry == -kSizeDouble)
             {
-                *pStartEntry = -kSizeFloat;
+                mIsConverted = true;
                 pDoubleValue = (double*)&pBuffer[iStartData];
-                pFloatValue = (float*)&pBuffer[iStartData];
-                for (qint64 i = 0; i != *pLengthEntry; ++i)
-                    pFloatValue[i] = (float)pDoubleValue[i];
+                if (mpMappedFile)
+                {
+                    mConvertedData[iStartData].assign(pDoubleValue, pDoubleValue + *pLengthEntry);
+                }
+                else
+                {
+                    *pStartEntry = -kSizeFloat;
+                    pFloatValue = (float*)&pBuffer[iStartData];
+                    for (qint64 i = 0; i != *pLengthEntry; ++i)
+                        pFloatValue[i] = (float)pDoubleValue[i];
+                }
             }
             // Assign the record
             iRecord = kk - 1;
@@ -240,7 +406,7 @@ void Result::buildIndex()
     }
 
     // Truncate partial sizes for eigenvectors
-    for (int i = 0; i != mNumTotalRecords; ++i)
+    for (qint64 i = numResumedFrames; i != mNumTotalRecords; ++i)
     {
         bool isFrequencies = mIndex[i].data[RecordType::MF].position != 0;
         bool isModeshapes  = mIndex[i].data[RecordType::MV].position != 0;
@@ -249,7 +415,7 @@ void Result::buildIndex()
     }
 
     // If the current frame does not contain data, redirect it to the previous one
-    for (int iRecord = 1; iRecord != mNumTotalRecords; ++iRecord)
+    for (qint64 iRecord = std::max<qint64>(numResumedFrames, 1); iRecord < mNumTotalRecords; ++iRecord)
     {
         for (int jType = 0; jType != RecordType::MAX_RECORD; ++jType)
         {
@@ -259,13 +425,10 @@ void Result::buildIndex()
     }
 
     // Retrieve time steps
+    ulong iFirstTime = std::min<ulong>(numResumedFrames, std::min<ulong>(numTime, mTime.size()));
     mTime.resize(numTime);
-    float* pValue;
-    for (ulong i = 0; i != numTime; ++i)
-    {
-        pValue = (float*)&pBuffer[mIndex[i].recordShift + mIndex[i].relativeDataShift + kShiftTime];
-        mTime[i] = *pValue;
-    }
+    for (ulong i = iFirstTime; i != numTime; ++i)
+        mTime[i] = floatData(mIndex[i].recordShift + mIndex[i].relativeDataShift)[kShiftTime / kSizeFloat];
 }
 
 //! Retrieve the updated content from the file
@@ -273,12 +436,29 @@ void Result::update()
 {
     if (read())
     {
-        buildIndex();
+        // Scanning a mapped file loads all its pages, so the saved index is preferred, unless values have to be converted
+        IndexState state;
+        if ((mkOptions & kUseIndexFile) && readIndex(indexPathFile(mkPathFile), state) && !state.isConverted)
+        {
+            mIndex = std::move(state.index);
+            mTime = std::move(state.time);
+            mNumTotalRecords = state.numTotalRecords;
+            mNumBytesRod = state.numBytesRod;
+            mIsConverted = false;
+            mNumCompleteBytes = 0;
+            mLastFrameState = ScanState();
+        }
+        else
+        {
+            buildIndex();
+        }
     }
     else
     {
         mContent.clear();
         mIndex.clear();
+        mNumCompleteBytes = 0;
+        mLastFrameState = ScanState();
     }
 }
 
@@ -290,7 +470,7 @@ ResultInfo Result::info() const
     if (mContent.isEmpty())
         return infoData;
     // Retrieve the buffer
-    unsigned char* pBuffer = (unsigned char*) mContent.data();
+    unsigned char* pBuffer = buffer();
     // Creation date
     double* pValue = (double*)&pBuffer[0];
     time_t rawTime = (time_t) * pValue;
@@ -323,3 +503,99 @@ QString Result::name() const
 {
     return QFileInfo(mkPathFile).baseName();
 }
+
+/*!
+ * \brief Save the index to a sidecar file
+ *
+ * The file is identified by its size and modification time, so that the index is not used once the file is changed.
+ * Only the records present in a frame are saved
+ */
+bool Result::writeIndex(QString const& pathFile) const
+{
+    if (mContent.isEmpty())
+        return false;
+    QFile file(pathFile);
+    if (!file.open(QIODeviceBase::WriteOnly))
+        return false;
+    QDataStream stream(&file);
+    QFileInfo info(mkPathFile);
+    stream << skIndexSignature << skIndexVersion << (qint64)mContent.size() << info.lastModified().toMSecsSinceEpoch();
+    stream << mNumTotalRecords << (qint8)mNumBytesRod << mIsConverted << (quint64)mIndex.size();
+    for (Index const& index : mIndex)
+    {
+        stream << index.recordShift << index.relativeDataShift;
+        auto isPresent = [](IndexData const& data) { return data.position != 0; };
+        stream << (quint8)std::count_if(index.data.begin(), index.data.end(), isPresent);
+        for (int iType = 0; iType != RecordType::MAX_RECORD; ++iType)
+        {
+            IndexData const& data = index.data[iType];
+            if (isPresent(data))
+                stream << (quint8)iType << data.position << data.size << data.step << data.partSize;
+        }
+    }
+    stream << (quint64)mTime.size();
+    for (double time : mTime)
+        stream << time;
+    return stream.status() == QDataStream::Ok;
+}
+
+//! Check if the sidecar file matches the index, which should be built by scanning the file
+bool Result::verifyIndex(QString const& pathFile) const
+{
+    IndexState state;
+    if (mContent.isEmpty() || !readIndex(pathFile, state))
+        return false;
+    return state.numTotalRecords == mNumTotalRecords && state.numBytesRod == mNumBytesRod && state.isConverted == mIsConverted
+           && state.index == mIndex && state.time == mTime;
+}
+
+//! Read the index from a sidecar file, if it has been saved for the current state of the file
+bool Result::readIndex(QString const& pathFile, IndexState& state) const
+{
+    const qint64 kMinSizeEntry = 11;
+
+    QFile file(pathFile);
+    if (!file.open(QIODeviceBase::ReadOnly))
+        return false;
+    QDataStream stream(&file);
+    QFileInfo info(mkPathFile);
+    qint64 fileSize = mContent.size();
+    // Header
+    quint32 signature, version;
+    qint64 size, modified;
+    qint8 numBytesRod;
+    quint64 numIndex;
+    stream >> signature >> version >> size >> modified >> state.numTotalRecords >> numBytesRod >> state.isConverted >> numIndex;
+    if (stream.status() != QDataStream::Ok || signature != skIndexSignature || version != skIndexVersion || size != fileSize
+        || size != info.size() || modified != info.lastModified().toMSecsSinceEpoch() || numIndex > (quint64)(fileSize / kMinSizeEntry)
+        || state.numTotalRecords < 0 || (quint64)state.numTotalRecords != numIndex)
+        return false;
+    state.numBytesRod = numBytesRod;
+    // Records, which must not point outside the file
+    state.index.resize(numIndex);
+    for (Index& index : state.index)
+    {
+        quint8 numTypes;
+        stream >> index.recordShift >> index.relativeDataShift >> numTypes;
+        for (quint8 i = 0; i != numTypes && stream.status() == QDataStream::Ok; ++i)
+        {
+            quint8 iType;
+            IndexData data;
+            stream >> iType >> data.position >> data.size >> data.step >> data.partSize;
+            if (iType >= RecordType::MAX_RECORD || data.position <= 0 || data.size < 0 || data.step <= 0 || data.partSize < 0
+                || data.position + data.size * (qint64)sizeof(float) > fileSize)
+                return false;
+            index.data[iType] = data;
+        }
+        if (stream.status() != QDataStream::Ok)
+            return false;
+    }
+    quint64 numTime;
+    stream >> numTime;
+    if (stream.status() != QDataStream::Ok || numTime > numIndex)
+        return false;
+    state.time.resize(numTime);
+    for (double& time : state.time)
+        stream >> time;
+    return stream.status() == QDataStream::Ok;
+}
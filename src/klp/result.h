@@ -10,9 +10,13 @@
 
 #include <QString>
 #include <QDateTime>
+#include <map>
+#include <memory>
 #include "index.h"
 #include "framecollection.h"
 
+class QFile;
+
 namespace KLP
 {
 
@@ -25,11 +29,37 @@ struct ResultInfo
     uint ID = -1;
 };
 
-//! Class to aggregate all the records
+/*!
+ * \brief Class to aggregate all the records
+ *
+ * The content is either read entirely or mapped to memory read-only, so that only the pages accessed are loaded.
+ * Values of double precision are converted to single precision in place, if the content is read entirely. The pages of
+ * a mapped file are never written, so its values are converted into a separate buffer per record instead.
+ * A mapped file cannot be truncated on Windows while it is in use, so results of running solutions should be read entirely.
+ * The index can be saved to a sidecar file, which is used instead of scanning the file, as long as the file is intact.
+ * Changes of the file are detected by its size, modification time and the hash of its beginning. A file which grows
+ * is reloaded by reading only the data which follows the complete records and indexing it from the last complete frame,
+ * unless its values have been converted.
+ * Reloading builds a new object, so that the current one stays intact until the new state is swapped in
+ */
 class Result
 {
 public:
-    explicit Result(QString const& pathFile);
+    //! Options of reading
+    enum ReadOption
+    {
+        kReadAll      = 0,
+        kMapped       = 1,
+        kUseIndexFile = 2
+    };
+    //! Changes of the file since it has been read
+    enum Change
+    {
+        kUnchanged,
+        kAppended,
+        kModified
+    };
+    explicit Result(QString const& pathFile, int options = kReadAll);
     ~Result() = default;
     bool isEmpty() const { return mContent.isEmpty(); }
     QVector<double> const& time() const { return mTime; }
@@ -39,18 +69,61 @@ public:
     qint64 numTotalRecords() const { return mNumTotalRecords; }
     qint64 numTimeRecords() const { return mTime.size(); }
     ResultInfo info() const;
+    bool isMapped() const { return mpMappedFile != nullptr; }
+    std::vector<Index> const& index() const { return mIndex; }
+    bool writeIndex(QString const& pathFile) const;
+    bool verifyIndex(QString const& pathFile) const;
+    static QString indexPathFile(QString const& pathFile) { return pathFile + ".idx"; }
     FrameCollection getFrameCollection(qint64 iFrame) const;
     void update();
+    Change checkChange() const;
+    std::unique_ptr<Result> reload(Change change) const;
+    void swap(Result& other);
 
 private:
+    //! Navigation data which is saved to a sidecar file
+    struct IndexState
+    {
+        std::vector<Index> index;
+        QVector<double> time;
+        qint64 numTotalRecords = 0;
+        char numBytesRod = 3;
+        bool isConverted = false;
+    };
+    //! State of scanning at the header of the last complete frame, which the index is resumed from once data is appended
+    struct ScanState
+    {
+        qint64 position = 0;
+        qint64 numRecords = 0;
+        qint64 numTime = 0;
+        qint64 numTimeOld = 0;
+    };
+    //! State of the file at the moment it has been read
+    struct FileStamp
+    {
+        qint64 size = -1;
+        qint64 modified = 0;
+        QByteArray headerHash;
+    };
+    Result(Result const& base, Change change);
     bool read();
-    void buildIndex();
+    bool readAppended(Result const& base);
+    static FileStamp stampFile(QFile& file);
+    static QByteArray hashHeader(QFile& file, qint64 size);
+    void buildIndex(Result const* pBase = nullptr);
+    bool readIndex(QString const& pathFile, IndexState& state) const;
+    unsigned char* buffer() const { return (unsigned char*)mContent.constData(); }
+    float const* floatData(qint64 position) const;
     void setStateFrameData(StateFrame& state, RecordType type, qint64 iFrame, qint64 iStartData, std::vector<float> const& normFactors) const;
     FloatFrameObject getFrameObject(qint64 iFrame, RecordType type, float normFactor = 1.0f, qint64 shift = 0) const;
 
 private:
     //! Path to the KLP file
     QString const mkPathFile;
+    //! Combination of the options of reading
+    int const mkOptions;
+    //! File which content is mapped to memory
+    std::unique_ptr<QFile> mpMappedFile;
     //! Content of the file
     QByteArray mContent;
     //! Index of the data buffer
@@ -61,6 +134,16 @@ private:
     QVector<double> mTime;
     //! Number of bytes per rod
     char mNumBytesRod;
+    //! Flag which indicates whether values of double precision have been converted
+    bool mIsConverted = false;
+    //! Values of double precision of the mapped content converted to single precision, keyed by the positions of records
+    std::map<qint64, std::vector<float>> mConvertedData;
+    //! State of the file which the content has been read from
+    FileStamp mStamp;
+    //! Number of bytes occupied by the header and the complete records
+    qint64 mNumCompleteBytes = 0;
+    //! State of scanning which the index is resumed from
+    ScanState mLastFrameState;
 };
 
 }
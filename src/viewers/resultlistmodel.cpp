@@ -8,25 +8,94 @@
 #include <QFileInfo>
 #include <QListView>
 #include <QColorDialog>
+#include <QThreadPool>
+#include <QPromise>
+#include <atomic>
 #include "apputilities.h"
 #include "resultlistmodel.h"
 #include "klp/result.h"
 
 using namespace RSE::Models;
 
+//! Results being read concurrently, which are shared with the tasks, so that they stay alive until all of them are read
+struct ResultListModel::Update
+{
+    KLP::Results results;
+    std::vector<std::unique_ptr<KLP::Result>> updatedResults;
+    std::atomic<int> numRemaining;
+    QPromise<void> promise;
+};
+
 ResultListModel::ResultListModel(KLP::Results& results, QObject* pParent)
     : QStandardItemModel(pParent), mResults(results)
 {
+    mpUpdateWatcher = new QFutureWatcher<void>(this);
+    connect(mpUpdateWatcher, &QFutureWatcher<void>::finished, this, &ResultListModel::completeUpdate);
     specifyConnections();
     updateContent();
 }
 
-//! Update results from files
+/*!
+ * \brief Start updating results from files
+ *
+ * Only the files which have changed are read, concurrently and without blocking the caller. The new states are swapped in
+ * once all of them are read, so that the results are never seen partially updated. An update requested meanwhile is
+ * started once the current one is completed
+ */
 void ResultListModel::updateData()
 {
-    for (auto& result : mResults)
-        result->update();
-    emit resultsUpdated();
+    if (mpUpdate)
+    {
+        mIsUpdateRequested = true;
+        return;
+    }
+    int numResults = mResults.size();
+    if (numResults == 0)
+        return;
+    mpUpdate = std::make_shared<Update>();
+    mpUpdate->results = mResults;
+    mpUpdate->updatedResults.resize(numResults);
+    mpUpdate->numRemaining = numResults;
+    mpUpdate->promise.start();
+    mpUpdateWatcher->setFuture(mpUpdate->promise.future());
+    for (int i = 0; i != numResults; ++i)
+    {
+        QThreadPool::globalInstance()->start([pUpdate = mpUpdate, i]()
+        {
+            KLP::Result const* pResult = pUpdate->results[i].get();
+            KLP::Result::Change change = pResult->checkChange();
+            if (change != KLP::Result::kUnchanged)
+                pUpdate->updatedResults[i] = pResult->reload(change);
+            // The last task reports the completion
+            if (--pUpdate->numRemaining == 0)
+                pUpdate->promise.finish();
+        });
+    }
+}
+
+//! Swap in the new states of results once all of them are read
+void ResultListModel::completeUpdate()
+{
+    std::shared_ptr<Update> pUpdate = std::move(mpUpdate);
+    if (!pUpdate)
+        return;
+    bool isUpdated = false;
+    int numResults = pUpdate->results.size();
+    for (int i = 0; i != numResults; ++i)
+    {
+        if (pUpdate->updatedResults[i])
+        {
+            pUpdate->results[i]->swap(*pUpdate->updatedResults[i]);
+            isUpdated = true;
+        }
+    }
+    if (isUpdated)
+        emit resultsUpdated();
+    if (mIsUpdateRequested)
+    {
+        mIsUpdateRequested = false;
+        updateData();
+    }
 }
 
 //! Create items linked to results
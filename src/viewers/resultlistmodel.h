@@ -9,6 +9,8 @@
 #define RESULTLISTMODEL_H
 
 #include <QStandardItemModel>
+#include <QFutureWatcher>
+#include <memory>
 #include "klp/aliasklp.h"
 
 namespace RSE
@@ -33,6 +35,8 @@ signals:
     void resultsUpdated();
 
 private:
+    struct Update;
+    void completeUpdate();
     void clearContent();
     QColor getAvailableColor();
     void specifyConnections();
@@ -40,6 +44,12 @@ private:
 private:
     KLP::Results& mResults;
     QMap<KLP::Result*, QColor> mResultColors;
+    //! Watcher of the results being read
+    QFutureWatcher<void>* mpUpdateWatcher;
+    //! Results being read along with their new states
+    std::shared_ptr<Update> mpUpdate;
+    //! Flag which indicates whether another update has been requested while the results are being read
+    bool mIsUpdateRequested = false;
 };
 
 }
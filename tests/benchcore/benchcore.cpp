@@ -0,0 +1,230 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Benchmarks of the core functionality
+ */
+
+#include <QtTest/QTest>
+#include "core/array.h"
+#include "core/vectordataobject.h"
+#include "core/prnwriter.h"
+#include "core/prnreader.h"
+
+using namespace RSE::Core;
+
+class BenchCore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void constructArray_data();
+    void constructArray();
+    void copyArray_data();
+    void copyArray();
+    void resizeArray_data();
+    void resizeArray();
+    void removeArrayColumn_data();
+    void removeArrayColumn();
+    void serializeDataObject_data();
+    void serializeDataObject();
+    void writeDataObject_data();
+    void writeDataObject();
+    void importDataObject_data();
+    void importDataObject();
+
+private:
+    void addArraySizes();
+};
+
+//! Specify the shapes of arrays to benchmark
+void BenchCore::addArraySizes()
+{
+    QTest::addColumn<IndexType>("numRows");
+    QTest::addColumn<IndexType>("numCols");
+    QTest::newRow("1x1") << 1u << 1u;
+    QTest::newRow("1x3") << 1u << 3u;
+    QTest::newRow("3x3") << 3u << 3u;
+    QTest::newRow("32x32") << 32u << 32u;
+    QTest::newRow("1000x100") << 1000u << 100u;
+}
+
+void BenchCore::constructArray_data()
+{
+    addArraySizes();
+}
+
+//! Construct arrays filled with zeros
+void BenchCore::constructArray()
+{
+    QFETCH(IndexType, numRows);
+    QFETCH(IndexType, numCols);
+    QBENCHMARK
+    {
+        Array<double> array(numRows, numCols);
+        QVERIFY(array.data()[array.size() - 1] == 0.0);
+    }
+}
+
+void BenchCore::copyArray_data()
+{
+    addArraySizes();
+}
+
+//! Copy an array to a new and existing one
+void BenchCore::copyArray()
+{
+    QFETCH(IndexType, numRows);
+    QFETCH(IndexType, numCols);
+    Array<double> source(numRows, numCols);
+    Array<double> target;
+    QBENCHMARK
+    {
+        Array<double> copy(source);
+        target = copy;
+    }
+}
+
+void BenchCore::resizeArray_data()
+{
+    addArraySizes();
+}
+
+//! Shrink and expand an array
+void BenchCore::resizeArray()
+{
+    QFETCH(IndexType, numRows);
+    QFETCH(IndexType, numCols);
+    Array<double> array(numRows, numCols);
+    QBENCHMARK
+    {
+        array.resize(numRows, numCols + 1);
+        array.resize(numRows, numCols);
+    }
+}
+
+void BenchCore::removeArrayColumn_data()
+{
+    addArraySizes();
+}
+
+//! Remove the first column of an array
+void BenchCore::removeArrayColumn()
+{
+    QFETCH(IndexType, numRows);
+    QFETCH(IndexType, numCols);
+    Array<double> array;
+    QBENCHMARK
+    {
+        array.resize(numRows, numCols + 1);
+        array.removeColumn(0);
+    }
+}
+
+void BenchCore::serializeDataObject_data()
+{
+    QTest::addColumn<int>("numItems");
+    QTest::newRow("10") << 10;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("100000") << 100000;
+}
+
+//! Write a vector data object to a binary stream and read it back
+void BenchCore::serializeDataObject()
+{
+    QFETCH(int, numItems);
+    VectorDataObject dataObject("Vector");
+    for (int i = 0; i != numItems; ++i)
+        dataObject.addItem(i)[0][1] = i;
+    QBENCHMARK
+    {
+        QByteArray bytes;
+        QDataStream outStream(&bytes, QIODevice::WriteOnly);
+        outStream << dataObject;
+        QDataStream inStream(bytes);
+        quint32 type;
+        QString name;
+        inStream >> type >> name;
+        VectorDataObject readObject(name);
+        readObject.deserialize(inStream);
+    }
+}
+
+void BenchCore::writeDataObject_data()
+{
+    QTest::addColumn<int>("numItems");
+    QTest::addColumn<bool>("isFormatter");
+    for (int numItems : {1000, 100000})
+    {
+        QTest::newRow(qPrintable(QString("stream %1").arg(numItems))) << numItems << false;
+        QTest::newRow(qPrintable(QString("formatter %1").arg(numItems))) << numItems << true;
+    }
+}
+
+//! Format a vector data object by means of the text stream and fast formatter
+void BenchCore::writeDataObject()
+{
+    int const kFieldWidth = 30;
+    QFETCH(int, numItems);
+    QFETCH(bool, isFormatter);
+    VectorDataObject dataObject("Vector");
+    for (int i = 0; i != numItems; ++i)
+    {
+        DataItemType item = dataObject.addItem(i);
+        for (IndexType j = 0; j != 3; ++j)
+            item[0][j] = (i + 1.0) / (j + 3.0);
+    }
+    if (isFormatter)
+    {
+        PrnWriter writer(kFieldWidth);
+        QBENCHMARK
+        {
+            writer.clear();
+            dataObject.write(writer);
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            QByteArray bytes;
+            QTextStream stream(&bytes);
+            stream.setFieldAlignment(QTextStream::AlignRight);
+            stream.setFieldWidth(kFieldWidth);
+            dataObject.write(stream);
+            stream.flush();
+        }
+    }
+}
+
+void BenchCore::importDataObject_data()
+{
+    QTest::addColumn<int>("numItems");
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("100000") << 100000;
+}
+
+//! Parse a vector data object from a text buffer
+void BenchCore::importDataObject()
+{
+    QFETCH(int, numItems);
+    VectorDataObject dataObject("Vector");
+    for (int i = 0; i != numItems; ++i)
+    {
+        DataItemType item = dataObject.addItem(i);
+        for (IndexType j = 0; j != 3; ++j)
+            item[0][j] = (i + 1.0) / (j + 3.0);
+    }
+    PrnWriter writer(30);
+    dataObject.write(writer);
+    QBENCHMARK
+    {
+        PrnReader reader(writer.buffer());
+        VectorDataObject readObject("Vector");
+        QVERIFY(readObject.import(reader));
+    }
+}
+
+QTEST_APPLESS_MAIN(BenchCore)
+
+#include "benchcore.moc"
@@ -0,0 +1,15 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath
+CONFIG -= app_bundle
+
+CONFIG += c++latest
+
+TEMPLATE = app
+
+SOURCES += \
+    benchcore.cpp
+
+include(../../src/core/core.pri)
+INCLUDEPATH += ../../src
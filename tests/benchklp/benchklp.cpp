@@ -0,0 +1,113 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Benchmarks of reading KLP files
+ */
+
+#include <QtTest/QTest>
+#include <QTemporaryDir>
+#include "klp/result.h"
+#include "klp/generator.h"
+
+using namespace KLP;
+
+class BenchKLP : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void readResult_data();
+    void readResult();
+    void getFrameCollection_data();
+    void getFrameCollection();
+
+private:
+    void addResultShapes();
+
+private:
+    QTemporaryDir mDirectory;
+};
+
+//! Check the directory where the files are generated
+void BenchKLP::initTestCase()
+{
+    QVERIFY(mDirectory.isValid());
+}
+
+//! Specify the shapes of results to benchmark and generate them
+void BenchKLP::addResultShapes()
+{
+    struct Shape
+    {
+        char const* name;
+        int numRods;
+        int numNodesRod;
+        int numFrames;
+        int recordSets;
+        int readOptions;
+    };
+    QTest::addColumn<QString>("pathFile");
+    QTest::addColumn<int>("numFrames");
+    QTest::addColumn<int>("readOptions");
+    // The large result takes about 0.5 GB, so it is written frame by frame and mapped rather than read into memory
+    std::vector<Shape> const kShapes = {{"modal", 28, 85, 1, kGeometry | kModal, Result::kReadAll},
+                                        {"dynamic", 6, 20, 660, kGeometry | kState | kDerivatives | kEnergy, Result::kReadAll},
+                                        {"large", 100, 50, 200, kAllRecords, Result::kMapped}};
+    for (Shape const& shape : kShapes)
+    {
+        QString pathFile = mDirectory.filePath(QString(shape.name) + ".klp");
+        if (!QFile::exists(pathFile))
+        {
+            GeneratorOptions options;
+            options.numRods = shape.numRods;
+            options.numNodesRod = shape.numNodesRod;
+            options.numFrames = shape.numFrames;
+            options.recordSets = shape.recordSets;
+            QVERIFY(Generator(options).write(pathFile));
+        }
+        QTest::newRow(shape.name) << pathFile << shape.numFrames << shape.readOptions;
+    }
+}
+
+void BenchKLP::readResult_data()
+{
+    addResultShapes();
+}
+
+//! Read a file and build its index
+void BenchKLP::readResult()
+{
+    QFETCH(QString, pathFile);
+    QFETCH(int, numFrames);
+    QFETCH(int, readOptions);
+    QBENCHMARK
+    {
+        Result result(pathFile, readOptions);
+        QCOMPARE((int)result.numTimeRecords(), numFrames);
+    }
+}
+
+void BenchKLP::getFrameCollection_data()
+{
+    addResultShapes();
+}
+
+//! Retrieve the collections of all the frames
+void BenchKLP::getFrameCollection()
+{
+    QFETCH(QString, pathFile);
+    QFETCH(int, numFrames);
+    QFETCH(int, readOptions);
+    Result result(pathFile, readOptions);
+    QBENCHMARK
+    {
+        for (int iFrame = 0; iFrame != numFrames; ++iFrame)
+            QVERIFY(!result.getFrameCollection(iFrame).parameter.isEmpty());
+    }
+}
+
+QTEST_APPLESS_MAIN(BenchKLP)
+
+#include "benchklp.moc"
@@ -0,0 +1,15 @@
+QT += testlib
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath
+CONFIG -= app_bundle
+
+CONFIG += c++latest
+
+TEMPLATE = app
+
+SOURCES += \
+    benchklp.cpp
+
+include(../../src/klp/klp.pri)
+INCLUDEPATH += ../../src
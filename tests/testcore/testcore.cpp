@@ -6,9 +6,35 @@
  */
 
 #include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QJsonObject>
 #include "core/damper.h"
 #include "core/rodsystem.h"
 #include "core/databasecables.h"
+#include "core/uncertaintyestimator.h"
+#include "core/spansurrogate.h"
+#include "core/vectordataobject.h"
+#include "core/scalardataobject.h"
+#include "core/surfacedataobject.h"
+#include "core/prnwriter.h"
+#include "core/prnreader.h"
+#include "core/templatecache.h"
+#include "core/project.h"
+#include "core/solutionoptions.h"
+#include "core/jobscheduler.h"
+#include "core/solutionmanager.h"
+#include "core/ringbuffer.h"
+#include "core/logwriter.h"
+#include "core/resultcache.h"
+#include "core/batchrunner.h"
+#include "core/solvertelemetry.h"
+#include "core/io.h"
 #include "core/numericalutilities.h"
 
 using namespace RSE::Core;
@@ -22,8 +48,35 @@ private slots:
     void initTestCase();
     void computeDamper();
     void computeRodSystem();
+    void resolveRodSystem();
+    void approximateRodSystem();
+    void computeSensitivity();
+    void estimateUncertainty();
+    void estimateQuantiles();
+    void interpolateSpans();
+    void modifyDataObject();
+    void modifyArray();
+    void serializeDataObject();
+    void writeDataObject();
+    void importDataObject();
+    void interpolateSurface();
+    void cacheTemplate();
+    void regenerateCalcData();
+    void restoreProject();
+    void scheduleJobs();
+    void manageSolution();
+    void manageStandInSolution();
+    void bufferLines();
+    void writeLog();
+    void cacheResults();
+    void runBatch();
+    void parseTelemetry();
     void cleanupTestCase();
 
+private:
+    bool writeTemplate(QString const& path);
+    bool writeScript(QString const& pathFile, QByteArray const& content);
+
 private:
     QString const mkRootPath = "../../../../";
     QString const mkDataPath = mkRootPath + "data/";
@@ -58,6 +111,1216 @@ void TestCore::computeRodSystem()
     QVERIFY(fuzzyCompare(spans.L[0], 23.99497, eps));
 }
 
+//! Resolve a rod system after one of the spans is modified
+void TestCore::resolveRodSystem()
+{
+    double eps = 1e-5;
+    RodSystem rodSystem = *mpRodSystem;
+    rodSystem.clearCache();
+    rodSystem.computeSpans();
+    // Modify one span and solve the system starting from the previous solution
+    std::vector<double> distances = rodSystem.distances();
+    distances[1] += 0.5;
+    rodSystem.setDistances(distances);
+    Spans warmSpans = rodSystem.computeSpans();
+    QCOMPARE(rodSystem.computeSpans().numIterations, 0);
+    // Solve the same system from scratch
+    rodSystem.clearCache();
+    Spans coldSpans = rodSystem.computeSpans();
+    QVERIFY(warmSpans.isConverged);
+    QVERIFY(warmSpans.numIterations <= coldSpans.numIterations);
+    QVERIFY(fuzzyCompare(warmSpans.L[1], coldSpans.L[1], eps));
+    QVERIFY(fuzzyCompare(warmSpans.projectedForce, coldSpans.projectedForce, eps));
+    // Modify one span of a long system
+    std::vector<double> longDistances(100);
+    for (int i = 0; i != (int)longDistances.size(); ++i)
+        longDistances[i] = 24 + (i * 37) % 49;
+    RodSystem longRodSystem(longDistances, mpDataBaseCables->getItem("АС 120/19"), 3000);
+    QVERIFY(longRodSystem.computeSpans().isConverged);
+    longDistances[50] += 0.5;
+    longRodSystem.setDistances(longDistances);
+    warmSpans = longRodSystem.computeSpans();
+    QVERIFY(warmSpans.isConverged);
+    QVERIFY(warmSpans.numIterations <= 2);
+    // Change the force of the long system, so that the cached state is scaled
+    longRodSystem.setForce(3300);
+    warmSpans = longRodSystem.computeSpans();
+    QVERIFY(warmSpans.isConverged);
+    QVERIFY(warmSpans.numIterations <= 2);
+    longRodSystem.clearCache();
+    coldSpans = longRodSystem.computeSpans();
+    QVERIFY(fuzzyCompare(warmSpans.L[50], coldSpans.L[50], eps));
+    QVERIFY(fuzzyCompare(warmSpans.projectedForce, coldSpans.projectedForce, eps));
+}
+
+//! Compare the number of iterations and failures of the constant and parabolic initial guesses
+void TestCore::approximateRodSystem()
+{
+    std::vector<double> const distances = {24, 72, 150, 300, 500};
+    std::vector<double> const forces = {1000, 3000, 7200, 20000};
+    std::vector<RodSystem::InitialGuess> const guesses = {RodSystem::kConstantGuess, RodSystem::kParabolicGuess};
+    std::vector<int> numIterations(guesses.size(), 0);
+    std::vector<int> numFailures(guesses.size(), 0);
+    for (int i = 0; i != (int)guesses.size(); ++i)
+    {
+        for (double distance : distances)
+        {
+            for (double force : forces)
+            {
+                RodSystem rodSystem(std::vector<double>(4, distance), mpDataBaseCables->getItem("АС 120/19"), force);
+                rodSystem.setInitialGuess(guesses[i]);
+                Spans spans = rodSystem.computeSpans();
+                numIterations[i] += spans.numIterations;
+                if (!spans.isConverged)
+                    ++numFailures[i];
+            }
+        }
+    }
+    QVERIFY(numFailures[1] <= numFailures[0]);
+    QVERIFY(numIterations[1] < numIterations[0]);
+}
+
+//! Compare derivatives of spans with finite differences
+void TestCore::computeSensitivity()
+{
+    double eps = 1e-3;
+    double step = 1e-3;
+    std::vector<double> const distances = {24, 30, 72, 24};
+    double const force = 3000;
+    RodSystem rodSystem(distances, mpDataBaseCables->getItem("АС 120/19"), force);
+    Spans spans = rodSystem.computeSpans();
+    Array<double> sensitivity = rodSystem.computeSensitivity(spans);
+    QCOMPARE(sensitivity.rows(), 5u);
+    QCOMPARE(sensitivity.cols(), 6u);
+    // Perturb one of the distances
+    std::vector<double> perturbedDistances = distances;
+    perturbedDistances[2] += step;
+    rodSystem.setDistances(perturbedDistances);
+    Spans perturbedSpans = rodSystem.computeSpans();
+    QVERIFY(fuzzyCompare(sensitivity[2][2], (perturbedSpans.L[2] - spans.L[2]) / step, eps));
+    // Perturb the force
+    rodSystem.setDistances(distances);
+    rodSystem.setForce(force + 1.0);
+    perturbedSpans = rodSystem.computeSpans();
+    QVERIFY(fuzzyCompare(sensitivity[4][4], perturbedSpans.projectedForce - spans.projectedForce, eps));
+    // Perturb the axial stiffness by central differences
+    rodSystem.setForce(force);
+    Cable const cable = mpDataBaseCables->getItem("АС 120/19");
+    double const relStep = 1e-4;
+    double stepEA = 2.0 * relStep * cable.youngsModulus * cable.area;
+    Cable perturbedCable = cable;
+    perturbedCable.youngsModulus = cable.youngsModulus * (1.0 + relStep);
+    rodSystem.setCable(perturbedCable);
+    Spans forwardSpans = rodSystem.computeSpans();
+    perturbedCable.youngsModulus = cable.youngsModulus * (1.0 - relStep);
+    rodSystem.setCable(perturbedCable);
+    Spans backwardSpans = rodSystem.computeSpans();
+    QVERIFY(fuzzyCompare(sensitivity[2][5], (forwardSpans.L[2] - backwardSpans.L[2]) / stepEA, eps));
+    QVERIFY(fuzzyCompare(sensitivity[4][5], (forwardSpans.projectedForce - backwardSpans.projectedForce) / stepEA, eps));
+    rodSystem.setCable(cable);
+    // Reject degenerate spans, since the Jacobian is singular there
+    Spans degenerateSpans = spans;
+    std::fill(degenerateSpans.u0.begin(), degenerateSpans.u0.end(), 0.0);
+    std::fill(degenerateSpans.uL.begin(), degenerateSpans.uL.end(), 0.0);
+    QCOMPARE(rodSystem.computeSensitivity(degenerateSpans).size(), 0u);
+    // Reject spans of another rod system
+    rodSystem.setDistances({24, 30});
+    QCOMPARE(rodSystem.computeSensitivity(spans).size(), 0u);
+}
+
+//! Propagate uncertainties of cable properties and distances through the computation of spans
+void TestCore::estimateUncertainty()
+{
+    int const kNumSamples = 1000;
+    Cable const& cable = mpDataBaseCables->getItem("АС 120/19");
+    RodSystem rodSystem({24, 24, 24, 24}, cable, 3000);
+    Spans spans = rodSystem.computeSpans();
+    UncertaintyEstimator estimator(rodSystem, {0.02, 0.03, 0.01, 0.1});
+    estimator.setNumSamples(kNumSamples);
+    // Results must not depend on the number of threads
+    estimator.setNumThreads(1);
+    SpansStatistics singleStatistics = estimator.estimate();
+    estimator.setNumThreads(4);
+    SpansStatistics multipleStatistics = estimator.estimate();
+    QCOMPARE(singleStatistics.numSamples + singleStatistics.numFailures, kNumSamples);
+    QCOMPARE(singleStatistics.L[0].mean, multipleStatistics.L[0].mean);
+    QCOMPARE(singleStatistics.projectedForce.variance, multipleStatistics.projectedForce.variance);
+    int numQuantiles = singleStatistics.L[0].quantiles.size();
+    for (int i = 0; i != numQuantiles; ++i)
+        QCOMPARE(singleStatistics.L[0].quantiles[i], multipleStatistics.L[0].quantiles[i]);
+    // Check the distributions
+    QVERIFY(fuzzyCompare(singleStatistics.L[0].mean, spans.L[0], 1e-3));
+    QVERIFY(singleStatistics.L[0].variance > 0.0);
+    QVERIFY(singleStatistics.L[0].quantiles.front() < singleStatistics.L[0].quantiles.back());
+    QVERIFY(fuzzyCompare(singleStatistics.L[0].quantiles[1], spans.L[0], 1e-3));
+}
+
+//! Compare streaming estimates of quantiles with the exact ones for as many samples and outputs as the uncertainty analysis uses
+void TestCore::estimateQuantiles()
+{
+    int const kNumValues = 100000;
+    int const kNumOutputs = 20;
+    std::vector<double> const probabilities = {0.05, 0.5, 0.95};
+    std::mt19937 generator(7);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::lognormal_distribution<double> logNormal(0.0, 0.5);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::exponential_distribution<double> exponential(1.0);
+    for (int iOutput = 0; iOutput != kNumOutputs; ++iOutput)
+    {
+        std::vector<QuantileEstimator> estimators;
+        for (double probability : probabilities)
+            estimators.emplace_back(probability);
+        // Lengths are close to normal, while the other distributions are skewed or bounded
+        std::vector<double> values(kNumValues);
+        for (double& value : values)
+        {
+            switch (iOutput % 4)
+            {
+            case 0:
+                value = 24.0 + iOutput + 0.01 * (iOutput + 1) * normal(generator);
+                break;
+            case 1:
+                value = logNormal(generator);
+                break;
+            case 2:
+                value = uniform(generator);
+                break;
+            default:
+                value = exponential(generator);
+                break;
+            }
+            for (QuantileEstimator& estimator : estimators)
+                estimator.add(value);
+        }
+        std::sort(values.begin(), values.end());
+        auto exactQuantile = [&values](double probability)
+        {
+            double position = probability * (values.size() - 1);
+            int iLower = std::floor(position);
+            double weight = position - iLower;
+            return values[iLower] * (1.0 - weight) + values[iLower + 1] * weight;
+        };
+        double range = exactQuantile(probabilities.back()) - exactQuantile(probabilities.front());
+        for (std::size_t i = 0; i != probabilities.size(); ++i)
+        {
+            double estimate = estimators[i].value();
+            QVERIFY(std::abs(estimate - exactQuantile(probabilities[i])) < 1e-2 * range);
+            // Fraction of values below the estimate
+            double rank = double(std::lower_bound(values.begin(), values.end(), estimate) - values.begin()) / kNumValues;
+            QVERIFY(std::abs(rank - probabilities[i]) < 2e-3);
+        }
+    }
+}
+
+//! Approximate spans using the precomputed table
+void TestCore::interpolateSpans()
+{
+    double const kTolerance = 1e-4;
+    Cable const& cable = mpDataBaseCables->getItem("АС 120/19");
+    SpanSurrogate surrogate;
+    surrogate.build(cable, {20, 80, 31}, {2000, 8000, 31});
+    QVERIFY(!surrogate.isEmpty());
+    // Compare the interpolated solution with the exact one
+    RodSystem rodSystem({25.3, 41.7, 66.1}, cable, 3150);
+    Spans spans = rodSystem.computeSpans();
+    double error;
+    Spans approxSpans = surrogate.computeSpans(rodSystem, kTolerance, &error);
+    QVERIFY(approxSpans.isConverged);
+    QVERIFY(error > 0.0 && error < kTolerance);
+    for (int i = 0; i != 3; ++i)
+        QVERIFY(fuzzyCompare(approxSpans.L[i], spans.L[i], kTolerance));
+    QVERIFY(fuzzyCompare(approxSpans.projectedForce, spans.projectedForce, 1e-3));
+    // Fall back to the exact solver outside the table
+    rodSystem.setForce(10000);
+    approxSpans = surrogate.computeSpans(rodSystem, kTolerance, &error);
+    QVERIFY(approxSpans.isConverged);
+    QCOMPARE(error, 0.0);
+    // Write and read the table
+    QString pathFile = QDir::temp().filePath("surrogate.rse");
+    QVERIFY(SpanSurrogate::write(pathFile, {surrogate}));
+    std::vector<SpanSurrogate> surrogates = SpanSurrogate::read(pathFile);
+    QFile::remove(pathFile);
+    QCOMPARE((int)surrogates.size(), 1);
+    QCOMPARE(surrogates[0].nameCable(), surrogate.nameCable());
+    Spans readSpans = surrogates[0].interpolate({25.3, 41.7, 66.1}, 3150, error);
+    rodSystem.setForce(3150);
+    QCOMPARE(readSpans.L[0], surrogate.interpolate(rodSystem.distances(), 3150, error).L[0]);
+    // Reject truncated and corrupted tables
+    QVERIFY(SpanSurrogate::write(pathFile, {surrogate, surrogate}));
+    QFile file(pathFile);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - sizeof(double)));
+    file.close();
+    QVERIFY(SpanSurrogate::read(pathFile).empty());
+    // Change the number of force nodes, so that it disagrees with the size of tables
+    QVERIFY(SpanSurrogate::write(pathFile, {surrogate}));
+    QByteArray name;
+    QDataStream nameStream(&name, QIODevice::WriteOnly);
+    nameStream << QString::fromStdString(surrogate.nameCable());
+    QByteArray numNodes;
+    QDataStream nodesStream(&numNodes, QIODevice::WriteOnly);
+    nodesStream << (qint32)30;
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.seek(3 * sizeof(quint32) + name.size() + 2 * (2 * sizeof(double)) + sizeof(qint32)));
+    file.write(numNodes);
+    file.close();
+    QVERIFY(SpanSurrogate::read(pathFile).empty());
+    QFile::remove(pathFile);
+    QCOMPARE(SpanSurrogate::pathFile(mkDataPath + tr("Провода.txt")), mkDataPath + tr("Провода.spans"));
+}
+
+//! Insert, move and remove items of a data object
+void TestCore::modifyDataObject()
+{
+    VectorDataObject dataObject("Vector");
+    for (double key : {3.0, 1.0, 2.0, 5.0})
+    {
+        DataItemType item = dataObject.addItem(key);
+        for (IndexType j = 0; j != 3; ++j)
+            item[0][j] = key * 10 + j;
+    }
+    QCOMPARE(dataObject.keys(), std::vector<double>({1.0, 2.0, 3.0, 5.0}));
+    // Move items
+    QVERIFY(!dataObject.changeItemKey(4.0, 6.0));
+    QVERIFY(!dataObject.changeItemKey(1.0, 2.0));
+    QVERIFY(dataObject.changeItemKey(1.0, 4.0));
+    QVERIFY(dataObject.changeItemKey(5.0, 0.0));
+    QCOMPARE(dataObject.keys(), std::vector<double>({0.0, 2.0, 3.0, 4.0}));
+    QCOMPARE(dataObject.arrayValue(4.0, 0, 2), 12.0);
+    QCOMPARE(dataObject.arrayValue(0.0, 0, 1), 51.0);
+    // Modify and clone
+    QVERIFY(dataObject.setArrayValue(2.0, -1.0, 0, 1));
+    QVERIFY(!dataObject.setArrayValue(7.0, -1.0));
+    AbstractDataObject* pClone = dataObject.clone();
+    dataObject.removeItem(2.0);
+    QCOMPARE(dataObject.numberItems(), 3u);
+    QCOMPARE(pClone->numberItems(), 4u);
+    QCOMPARE(pClone->arrayValue(2.0, 0, 1), -1.0);
+    delete pClone;
+}
+
+//! Resize, shrink and move arrays
+void TestCore::modifyArray()
+{
+    Array<double> array(2, 2);
+    QVERIFY(array.isInline());
+    for (IndexType i = 0; i != array.size(); ++i)
+        array.data()[i] = i + 1;
+    // Expand the array so that the heap storage is used
+    array.resize(4, 5);
+    QVERIFY(!array.isInline());
+    QCOMPARE(array[1][1], 4.0);
+    QCOMPARE(array[1][2], 0.0);
+    QCOMPARE(array[3][4], 0.0);
+    // Shrink it in place
+    IndexType capacity = array.capacity();
+    array.removeColumn(0);
+    array.resize(2, 3);
+    QCOMPARE(array.capacity(), capacity);
+    QCOMPARE(array[1][0], 4.0);
+    QCOMPARE(array[0][1], 0.0);
+    // Move it
+    Array<double> another;
+    another = std::move(array);
+    QCOMPARE(array.size(), 0u);
+    QCOMPARE(another.capacity(), capacity);
+    QCOMPARE(another[0][0], 2.0);
+}
+
+//! Write data objects to binary streams and read them back
+void TestCore::serializeDataObject()
+{
+    VectorDataObject dataObject("Vector");
+    for (double key : {3.0, 1.0, 2.0})
+    {
+        DataItemType item = dataObject.addItem(key);
+        item[0][0] = key;
+        item[0][2] = -key;
+    }
+    // Round trip using the block format
+    QByteArray bytes;
+    QDataStream outStream(&bytes, QIODevice::WriteOnly);
+    outStream << dataObject;
+    QDataStream inStream(bytes);
+    quint32 type;
+    QString name;
+    inStream >> type >> name;
+    VectorDataObject readObject(name);
+    readObject.deserialize(inStream);
+    QCOMPARE(inStream.status(), QDataStream::Ok);
+    QVERIFY(inStream.atEnd());
+    QCOMPARE(readObject.id(), dataObject.id());
+    QCOMPARE(readObject.keys(), dataObject.keys());
+    QCOMPARE(readObject.arrayValue(2.0, 0, 2), -2.0);
+    // Read the format where items are written one by one
+    QByteArray oldBytes;
+    QDataStream oldOutStream(&oldBytes, QIODevice::WriteOnly);
+    oldOutStream << (DataIDType)7 << (quint32)2;
+    oldOutStream << 5.0 << (IndexType)1 << (IndexType)3 << 1.0 << 2.0 << 3.0;
+    oldOutStream << 4.0 << (IndexType)1 << (IndexType)3 << 4.0 << 5.0 << 6.0;
+    QDataStream oldInStream(oldBytes);
+    readObject.deserialize(oldInStream);
+    QCOMPARE(readObject.id(), (DataIDType)7);
+    QCOMPARE(readObject.keys(), std::vector<double>({4.0, 5.0}));
+    QCOMPARE(readObject.arrayValue(5.0, 0, 1), 2.0);
+    // Reject sizes which wrap around or exceed the stream before allocating items
+    QByteArray corruptBytes;
+    QDataStream corruptOutStream(&corruptBytes, QIODevice::WriteOnly);
+    corruptOutStream << (DataIDType)-1 << (quint32)1 << (DataIDType)7 << (IndexType)0x10000 << (IndexType)0x10000 << (quint32)2;
+    corruptOutStream << 1.0 << 2.0 << 3.0;
+    QDataStream corruptInStream(corruptBytes);
+    readObject.deserialize(corruptInStream);
+    QCOMPARE(corruptInStream.status(), QDataStream::ReadCorruptData);
+    QVERIFY(readObject.keys().empty());
+    QByteArray arrayBytes;
+    QDataStream arrayOutStream(&arrayBytes, QIODevice::WriteOnly);
+    arrayOutStream << (IndexType)0xFFFFFFFF << (quint32)1 << (IndexType)0x40000000 << (IndexType)8 << 1.0;
+    QDataStream arrayInStream(arrayBytes);
+    Array<double> array;
+    arrayInStream >> array;
+    QCOMPARE(arrayInStream.status(), QDataStream::ReadCorruptData);
+    QCOMPARE(array.size(), 0u);
+}
+
+//! Check that the fast formatter produces the same text as the stream does
+void TestCore::writeDataObject()
+{
+    int const kFieldWidth = 30;
+    ScalarDataObject scalarObject("Scalar");
+    scalarObject.addItem(0)[0][0] = 1.5;
+    VectorDataObject vectorObject("Vector");
+    std::vector<double> values = {0.0, 1.0 / 3.0, -2.5e-7, 1e20, 123456789012345678.0, 0.1 + 0.2, -1e-300,
+                                  std::numeric_limits<double>::max(), std::numeric_limits<double>::denorm_min(),
+                                  std::numeric_limits<double>::infinity()};
+    for (int i = 0; i != (int)values.size(); ++i)
+    {
+        DataItemType item = vectorObject.addItem(i * 0.7);
+        for (IndexType j = 0; j != 3; ++j)
+            item[0][j] = values[(i + j) % values.size()] * (j + 1);
+    }
+    // Golden layout of a scalar object
+    PrnWriter writer(kFieldWidth);
+    scalarObject.write(writer);
+    QString padding(kFieldWidth - 1, ' ');
+    QByteArray expected = (padding + "1" + padding + "1" + padding + "\n" + padding + "0" + padding.chopped(2) + "1.5" + padding + "\n").toUtf8();
+    QCOMPARE(writer.buffer(), expected);
+    // Compare with the stream
+    for (AbstractDataObject* pObject : std::initializer_list<AbstractDataObject*>{&scalarObject, &vectorObject})
+    {
+        writer.clear();
+        pObject->write(writer);
+        QString text;
+        QTextStream stream(&text);
+        stream.setFieldAlignment(QTextStream::AlignRight);
+        stream.setFieldWidth(kFieldWidth);
+        pObject->write(stream);
+        stream.flush();
+        QCOMPARE(writer.buffer(), text.toUtf8());
+    }
+}
+
+//! Parse data objects from a text buffer and report errors
+void TestCore::importDataObject()
+{
+    QByteArray content = "2 1\r\n"
+                         "0.5 1 2 3\r\n"
+                         "-1.5e-3 +4 .5 -inf\r\n";
+    PrnReader reader(content, "w3.prn");
+    VectorDataObject dataObject("Vector");
+    QVERIFY(dataObject.import(reader));
+    QVERIFY(reader.atEnd());
+    QCOMPARE(dataObject.keys(), std::vector<double>({-1.5e-3, 0.5}));
+    QCOMPARE(dataObject.arrayValue(-1.5e-3, 0, 1), 0.5);
+    QCOMPARE(dataObject.arrayValue(0.5, 0, 2), 3.0);
+    QVERIFY(std::isinf(dataObject.arrayValue(-1.5e-3, 0, 2)));
+    // Round trip through the formatter
+    PrnWriter writer(30);
+    dataObject.write(writer);
+    PrnReader writtenReader(writer.buffer());
+    VectorDataObject readObject("Vector");
+    QVERIFY(readObject.import(writtenReader));
+    QCOMPARE(readObject.keys(), dataObject.keys());
+    QCOMPARE(readObject.arrayValue(0.5, 0, 1), 2.0);
+    // Report the line of an error
+    PrnReader invalidReader(QByteArray("2 1\n0 1 2 3\n\n1 4 5,0 6\n"), "w3.prn");
+    QVERIFY(!readObject.import(invalidReader));
+    QCOMPARE(invalidReader.errorString(), QString("Could not parse the number '5,0' at line 4 of w3.prn"));
+    PrnReader truncatedReader(QByteArray("3 1\n0 1 2 3\n"));
+    QVERIFY(!readObject.import(truncatedReader));
+    QVERIFY(truncatedReader.errorString().startsWith("Unexpected end of data"));
+}
+
+//! Import curves of a surface and interpolate between them
+void TestCore::interpolateSurface()
+{
+    QByteArray content = "2 3\n"
+                         "20 0 0\n1 1\n2 4\n"
+                         "10 0 0\n1 2\n2 2\n";
+    PrnReader reader(content, "xy.prn");
+    SurfaceDataObject surface("Surface");
+    QVERIFY(surface.import(reader));
+    QCOMPARE(surface.numberPoints(), (IndexType)3);
+    QCOMPARE(surface.keys(), std::vector<double>({10.0, 20.0}));
+    // Interpolation along curves and between them
+    QCOMPARE(surface.interpolate(10.0, 1.5), 2.0);
+    QCOMPARE(surface.interpolate(20.0, 1.5), 2.5);
+    QCOMPARE(surface.interpolate(15.0, 0.5), 0.75);
+    // Values outside the table
+    QCOMPARE(surface.interpolate(30.0, 5.0), 4.0);
+    QCOMPARE(surface.interpolate(0.0, -1.0), 0.0);
+    // Round trip through the formatter keeps the number of points
+    PrnWriter writer(30);
+    surface.write(writer);
+    PrnReader writtenReader(writer.buffer());
+    SurfaceDataObject readSurface("Surface");
+    QVERIFY(readSurface.import(writtenReader));
+    QCOMPARE(readSurface.numberPoints(), (IndexType)3);
+    QCOMPARE(readSurface.arrayValue(20.0, 2, 1), 4.0);
+    // Change the number of points of a copy
+    std::unique_ptr<AbstractDataObject> pCopy(surface.clone());
+    surface.setNumberPoints(4);
+    QCOMPARE(surface.arrayValue(20.0, 3, 1), 4.0);
+    QCOMPARE(pCopy->numberItemRows(), (IndexType)3);
+    surface.setNumberPoints(2);
+    QCOMPARE(surface.interpolate(20.0, 5.0), 1.0);
+}
+
+//! Reuse a parsed template and share items of data objects until modified
+void TestCore::cacheTemplate()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString path = directory.path() + "/";
+    auto writeFile = [&path](QString const& fileName, QByteArray const& content)
+    {
+        QFile file(path + fileName);
+        return file.open(QIODeviceBase::WriteOnly) && file.write(content) == content.size();
+    };
+    QVERIFY(writeFile(ProjectTemplate::skFileNameScalar, "1\n1\n1 1\n0 2.5\n"));
+    QVERIFY(writeFile(ProjectTemplate::skFileNameVector, "1\n1\n1 1\n0 1 2 3\n"));
+    QVERIFY(writeFile(ProjectTemplate::skFileNameProject, "42\n"));
+    QVERIFY(writeFile(ProjectTemplate::skFileNameRods, "RODS\n"));
+    QVERIFY(writeFile(ProjectTemplate::skFileNameProgram, "PROG\n"));
+    // Parse the template only once
+    TemplateCache& cache = TemplateCache::instance();
+    std::shared_ptr<ProjectTemplate const> pTemplate = cache.get(path);
+    QCOMPARE(cache.get(path), pTemplate);
+    QCOMPARE(pTemplate->projectID, 42);
+    QCOMPARE((int)pTemplate->scalarDataObjects.size(), 1);
+    QCOMPARE((int)pTemplate->vectorDataObjects.size(), 1);
+    QCOMPARE(pTemplate->rods, QStringList({"RODS"}));
+    // Modify a clone, while keeping the cached object intact
+    AbstractDataObject const* pObject = pTemplate->vectorDataObjects[0];
+    AbstractDataObject* pClone = pObject->clone();
+    pClone->setArrayValue(0.0, 5.0, 0, 1);
+    QCOMPARE(pClone->arrayValue(0.0, 0, 1), 5.0);
+    QCOMPARE(pObject->arrayValue(0.0, 0, 1), 2.0);
+    delete pClone;
+    // Parse the template again after the modification of its files
+    QVERIFY(writeFile(ProjectTemplate::skFileNameProject, "137\n"));
+    std::shared_ptr<ProjectTemplate const> pModifiedTemplate = cache.get(path);
+    QVERIFY(pModifiedTemplate != pTemplate);
+    QCOMPARE(pModifiedTemplate->projectID, 137);
+    QVERIFY(pModifiedTemplate->errorString.isEmpty());
+    // Report damaged files, while keeping the data read
+    QVERIFY(writeFile(ProjectTemplate::skFileNameVector, "1\n2\n1 1\n0 1 2 3\n"));
+    std::shared_ptr<ProjectTemplate const> pDamagedTemplate = cache.get(path);
+    QVERIFY(pDamagedTemplate->errorString.contains(ProjectTemplate::skFileNameVector));
+    QCOMPARE((int)pDamagedTemplate->scalarDataObjects.size(), 1);
+    QCOMPARE(pDamagedTemplate->projectID, 137);
+    Project project("Project", *mpDataBaseCables, *mpDamper, *mpRodSystem, Support(1e6, 2e6));
+    QString errorString;
+    QVERIFY(!project.readTemplateData(path, &errorString));
+    QCOMPARE(errorString, pDamagedTemplate->errorString);
+    QVERIFY(QFile::remove(path + ProjectTemplate::skFileNameScalar));
+    ProjectTemplate incompleteTemplate;
+    QVERIFY(!incompleteTemplate.read(path));
+    QVERIFY(incompleteTemplate.errorString.contains(ProjectTemplate::skFileNameScalar));
+    cache.clear();
+    QCOMPARE(cache.size(), 0);
+}
+
+//! Rewrite only the computational data affected by the modified parameters
+void TestCore::regenerateCalcData()
+{
+    QTemporaryDir inputDirectory;
+    QTemporaryDir outputDirectory;
+    QVERIFY(inputDirectory.isValid() && outputDirectory.isValid());
+    QString inputPath = inputDirectory.path() + "/";
+    QString outputPath = outputDirectory.path() + "/";
+    QVERIFY(writeTemplate(inputPath));
+    Project project("Project", *mpDataBaseCables, *mpDamper, *mpRodSystem, Support(1e6, 2e6));
+    project.damper().setSpringLength(0.3);
+    RSE::Solution::SolutionOptions options(6, 3, 1, 1e-3);
+    project.readTemplateData(inputPath);
+    // Write all the files at first
+    CalcDataReport report = project.writeCalcData(outputPath, options);
+    QVERIFY(report.isSpansComputed);
+    QCOMPARE((int)report.writtenFiles.size(), 4);
+    // Skip all the files, if nothing has changed
+    report = project.writeCalcData(outputPath, options);
+    QCOMPARE(report.changes, (int)kNoChange);
+    QVERIFY(!report.isSpansComputed);
+    QCOMPARE((int)report.skippedFiles.size(), 4);
+    // Rewrite only the scalar data objects, if the spring stiffness has changed
+    project.damper().setSpringStiffness(project.damper().springStiffness() + 100.0);
+    report = project.writeCalcData(outputPath, options);
+    QCOMPARE(report.changes, (int)kDamperChange);
+    QVERIFY(!report.isSpansComputed);
+    QCOMPARE(report.writtenFiles, QStringList({ProjectTemplate::skFileNameScalar}));
+    // Recompute spans, if the force has changed
+    project.rodSystem().setForce(project.rodSystem().force() + 500.0);
+    report = project.writeCalcData(outputPath, options);
+    QVERIFY(report.isSpansComputed);
+    QCOMPARE(report.writtenFiles, QStringList({ProjectTemplate::skFileNameVector}));
+    // Restore a file removed
+    QVERIFY(QFile::remove(outputPath + ProjectTemplate::skFileNameProgram));
+    report = project.writeCalcData(outputPath, options);
+    QCOMPARE(report.writtenFiles, QStringList({ProjectTemplate::skFileNameProgram}));
+    // Refuse to write the data for more rods than the template provides
+    std::vector<double> distances = project.rodSystem().distances();
+    project.rodSystem().setDistances(std::vector<double>(distances.size() + 1, distances.front()));
+    report = project.writeCalcData(outputPath, options);
+    QCOMPARE(report.failedFiles, QStringList({ProjectTemplate::skFileNameVector}));
+    QVERIFY(report.writtenFiles.isEmpty());
+    QVERIFY(!report.errorString.isEmpty());
+    // Keep the files written before the failure
+    project.rodSystem().setDistances(distances);
+    report = project.writeCalcData(outputPath, options);
+    QVERIFY(report.failedFiles.isEmpty());
+    QVERIFY(report.isSpansComputed);
+    QVERIFY(report.writtenFiles.isEmpty());
+}
+
+//! Save a project along with its computed state and restore it without recomputing
+void TestCore::restoreProject()
+{
+    QTemporaryDir inputDirectory;
+    QTemporaryDir outputDirectory;
+    QVERIFY(inputDirectory.isValid() && outputDirectory.isValid());
+    QString inputPath = inputDirectory.path() + "/";
+    QString outputPath = outputDirectory.path() + "/";
+    QVERIFY(writeTemplate(inputPath));
+    Project project("Project", *mpDataBaseCables, *mpDamper, *mpRodSystem, Support(1e6, 2e6));
+    RSE::Solution::SolutionOptions options(6, 3, 1, 1e-3);
+    project.readTemplateData(inputPath);
+    project.writeCalcData(outputPath, options);
+    // Save and open the project
+    IO io(outputPath);
+    QString pathFile = outputPath + "Project" + io.extension();
+    io.saveAs(pathFile, project, options);
+    IOPair ioPair = io.open(pathFile, *mpDataBaseCables);
+    QVERIFY(ioPair.first && ioPair.second);
+    std::unique_ptr<Project> pProject(ioPair.first);
+    std::unique_ptr<RSE::Solution::SolutionOptions> pOptions(ioPair.second);
+    QVERIFY(pProject->hasTemplateData());
+    QCOMPARE(pProject->rodSystem().distances(), mpRodSystem->distances());
+    QCOMPARE(pOptions->numCalcModes(), options.numCalcModes());
+    CalcDataReport report = pProject->writeCalcData(outputPath, *pOptions);
+    QVERIFY(!report.isSpansComputed);
+    QCOMPARE(report.changes, (int)kNoChange);
+    QVERIFY(report.writtenFiles.isEmpty());
+    QCOMPARE(pProject->rodSystem().cable().massPerLength, mpRodSystem->cable().massPerLength);
+    // Detect the modification of the template made after the project was saved
+    QVERIFY(!pProject->isTemplateOutdated(inputPath));
+    QFile rodsFile(inputPath + ProjectTemplate::skFileNameRods);
+    QVERIFY(rodsFile.open(QIODeviceBase::Append));
+    rodsFile.write("\n");
+    rodsFile.close();
+    QVERIFY(pProject->isTemplateOutdated(inputPath));
+    pProject->readTemplateData(inputPath);
+    QVERIFY(!pProject->isTemplateOutdated(inputPath));
+    report = pProject->writeCalcData(outputPath, *pOptions);
+    QVERIFY(report.changes & kTemplateChange);
+    // Skip the damaged section of the template data, which is the last one
+    QFile file(pathFile);
+    QVERIFY(file.open(QIODeviceBase::ReadWrite));
+    QVERIFY(file.seek(file.size() - 1));
+    char lastByte = file.peek(1).at(0) ^ 0x1;
+    QVERIFY(file.write(&lastByte, 1) == 1);
+    file.close();
+    ioPair = io.open(pathFile, *mpDataBaseCables);
+    QVERIFY(ioPair.first && ioPair.second);
+    pProject.reset(ioPair.first);
+    pOptions.reset(ioPair.second);
+    QVERIFY(!pProject->hasTemplateData());
+    QCOMPARE(pProject->rodSystem().distances(), mpRodSystem->distances());
+    // Open a file which consists of the parameters only
+    QVERIFY(file.open(QIODeviceBase::ReadOnly));
+    QDataStream stream(&file);
+    quint32 signature, version, numSections, reserved, tag, flags, checksum, entryReserved;
+    quint64 offset, size;
+    stream >> signature >> version >> numSections >> reserved >> tag >> flags >> checksum >> entryReserved >> offset >> size;
+    QCOMPARE(tag, (quint32)IO::kParameters);
+    QVERIFY(file.seek(offset));
+    QByteArray parameters = file.read(size);
+    file.close();
+    QVERIFY(file.open(QIODeviceBase::WriteOnly));
+    file.write(parameters);
+    file.close();
+    ioPair = io.open(pathFile, *mpDataBaseCables);
+    QVERIFY(ioPair.first && ioPair.second);
+    pProject.reset(ioPair.first);
+    pOptions.reset(ioPair.second);
+    QVERIFY(!pProject->hasTemplateData());
+    QCOMPARE(pProject->rodSystem().force(), mpRodSystem->force());
+    // Open a file of the previous version, whose checksums are CRC-16
+    QVERIFY(file.open(QIODeviceBase::WriteOnly));
+    QDataStream legacyStream(&file);
+    legacyStream << signature << (quint32)2 << (quint32)1 << (quint32)0 << tag << (quint16)0 << (quint16)qChecksum(parameters)
+                 << (quint64)40 << (quint64)parameters.size();
+    legacyStream.writeRawData(parameters.constData(), parameters.size());
+    file.close();
+    ioPair = io.open(pathFile, *mpDataBaseCables);
+    QVERIFY(ioPair.first && ioPair.second);
+    pProject.reset(ioPair.first);
+    pOptions.reset(ioPair.second);
+    QCOMPARE(pProject->rodSystem().force(), mpRodSystem->force());
+    // Reject a file of a newer version
+    QVERIFY(file.open(QIODeviceBase::WriteOnly));
+    QDataStream newerStream(&file);
+    newerStream << signature << version + 1 << (quint32)0 << (quint32)0;
+    file.close();
+    ioPair = io.open(pathFile, *mpDataBaseCables);
+    QVERIFY(!ioPair.first && !ioPair.second);
+    QVERIFY(io.errorString().contains("newer version"));
+}
+
+//! Run several solutions concurrently in separate directories by means of the stand-in solver
+void TestCore::scheduleJobs()
+{
+    using RSE::Solution::JobScheduler;
+    using RSE::Solution::SolverJob;
+    using RSE::Solution::SolverLauncher;
+    QFileInfo standInSolver(STANDIN_SOLVER_PATH);
+    if (!standInSolver.exists())
+        QSKIP("The stand-in solver is not built");
+    QTemporaryDir rootDirectory;
+    QTemporaryDir scratchDirectory;
+    QVERIFY(rootDirectory.isValid() && scratchDirectory.isValid());
+    QString rootPath = rootDirectory.path() + "/";
+    QVERIFY(QDir(rootPath).mkpath("Input"));
+    QVERIFY(writeTemplate(rootPath + "Input/"));
+    QVERIFY(QFile::copy(standInSolver.absoluteFilePath(), rootPath + standInSolver.fileName()));
+    // Output left in the root directory by a previous solution
+    QFile rootLog(rootPath + "Solver.log");
+    QVERIFY(rootLog.open(QIODevice::WriteOnly) && rootLog.write("root\n") == 5);
+    rootLog.close();
+    Project project("Project", *mpDataBaseCables, *mpDamper, *mpRodSystem, Support(1e6, 2e6));
+    RSE::Solution::SolutionOptions options(6, 3, 1, 1e-3);
+    project.readTemplateData(rootPath + "Input/");
+    JobScheduler scheduler(rootPath, "Input/", "Output/", scratchDirectory.path());
+    SolverLauncher launcher;
+    launcher.setProgram(QString());
+    launcher.setArguments({"--frames", "5", "--nodes", "4", "--delay", "200"});
+    scheduler.setLauncher(launcher);
+    scheduler.setSolverName(standInSolver.fileName());
+    scheduler.setMaxConcurrentJobs(2);
+    int maxNumRunning = 0;
+    connect(&scheduler, &JobScheduler::jobChanged, [&]() { maxNumRunning = std::max(maxNumRunning, scheduler.numRunning()); });
+    // Jobs are announced before they are appended
+    int numAnnounced = 0;
+    connect(&scheduler, &JobScheduler::jobAboutToBeAdded, [&](int iJob)
+    {
+        QCOMPARE(iJob, (int)scheduler.jobs().size());
+        ++numAnnounced;
+    });
+    // Run more jobs than the number of slots
+    int const kNumJobs = 3;
+    for (int i = 0; i != kNumJobs; ++i)
+        scheduler.submit(project, options);
+    QCOMPARE(numAnnounced, kNumJobs);
+    QCOMPARE(scheduler.numRunning(), 2);
+    auto isAllFinished = [&scheduler]()
+    {
+        return std::all_of(scheduler.jobs().begin(), scheduler.jobs().end(), [](SolverJob const& job) { return job.isFinished(); });
+    };
+    QTRY_VERIFY_WITH_TIMEOUT(isAllFinished(), 20000);
+    QCOMPARE(maxNumRunning, 2);
+    QStringList directories;
+    for (SolverJob const& job : scheduler.jobs())
+    {
+        QCOMPARE(job.state, SolverJob::kDone);
+        QCOMPARE(job.status, 0);
+        QCOMPARE(job.resultFiles, QStringList({"Result.klp"}));
+        QVERIFY(QFile::exists(job.directory + "Input/" + ProjectTemplate::skFileNameVector));
+        QVERIFY(!directories.contains(job.directory));
+        QVERIFY(!QFileInfo(job.directory + "Solver.log").isSymLink());
+        directories.push_back(job.directory);
+    }
+    QVERIFY(rootLog.open(QIODevice::ReadOnly));
+    QCOMPARE(rootLog.readAll(), QByteArray("root\n"));
+    rootLog.close();
+    // Cancel running and queued jobs
+    scheduler.clearFinished();
+    QVERIFY(scheduler.jobs().empty());
+    QVERIFY(!QDir(directories.front()).exists());
+    launcher.setArguments({"--frames", "1000", "--nodes", "4", "--delay", "100"});
+    scheduler.setLauncher(launcher);
+    scheduler.setMaxConcurrentJobs(1);
+    int idRunning = scheduler.submit(project, options);
+    int idQueued = scheduler.submit(project, options);
+    QCOMPARE(scheduler.job(idRunning)->state, SolverJob::kRunning);
+    QCOMPARE(scheduler.job(idQueued)->state, SolverJob::kQueued);
+    scheduler.cancel(idRunning);
+    QCOMPARE(scheduler.job(idRunning)->state, SolverJob::kCancelled);
+    QCOMPARE(scheduler.job(idQueued)->state, SolverJob::kRunning);
+    scheduler.cancelAll();
+    QCOMPARE(scheduler.job(idQueued)->state, SolverJob::kCancelled);
+    QCOMPARE(scheduler.numRunning(), 0);
+}
+
+//! Pass the solution through its states by means of stand-in solvers
+void TestCore::manageSolution()
+{
+#ifdef Q_OS_WINDOWS
+    QSKIP("The stand-in solvers are shell scripts");
+#endif
+    using RSE::Solution::SolutionManager;
+    QTemporaryDir rootDirectory;
+    QVERIFY(rootDirectory.isValid());
+    QString rootPath = rootDirectory.path() + "/";
+    QVERIFY(QDir(rootPath).mkpath("Input") && QDir(rootPath).mkpath("Output"));
+    QVERIFY(writeTemplate(rootPath + "Input/"));
+    QString pathRodSystemSolver = rootPath + "KLPALGSYSx64.exe";
+    Project project("Project", *mpDataBaseCables, *mpDamper, *mpRodSystem, Support(1e6, 2e6));
+    RSE::Solution::SolutionOptions options(6, 3, 1, 1e-3);
+    project.readTemplateData(rootPath + "Input/");
+    SolutionManager manager(rootPath, "Input/", "Output/");
+    RSE::Solution::SolverLauncher launcher;
+    launcher.setProgram(QString());
+    manager.setLauncher(launcher);
+    int numRodSystemSolved = 0;
+    int numOptimizationSolved = 0;
+    int numOptimizationSteps = 0;
+    connect(&manager, &SolutionManager::rodSystemSolved, [&numRodSystemSolved]() { ++numRodSystemSolved; });
+    connect(&manager, &SolutionManager::optimizationSolved, [&numOptimizationSolved]() { ++numOptimizationSolved; });
+    connect(&manager, &SolutionManager::optimizationStepPerformed, [&numOptimizationSteps]() { ++numOptimizationSteps; });
+    QByteArray output;
+    connect(&manager, &SolutionManager::outputSent, [&output](QByteArray const& data) { output.append(data); });
+    auto states = [&manager]()
+    {
+        std::vector<SolutionManager::State> result;
+        for (SolutionManager::Transition const& transition : manager.transitions())
+            result.push_back(transition.state);
+        return result;
+    };
+    // Complete the solution once the status is written
+    QVERIFY(writeScript(pathRodSystemSolver, "#!/bin/sh\necho Step 1 of 1\necho 1 > Output/Result.klp\necho 0 > Status.txt\n"));
+    manager.solveRodSystem(project, options);
+    QCOMPARE(manager.state(), SolutionManager::kRunning);
+    QTRY_COMPARE_WITH_TIMEOUT(manager.state(), SolutionManager::kDone, 10000);
+    QCOMPARE(numRodSystemSolved, 1);
+    QCOMPARE(states(), std::vector<SolutionManager::State>({SolutionManager::kQueued, SolutionManager::kPreprocessing,
+                                                            SolutionManager::kRunning, SolutionManager::kDone}));
+    QVERIFY(output.contains("Result.klp"));
+    // Store the results in the background and restore them instead of running the solver again
+    QTemporaryDir cacheDirectory;
+    QVERIFY(cacheDirectory.isValid());
+    manager.setResultCache(std::make_shared<RSE::Solution::ResultCache>(cacheDirectory.path()));
+    manager.solveRodSystem(project, options);
+    QTRY_COMPARE_WITH_TIMEOUT(manager.state(), SolutionManager::kDone, 10000);
+    QCOMPARE(states(), std::vector<SolutionManager::State>({SolutionManager::kQueued, SolutionManager::kPreprocessing,
+                                                            SolutionManager::kRunning, SolutionManager::kCaching,
+                                                            SolutionManager::kDone}));
+    QVERIFY(QFile::remove(rootPath + "Output/Result.klp"));
+    manager.solveRodSystem(project, options);
+    QCOMPARE(manager.state(), SolutionManager::kCaching);
+    QTRY_COMPARE_WITH_TIMEOUT(manager.state(), SolutionManager::kDone, 10000);
+    QCOMPARE(states(), std::vector<SolutionManager::State>({SolutionManager::kQueued, SolutionManager::kPreprocessing,
+                                                            SolutionManager::kCaching, SolutionManager::kDone}));
+    QVERIFY(QFile::exists(rootPath + "Output/Result.klp"));
+    QCOMPARE(numRodSystemSolved, 3);
+    manager.setResultCache(nullptr);
+    // Fail, if the solver writes a nonzero status
+    QVERIFY(writeScript(pathRodSystemSolver, "#!/bin/sh\necho 2 > Status.txt\n"));
+    manager.solveRodSystem(project, options);
+    QTRY_COMPARE_WITH_TIMEOUT(manager.state(), SolutionManager::kFailed, 10000);
+    QVERIFY(manager.transitions().back().message.contains("status 2"));
+    QCOMPARE(numRodSystemSolved, 3);
+    // Fail, if the solver exits without writing the status
+    QVERIFY(writeScript(pathRodSystemSolver, "#!/bin/sh\nexit 3\n"));
+    manager.solveRodSystem(project, options);
+    QTRY_COMPARE_WITH_TIMEOUT(manager.state(), SolutionManager::kFailed, 10000);
+    QVERIFY(manager.transitions().back().message.contains("code 3"));
+    QCOMPARE(numRodSystemSolved, 3);
+    // Interrupt the solver which lasts longer than the timeout
+    QVERIFY(writeScript(pathRodSystemSolver, "#!/bin/sh\nexec sleep 30\n"));
+    manager.setTimeout(SolutionManager::kRunning, 1);
+    manager.solveRodSystem(project, options);
+    QCOMPARE(manager.state(), SolutionManager::kRunning);
+    QTRY_COMPARE_WITH_TIMEOUT(manager.state(), SolutionManager::kFailed, 10000);
+    QVERIFY(manager.transitions().back().message.contains("has not finished"));
+    // Stop the solution by request
+    manager.setTimeout(SolutionManager::kRunning, 0);
+    manager.solveRodSystem(project, options);
+    QCOMPARE(manager.state(), SolutionManager::kRunning);
+    manager.stopSolution();
+    QCOMPARE(manager.state(), SolutionManager::kFailed);
+    QCOMPARE(manager.transitions().back().message, QString("Interrupted by the user"));
+    QVERIFY(!manager.isActive());
+    // Chain the export and optimization without blocking the caller
+    QVERIFY(writeScript(rootPath + "Output/KLPExport.exe", "#!/bin/sh\nsleep 1\n"));
+    QVERIFY(writeScript(rootPath + "Output/OptimalDamping.exe",
+                        "#!/bin/sh\necho Mode optimization step 1\nsleep 1\necho Optimization finished\n"));
+    QElapsedTimer timer;
+    timer.start();
+    manager.solveOptimization(project, options);
+    QVERIFY(timer.elapsed() < 1000);
+    QCOMPARE(manager.state(), SolutionManager::kExporting);
+    QTRY_COMPARE_WITH_TIMEOUT(manager.state(), SolutionManager::kDone, 10000);
+    QCOMPARE(numOptimizationSolved, 1);
+    QCOMPARE(numOptimizationSteps, 1);
+    QCOMPARE(states(), std::vector<SolutionManager::State>({SolutionManager::kQueued, SolutionManager::kPreprocessing,
+                                                            SolutionManager::kExporting, SolutionManager::kOptimizing,
+                                                            SolutionManager::kDone}));
+    // Break the chain, if the exporter fails
+    QVERIFY(writeScript(rootPath + "Output/KLPExport.exe", "#!/bin/sh\nexit 4\n"));
+    manager.solveOptimization(project, options);
+    QTRY_COMPARE_WITH_TIMEOUT(manager.state(), SolutionManager::kFailed, 10000);
+    QVERIFY(manager.transitions().back().message.contains("code 4"));
+    QCOMPARE(states(), std::vector<SolutionManager::State>({SolutionManager::kQueued, SolutionManager::kPreprocessing,
+                                                            SolutionManager::kExporting, SolutionManager::kFailed}));
+    QCOMPARE(numOptimizationSolved, 1);
+}
+
+//! Run the stand-in for the rod system solver by means of the solution manager
+void TestCore::manageStandInSolution()
+{
+    using RSE::Solution::SolutionManager;
+    using RSE::Solution::SolverLauncher;
+    QFileInfo standInSolver(STANDIN_SOLVER_PATH);
+    if (!standInSolver.exists())
+        QSKIP("The stand-in solver is not built");
+    QTemporaryDir rootDirectory;
+    QVERIFY(rootDirectory.isValid());
+    QString rootPath = rootDirectory.path() + "/";
+    QVERIFY(QDir(rootPath).mkpath("Input") && QDir(rootPath).mkpath("Output"));
+    QVERIFY(writeTemplate(rootPath + "Input/"));
+    QVERIFY(QFile::copy(standInSolver.absoluteFilePath(), rootPath + SolverLauncher::skNameRodSystemSolver));
+    Project project("Project", *mpDataBaseCables, *mpDamper, *mpRodSystem, Support(1e6, 2e6));
+    RSE::Solution::SolutionOptions options(6, 3, 1, 1e-3);
+    project.readTemplateData(rootPath + "Input/");
+    SolutionManager manager(rootPath, "Input/", "Output/");
+    SolverLauncher launcher;
+    launcher.setProgram(QString());
+    launcher.setArguments({"--frames", "5", "--nodes", "4", "--delay", "50"});
+    manager.setLauncher(launcher);
+    int numRodSystemSolved = 0;
+    connect(&manager, &SolutionManager::rodSystemSolved, [&numRodSystemSolved]() { ++numRodSystemSolved; });
+    QByteArray output;
+    connect(&manager, &SolutionManager::outputSent, [&output](QByteArray const& data) { output.append(data); });
+    // The result is generated from the inputs written by the project
+    QString pathResult = rootPath + "Output/Result.klp";
+    QByteArray results[2];
+    for (QByteArray& result : results)
+    {
+        manager.solveRodSystem(project, options);
+        QCOMPARE(manager.state(), SolutionManager::kRunning);
+        QTRY_COMPARE_WITH_TIMEOUT(manager.state(), SolutionManager::kDone, 20000);
+        QFile file(pathResult);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        result = file.readAll();
+        file.close();
+        QVERIFY(!result.isEmpty());
+    }
+    QCOMPARE(numRodSystemSolved, 2);
+    QVERIFY(output.contains("Step 5/5"));
+    QVERIFY(output.contains("Solution finished"));
+    // The stand-in writes the same result for the same inputs
+    QVERIFY(results[0] == results[1]);
+    // Fail with the status written by the stand-in
+    launcher.setArguments({"--frames", "1", "--nodes", "4", "--delay", "0", "--status", "5"});
+    manager.setLauncher(launcher);
+    manager.solveRodSystem(project, options);
+    QTRY_COMPARE_WITH_TIMEOUT(manager.state(), SolutionManager::kFailed, 20000);
+    QVERIFY(manager.transitions().back().message.contains("status 5"));
+    QCOMPARE(numRodSystemSolved, 2);
+}
+
+//! Keep the last lines only
+void TestCore::bufferLines()
+{
+    RingBuffer<QString> buffer(3);
+    for (int i = 0; i != 5; ++i)
+        buffer.push(QString::number(i));
+    QVERIFY(buffer.isFull());
+    QCOMPARE(buffer[0], QString("2"));
+    QCOMPARE(buffer.back(), QString("4"));
+    buffer.popFront(2);
+    QCOMPARE(buffer.size(), 1);
+    buffer.push("5");
+    buffer.push("6");
+    QCOMPARE(buffer[0], QString("4"));
+    QCOMPARE(buffer[2], QString("6"));
+    buffer.clear();
+    QVERIFY(buffer.isEmpty());
+}
+
+//! Write a log in the background and copy it with all the data passed before
+void TestCore::writeLog()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString pathFile = directory.filePath("Solver.log");
+    QString pathCopy = directory.filePath("Copy.log");
+    QByteArray content;
+    {
+        LogWriter writer(pathFile);
+        int numCopies = 0;
+        bool isCopied = false;
+        // The signal is emitted by the writing thread, so it is queued
+        connect(&writer, &LogWriter::copied, this, [&](QString const&, bool isOk) { ++numCopies; isCopied = isOk; });
+        for (int i = 0; i != 1000; ++i)
+        {
+            QByteArray line = "Step " + QByteArray::number(i) + "\n";
+            writer.write(line);
+            content.append(line);
+        }
+        writer.copy(pathCopy);
+        QTRY_COMPARE_WITH_TIMEOUT(numCopies, 1, 5000);
+        QVERIFY(isCopied);
+        writer.write("Finished\n");
+    }
+    QFile copy(pathCopy);
+    QVERIFY(copy.open(QIODevice::ReadOnly));
+    QCOMPARE(copy.readAll(), content);
+    QFile file(pathFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), content + "Finished\n");
+}
+
+//! Store and restore results of solutions evicting the least recently used ones
+void TestCore::cacheResults()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString rootPath = directory.filePath("Root/");
+    QString cachePath = directory.filePath("Cache/");
+    QVERIFY(QDir().mkpath(rootPath + "Input/") && QDir().mkpath(rootPath + "Output/"));
+    auto writeFile = [&rootPath](QString const& relativePathFile, QByteArray const& content)
+    {
+        QFile file(rootPath + relativePathFile);
+        return file.open(QIODeviceBase::WriteOnly) && file.write(content) == content.size();
+    };
+    auto readFile = [&rootPath](QString const& relativePathFile)
+    {
+        QFile file(rootPath + relativePathFile);
+        return file.open(QIODeviceBase::ReadOnly) ? file.readAll() : QByteArray();
+    };
+    QStringList inputFiles = {"Input/w1.prn", "Input/RODS.prn"};
+    QStringList outputFiles = {"Output/Result.klp", "Status.txt"};
+    // Files are copied in the background, and the completion is signalled
+    auto insert = [&rootPath, &outputFiles](ResultCache& cache, QByteArray const& key)
+    {
+        QSignalSpy spy(&cache, &ResultCache::inserted);
+        return cache.insert(key, rootPath, outputFiles) && spy.wait() && spy.front().at(0).toByteArray() == key
+               && spy.front().at(1).toBool();
+    };
+    auto restore = [&rootPath](ResultCache& cache, QByteArray const& key)
+    {
+        QSignalSpy spy(&cache, &ResultCache::restored);
+        return cache.restore(key, rootPath) && spy.wait() && spy.front().at(0).toByteArray() == key && spy.front().at(1).toBool();
+    };
+
+    // Keys depend on contents of inputs
+    QVERIFY(writeFile("Input/w1.prn", "1 2 3\n") && writeFile("Input/RODS.prn", "4\n"));
+    QByteArray firstKey = ResultCache::computeKey(rootPath, inputFiles, "solver");
+    QCOMPARE(ResultCache::computeKey(rootPath, inputFiles, "solver"), firstKey);
+    QVERIFY(ResultCache::computeKey(rootPath, inputFiles, "updated solver") != firstKey);
+    QVERIFY(writeFile("Input/RODS.prn", "5\n"));
+    QByteArray secondKey = ResultCache::computeKey(rootPath, inputFiles, "solver");
+    QVERIFY(secondKey != firstKey);
+    QVERIFY(writeFile("Input/RODS.prn", "6\n"));
+    QByteArray thirdKey = ResultCache::computeKey(rootPath, inputFiles, "solver");
+    // Keys depend on relative paths of inputs rather than their names or the root directory
+    QVERIFY(writeFile("Output/w1.prn", "1 2 3\n"));
+    QVERIFY(ResultCache::computeKey(rootPath, {"Input/w1.prn"}) != ResultCache::computeKey(rootPath, {"Output/w1.prn"}));
+    QCOMPARE(ResultCache::computeKey(rootPath + "Input/", {"w1.prn"}), ResultCache::computeKey(rootPath + "Output/", {"w1.prn"}));
+    QVERIFY(QFile::remove(rootPath + "Output/w1.prn"));
+
+    // Store the results and restore them in place of the modified ones
+    {
+        ResultCache cache(cachePath, ResultCache::skDefaultMaxSize, 2);
+        QVERIFY(!cache.restore(firstKey, rootPath));
+        QVERIFY(writeFile("Output/Result.klp", "first") && writeFile("Status.txt", "0"));
+        QVERIFY(insert(cache, firstKey));
+        QTest::qWait(10);
+        QVERIFY(writeFile("Output/Result.klp", "second"));
+        QVERIFY(insert(cache, secondKey));
+        QCOMPARE(cache.numEntries(), 2);
+        QCOMPARE(cache.size(), 13);
+        QVERIFY(restore(cache, firstKey));
+        QCOMPARE(readFile("Output/Result.klp"), QByteArray("first"));
+        QCOMPARE(readFile("Status.txt"), QByteArray("0"));
+        // The second entry is the least recently used one
+        QTest::qWait(10);
+        QVERIFY(writeFile("Output/Result.klp", "third"));
+        QVERIFY(insert(cache, thirdKey));
+        QCOMPARE(cache.numEntries(), 2);
+        QVERIFY(cache.contains(firstKey) && !cache.contains(secondKey) && cache.contains(thirdKey));
+    }
+
+    // Retrieve the entries stored previously and limit their size
+    ResultCache cache(cachePath);
+    QCOMPARE(cache.numEntries(), 2);
+    QVERIFY(restore(cache, thirdKey));
+    QCOMPARE(readFile("Output/Result.klp"), QByteArray("third"));
+    cache.setLimits(10, ResultCache::skDefaultMaxNumEntries);
+    QVERIFY(!cache.contains(firstKey) && cache.contains(thirdKey));
+    QVERIFY(!cache.insert(secondKey, rootPath, {"Output/Result.klp", "Input/w1.prn", "Status.txt"}));
+    // Entries become visible once they are completed
+    QVERIFY(cache.insert(secondKey, rootPath, outputFiles));
+    QVERIFY(!cache.contains(secondKey));
+    cache.waitForDone();
+    QVERIFY(cache.contains(secondKey));
+    cache.clear();
+    QCOMPARE(cache.numEntries(), 0);
+    QVERIFY(QDir(cachePath).entryList(QDir::Dirs | QDir::NoDotAndDotDot).isEmpty());
+}
+
+//! Prepare inputs of design variants concurrently
+void TestCore::runBatch()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString inputPath = directory.filePath("Input/");
+    QString outputPath = directory.filePath("Variants/");
+    QVERIFY(QDir().mkpath(inputPath) && writeTemplate(inputPath));
+    Project project("Project", *mpDataBaseCables, *mpDamper, *mpRodSystem, Support(1e6, 2e6));
+    RSE::Solution::SolutionOptions options(6, 3, 1, 1e-3);
+    IO io(directory.path());
+    QString pathProject = directory.filePath("Project" + io.extension());
+    io.saveAs(pathProject, project, options);
+
+    // Parse the manifests
+    QString errorString;
+    std::vector<BatchVariant> variants = BatchRunner::parseCSV("name;force;distances\n"
+                                                               "# Comment\n"
+                                                               "Light;2000;\n"
+                                                               "Heavy;4000;24 24 30 30\n"
+                                                               ";3000;\n",
+                                                               errorString);
+    QCOMPARE((int)variants.size(), 3);
+    QCOMPARE((int)variants[0].overrides.size(), 1);
+    QCOMPARE(variants[1].overrides.at("distances"), QString("24 24 30 30"));
+    QCOMPARE(variants[2].name, QString("Variant3"));
+    QVERIFY(BatchRunner::parseCSV("name,length\nA,1\n", errorString).empty());
+    QVERIFY(BatchRunner::parseCSV("name,force\nA,1\nA,2\n", errorString).empty());
+    std::vector<BatchVariant> jsonVariants = BatchRunner::parseJSON(R"({"variants": [{"name": "Long", "distances": [30, 30, 30, 30]},
+                                                                                      {"name": "Unknown", "cable": "None"}]})",
+                                                                    errorString);
+    QCOMPARE((int)jsonVariants.size(), 2);
+    QCOMPARE(jsonVariants[0].overrides.at("distances"), QString("30 30 30 30"));
+    variants.insert(variants.end(), jsonVariants.begin(), jsonVariants.end());
+
+    // Prepare the variants
+    BatchRunner runner(*mpDataBaseCables, inputPath, outputPath);
+    std::vector<BatchResult> results = runner.run(pathProject, variants, 2);
+    QCOMPARE(results.size(), variants.size());
+    for (int i = 0; i != 4; ++i)
+    {
+        QVERIFY2(results[i].isOk, qPrintable(results[i].message));
+        QCOMPARE(results[i].name, variants[i].name);
+        QVERIFY(results[i].isConverged);
+        QCOMPARE((int)results[i].lengths.size(), 4);
+        QVERIFY(!results[i].writtenFiles.isEmpty());
+        QCOMPARE(QDir(results[i].directory).entryList(QDir::Files).size(), results[i].writtenFiles.size());
+    }
+    QVERIFY(results[0].lengths[0] > results[2].lengths[0]);
+    QVERIFY(results[1].lengths[3] > results[1].lengths[0]);
+    QVERIFY(!results[4].isOk);
+    QVERIFY(!QDir(results[4].directory).exists());
+    QJsonObject summary = BatchRunner::summary(results).object();
+    QCOMPARE(summary["numVariants"].toInt(), 5);
+    QCOMPARE(summary["numFailed"].toInt(), 1);
+}
+
+//! Parse the solver output split into arbitrary chunks and estimate the remaining time
+void TestCore::parseTelemetry()
+{
+    using RSE::Solution::SolverTelemetry;
+    using RSE::Solution::TelemetrySample;
+    QByteArray output = "Reading the inputs\r\nStep 1/4: t = 0.25\nIteration 3, residual = 1.5D-03\nStep 2/4: t = 0.5, dt = 1e-2\r\n"
+                        "Mode optimization step\nMode optimization step 5 of 8\nError: diverged\nOptimization finished";
+    for (int i = 0; i <= output.size(); ++i)
+    {
+        SolverTelemetry telemetry;
+        telemetry.start(4);
+        telemetry.parse(output.left(i), 1000);
+        telemetry.parse(output.mid(i), 2000);
+        telemetry.finish();
+        auto const& samples = telemetry.samples();
+        QCOMPARE((int)telemetry.numLines(), 8);
+        QCOMPARE((int)samples.size(), 7);
+        QCOMPARE(samples[0].step, 1);
+        QCOMPARE(samples[0].numSteps, 4);
+        QCOMPARE(samples[0].time, 0.25);
+        QCOMPARE(samples[1].iteration, 3);
+        QCOMPARE(samples[1].residual, 1.5e-3);
+        QCOMPARE(samples[2].timeStep, 1e-2);
+        QCOMPARE(samples[3].event, TelemetrySample::kModeStep);
+        QCOMPARE(samples[3].step, 1);
+        QCOMPARE(samples[4].step, 5);
+        QCOMPARE(samples[4].numSteps, 8);
+        QCOMPARE(samples[5].event, TelemetrySample::kError);
+        QCOMPARE(samples[6].event, TelemetrySample::kFinished);
+        QCOMPARE((int)telemetry.remainingTime(), 0);
+    }
+    SolverTelemetry telemetry;
+    telemetry.parse("Step 1/10\n", 500);
+    QVERIFY(telemetry.remainingTime() < 0);
+    telemetry.parse("Step 2/10\nStep 3/10\n", 1500);
+    QCOMPARE(telemetry.progress(), 0.3);
+    QCOMPARE((int)telemetry.remainingTime(), 3500);
+    // Table of metrics
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString pathFile = directory.filePath("Metrics.csv");
+    QVERIFY(telemetry.write(pathFile));
+    QFile file(pathFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE((int)file.readAll().count('\n'), 4);
+}
+
+//! Write a template of a system consisted of four rods
+bool TestCore::writeTemplate(QString const& path)
+{
+    auto writeFile = [&path](QString const& fileName, QByteArray const& content)
+    {
+        QFile file(path + fileName);
+        return file.open(QIODeviceBase::WriteOnly) && file.write(content) == content.size();
+    };
+    QByteArray scalarContent = "1\n6\n";
+    for (int i = 1; i <= 6; ++i)
+        scalarContent += "1 " + QByteArray::number(i) + "\n0 1\n";
+    QByteArray vectorContent = "1\n10\n";
+    std::vector<std::vector<int>> vectorKeys = {{0, 1, 2, 3, 4, 5, 6, 7, 8}, {0, 1, 2, 3, 4, 5}, {0}, {0}, {0}, {1}, {0, 1}, {0, 1}, {0, 3}, {0, 1}};
+    for (int i = 0; i != (int)vectorKeys.size(); ++i)
+    {
+        vectorContent += QByteArray::number(vectorKeys[i].size()) + " " + QByteArray::number(i + 1) + "\n";
+        for (int key : vectorKeys[i])
+            vectorContent += QByteArray::number(key) + " 0 0 0\n";
+    }
+    QByteArray programContent;
+    for (int i = 0; i != 16; ++i)
+        programContent += i == 8 ? "    a    1    b    3    c\n" : (i == 15 ? "    m    6    n\n" : "line\n");
+    return writeFile(ProjectTemplate::skFileNameScalar, scalarContent) && writeFile(ProjectTemplate::skFileNameVector, vectorContent)
+           && writeFile(ProjectTemplate::skFileNameProject, "1\n") && writeFile(ProjectTemplate::skFileNameRods, "RODS\n 10 x\n")
+           && writeFile(ProjectTemplate::skFileNameProgram, programContent);
+}
+
+//! Write an executable script
+bool TestCore::writeScript(QString const& pathFile, QByteArray const& content)
+{
+    QFile file(pathFile);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size())
+        return false;
+    file.close();
+    return file.setPermissions(file.permissions() | QFileDevice::ExeOwner);
+}
+
 //! Destroy all the data used
 void TestCore::cleanupTestCase()
 {
@@ -66,6 +1329,6 @@ void TestCore::cleanupTestCase()
     delete mpRodSystem;
 }
 
-QTEST_APPLESS_MAIN(TestCore)
+QTEST_GUILESS_MAIN(TestCore)
 
 #include "testcore.moc"
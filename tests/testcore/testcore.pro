@@ -13,3 +13,11 @@ SOURCES += \
 
 include(../../src/core/core.pri)
 INCLUDEPATH += ../../src
+
+# Stand-in for the rod system solver built among the tools
+STANDIN_SOLVER_PATH = $$clean_path($$OUT_PWD/../../tools/standinsolver/standinsolver)
+win32 {
+    CONFIG(debug, debug|release): STANDIN_SOLVER_PATH = $$clean_path($$OUT_PWD/../../tools/standinsolver/debug/standinsolver.exe)
+    else: STANDIN_SOLVER_PATH = $$clean_path($$OUT_PWD/../../tools/standinsolver/release/standinsolver.exe)
+}
+DEFINES += STANDIN_SOLVER_PATH=\\\"$$STANDIN_SOLVER_PATH\\\"
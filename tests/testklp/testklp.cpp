@@ -6,7 +6,9 @@
  */
 
 #include <QtTest/QTest>
+#include <QTemporaryDir>
 #include "klp/result.h"
+#include "klp/generator.h"
 
 using namespace KLP;
 
@@ -17,6 +19,10 @@ class TestKLP : public QObject
 private slots:
     void readModal();
     void readDynamic();
+    void readGenerated_data();
+    void readGenerated();
+    void saveIndex();
+    void refreshResult();
     void cleanupTestCase();
 
 private:
@@ -45,6 +51,192 @@ void TestKLP::readDynamic()
     QCOMPARE(collection.numRods, 6);
 }
 
+void TestKLP::readGenerated_data()
+{
+    QTest::addColumn<int>("recordSets");
+    QTest::addColumn<bool>("isDoublePrecision");
+    QTest::newRow("modal") << (kGeometry | kModal) << false;
+    QTest::newRow("dynamic") << (kGeometry | kState | kDerivatives | kEnergy) << false;
+    QTest::newRow("double") << (int)kAllRecords << true;
+}
+
+//! Read synthetic files which are laid out as the solver does
+void TestKLP::readGenerated()
+{
+    QFETCH(int, recordSets);
+    QFETCH(bool, isDoublePrecision);
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    GeneratorOptions options;
+    options.numRods = 5;
+    options.numNodesRod = 7;
+    options.numFrames = 12;
+    options.numModes = 4;
+    options.recordSets = recordSets;
+    options.isDoublePrecision = isDoublePrecision;
+    options.ID = 42;
+    Generator generator(options);
+    QString pathFile = directory.path() + "/result.klp";
+    QVERIFY(generator.write(pathFile));
+    Result result(pathFile);
+    QCOMPARE((int)result.numTimeRecords(), options.numFrames);
+    QCOMPARE(result.info().ID, options.ID);
+    auto collection = result.getFrameCollection(3);
+    QCOMPARE(collection.numRods, options.numRods);
+    QCOMPARE(collection.time, (float)generator.time(3));
+    QCOMPARE((int)collection.naturalLength.size(), generator.numNodes());
+    QCOMPARE((int)collection.frequencies.size(), recordSets & kModal ? options.numModes : 0);
+    QCOMPARE((int)collection.state.displacements[0].size(), recordSets & kState ? generator.numNodes() : 0);
+    // Frames appended to a file which is still being written
+    QByteArray content = generator.header() + generator.frame(0) + generator.frame(1);
+    QFile file(pathFile);
+    QVERIFY(file.open(QIODevice::WriteOnly) && file.write(content) == content.size());
+    file.close();
+    result.update();
+    QCOMPARE((int)result.numTimeRecords(), 2);
+    QCOMPARE(result.getFrameCollection(0).numRods, options.numRods);
+}
+
+//! Map a file to memory and navigate through it by the index saved
+void TestKLP::saveIndex()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    GeneratorOptions options;
+    options.numFrames = 8;
+    options.isDoublePrecision = true;
+    Generator generator(options);
+    QString pathFile = directory.path() + "/result.klp";
+    QString pathIndex = Result::indexPathFile(pathFile);
+    QVERIFY(generator.write(pathFile));
+    QFile file(pathFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray content = file.readAll();
+    file.close();
+    Result result(pathFile);
+    QVERIFY(!result.verifyIndex(pathIndex));
+    // The mapping is read-only, so values of double precision are converted into separate buffers
+    {
+        Result mappedResult(pathFile, Result::kMapped);
+        QVERIFY(mappedResult.isMapped());
+        QVERIFY(mappedResult.index() == result.index());
+        QCOMPARE(mappedResult.time(), result.time());
+        QCOMPARE(*mappedResult.getFrameCollection(2).state.displacements[1][4], *result.getFrameCollection(2).state.displacements[1][4]);
+        QCOMPARE(*mappedResult.getFrameCollection(5).coordinates[1][2], *result.getFrameCollection(5).coordinates[1][2]);
+        QVERIFY(mappedResult.writeIndex(pathIndex));
+    }
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), content);
+    file.close();
+    QVERIFY(result.verifyIndex(pathIndex));
+    // The index is used as long as the file is intact
+    options.isDoublePrecision = false;
+    Generator singleGenerator(options);
+    QVERIFY(singleGenerator.write(pathFile));
+    {
+        Result singleResult(pathFile, Result::kMapped);
+        QVERIFY(!singleResult.verifyIndex(pathIndex));
+        QVERIFY(singleResult.writeIndex(pathIndex));
+        Result indexedResult(pathFile, Result::kMapped | Result::kUseIndexFile);
+        QVERIFY(indexedResult.index() == singleResult.index());
+        QCOMPARE(indexedResult.time(), singleResult.time());
+        QCOMPARE(*indexedResult.getFrameCollection(7).coordinates[0][3], *singleResult.getFrameCollection(7).coordinates[0][3]);
+    }
+    // Mappings are released before the file is truncated
+    content = singleGenerator.header() + singleGenerator.frame(0);
+    QVERIFY(file.open(QIODevice::WriteOnly) && file.write(content) == content.size());
+    file.close();
+    Result changedResult(pathFile, Result::kUseIndexFile);
+    QCOMPARE((int)changedResult.numTimeRecords(), 1);
+    QVERIFY(!changedResult.verifyIndex(pathIndex));
+}
+
+//! Reload a file which grows or gets rewritten, keeping the result intact until the new state is swapped in
+void TestKLP::refreshResult()
+{
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString pathFile = directory.path() + "/result.klp";
+    GeneratorOptions options;
+    options.numFrames = 8;
+    options.recordSets = kAllRecords;
+    // Files of double precision are read anew, since their values are converted in place
+    for (bool isDoublePrecision : {false, true})
+    {
+        options.isDoublePrecision = isDoublePrecision;
+        Generator generator(options);
+        QByteArray content = generator.header();
+        for (int i = 0; i != options.numFrames; ++i)
+            content += generator.frame(i);
+        // The last record is written partially
+        qint64 numWritten = content.size() / 2;
+        QFile file(pathFile);
+        QVERIFY(file.open(QIODevice::WriteOnly) && file.write(content.left(numWritten)) == numWritten);
+        file.close();
+        Result result(pathFile);
+        qint64 numTimeRecords = result.numTimeRecords();
+        QCOMPARE(result.checkChange(), Result::kUnchanged);
+        QVERIFY(file.open(QIODevice::Append) && file.write(content.mid(numWritten)) == content.size() - numWritten);
+        file.close();
+        QCOMPARE(result.checkChange(), Result::kAppended);
+        std::unique_ptr<Result> pUpdatedResult = result.reload(Result::kAppended);
+        QCOMPARE(result.numTimeRecords(), numTimeRecords);
+        result.swap(*pUpdatedResult);
+        Result expectedResult(pathFile);
+        QCOMPARE((int)result.numTimeRecords(), options.numFrames);
+        QVERIFY(result.index() == expectedResult.index());
+        QCOMPARE(result.time(), expectedResult.time());
+        for (int i = 0; i != options.numFrames - 1; ++i)
+        {
+            auto collection = result.getFrameCollection(i);
+            auto expectedCollection = expectedResult.getFrameCollection(i);
+            QCOMPARE(*collection.state.forces[1][5], *expectedCollection.state.forces[1][5]);
+            QCOMPARE(*collection.coordinates[2][7], *expectedCollection.coordinates[2][7]);
+        }
+        QCOMPARE(result.checkChange(), Result::kUnchanged);
+    }
+    // Appending in small pieces, so that frames are indexed from the middle of their headers and records
+    {
+        options.isDoublePrecision = false;
+        Generator generator(options);
+        QByteArray content = generator.header() + generator.frame(0);
+        QFile file(pathFile);
+        QVERIFY(file.open(QIODevice::WriteOnly) && file.write(content) == content.size());
+        file.close();
+        for (int i = 1; i != options.numFrames; ++i)
+            content += generator.frame(i);
+        Result result(pathFile);
+        qint64 numWritten = file.size();
+        qint64 const kStep = 997;
+        while (numWritten < content.size())
+        {
+            QByteArray part = content.mid(numWritten, kStep);
+            QVERIFY(file.open(QIODevice::Append) && file.write(part) == part.size());
+            file.close();
+            numWritten += part.size();
+            QCOMPARE(result.checkChange(), Result::kAppended);
+            result.swap(*result.reload(Result::kAppended));
+            Result expectedResult(pathFile);
+            QVERIFY(result.index() == expectedResult.index());
+            QCOMPARE(result.time(), expectedResult.time());
+            QCOMPARE(result.numTotalRecords(), expectedResult.numTotalRecords());
+        }
+        QCOMPARE((int)result.numTimeRecords(), options.numFrames);
+    }
+    // Rewriting and removal of the file
+    Result result(pathFile);
+    options.isDoublePrecision = false;
+    options.numFrames = 3;
+    QVERIFY(Generator(options).write(pathFile));
+    QCOMPARE(result.checkChange(), Result::kModified);
+    result.swap(*result.reload(Result::kModified));
+    QCOMPARE((int)result.numTimeRecords(), options.numFrames);
+    QVERIFY(QFile::remove(pathFile));
+    QCOMPARE(result.checkChange(), Result::kModified);
+    result.swap(*result.reload(Result::kModified));
+    QVERIFY(result.isEmpty());
+}
+
 //! Destroy all the data used
 void TestKLP::cleanupTestCase()
 {
@@ -2,5 +2,7 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     testcore \
+    benchcore \
     testklp \
+    benchklp \
     testviewers
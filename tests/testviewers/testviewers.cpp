@@ -15,6 +15,8 @@
 #include "viewers/graph.h"
 #include "viewers/spacetimegraphdata.h"
 #include "viewers/kinematicsgraphdata.h"
+#include "core/rodsystem.h"
+#include "central/rodsystemtablemodel.h"
 
 using namespace RSE::Core;
 using namespace RSE::Viewers;
@@ -30,6 +32,9 @@ private slots:
     void testGraphs();
     void testDataSlicer();
     void testKLPGraphViewer();
+    void parseDistances_data();
+    void parseDistances();
+    void notifyModification();
     void cleanupTestCase();
 
 private:
@@ -91,6 +96,50 @@ void TestViewers::testKLPGraphViewer()
     mpKLPGraphViewer->show();
 }
 
+void TestViewers::parseDistances_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<std::vector<double>>("distances");
+    QTest::newRow("comma separated") << "1,24\n2,30" << std::vector<double>{1.0, 24.0, 2.0, 30.0};
+    QTest::newRow("comma and point") << "1,24.5" << std::vector<double>{1.0, 24.5};
+    QTest::newRow("single line") << "24,30" << std::vector<double>{24.0, 30.0};
+    QTest::newRow("header") << "distance, m\n24 30\n" << std::vector<double>{24.0, 30.0};
+    QTest::newRow("tabulated decimal comma") << "24,5\t30,25\n12" << std::vector<double>{24.5, 30.25, 12.0};
+    QTest::newRow("semicolon decimal comma") << "24,5;30" << std::vector<double>{24.5, 30.0};
+    QTest::newRow("mixed line") << "span 24" << std::vector<double>();
+    QTest::newRow("malformed number") << "24.5.1\n30" << std::vector<double>();
+    QTest::newRow("nonpositive") << "24 0" << std::vector<double>();
+}
+
+//! Read distances pasted from spreadsheets and CSV files
+void TestViewers::parseDistances()
+{
+    QFETCH(QString, text);
+    QFETCH(std::vector<double>, distances);
+    QString errorString;
+    std::vector<double> result = RSE::Models::RodSystemTableModel::parseDistances(text, errorString);
+    QCOMPARE(result, distances);
+    QCOMPARE(errorString.isEmpty(), !distances.empty());
+}
+
+//! Report the modification of distances after the views have been notified about the rows inserted
+void TestViewers::notifyModification()
+{
+    using RSE::Models::RodSystemTableModel;
+    RSE::Core::Cable cable = {"Cable", 1.0, 1.0, 0.471, 8.25e10, 136.8e-6};
+    RSE::Core::RodSystem rodSystem({24.0, 24.0}, cable, 3000.0);
+    RodSystemTableModel model;
+    model.setRodSystem(&rodSystem);
+    QStringList events;
+    connect(&model, &RodSystemTableModel::rowsInserted, [&events]() { events.push_back("rowsInserted"); });
+    connect(&model, &RodSystemTableModel::dataChanged, [&events]() { events.push_back("dataChanged"); });
+    connect(&model, &RodSystemTableModel::modified, [&events]() { events.push_back("modified"); });
+    model.setDistances(1, {30.0, 36.0});
+    QCOMPARE(events, QStringList({"rowsInserted", "dataChanged", "modified"}));
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(rodSystem.distances(), std::vector<double>({24.0, 30.0, 36.0}));
+}
+
 //! Destroy all the viewers used
 void TestViewers::cleanupTestCase()
 {
@@ -6,8 +6,12 @@ CONFIG += c++latest
 
 TEMPLATE = app
 
+HEADERS += \
+    ../../src/central/rodsystemtablemodel.h
+
 SOURCES +=  \
-    testviewers.cpp
+    testviewers.cpp \
+    ../../src/central/rodsystemtablemodel.cpp
 
 include(../../src/core/core.pri)
 include(../../src/klp/klp.pri)
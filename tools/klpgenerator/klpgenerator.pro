@@ -0,0 +1,14 @@
+QT -= gui
+
+CONFIG += console
+CONFIG -= app_bundle
+
+CONFIG += c++latest
+
+TEMPLATE = app
+
+SOURCES += \
+    main.cpp
+
+include(../../src/klp/klp.pri)
+INCLUDEPATH += ../../src
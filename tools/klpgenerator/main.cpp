@@ -0,0 +1,103 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Generator of synthetic KLP files to test and benchmark readers and viewers
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <map>
+#include "klp/generator.h"
+
+using namespace KLP;
+
+//! Combine the names of record sets separated by commas
+int parseRecordSets(QString const& text, bool& isOk)
+{
+    static std::map<QString, int> const kNames = {{"geometry", kGeometry}, {"state", kState}, {"derivatives", kDerivatives},
+                                                  {"modal", kModal},       {"energy", kEnergy}, {"errors", kErrors},
+                                                  {"all", kAllRecords}};
+    int result = 0;
+    isOk = true;
+    for (QString const& name : text.split(',', Qt::SkipEmptyParts))
+    {
+        auto iter = kNames.find(name.trimmed().toLower());
+        if (iter == kNames.end())
+        {
+            isOk = false;
+            return 0;
+        }
+        result |= iter->second;
+    }
+    isOk = result != 0;
+    return result;
+}
+
+//! Startup point
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("klpgenerator");
+    QTextStream errorStream(stderr);
+    GeneratorOptions options;
+    // Specify the options
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generate a synthetic KLP file laid out as the solver does");
+    parser.addHelpOption();
+    parser.addPositionalArgument("output", "Path to the resulting file");
+    QCommandLineOption rodsOption("rods", "Number of rods", "number", QString::number(options.numRods));
+    QCommandLineOption nodesOption("nodes", "Number of nodes per rod", "number", QString::number(options.numNodesRod));
+    QCommandLineOption framesOption("frames", "Number of time frames", "number", QString::number(options.numFrames));
+    QCommandLineOption modesOption("modes", "Number of modes", "number", QString::number(options.numModes));
+    QCommandLineOption recordsOption("records", "Record sets: geometry, state, derivatives, modal, energy, errors or all",
+                                     "list", "geometry,state");
+    QCommandLineOption stepOption("time-step", "Time step between frames", "value", QString::number(options.timeStep));
+    QCommandLineOption idOption("id", "Identifier of the result", "number", QString::number(options.ID));
+    QCommandLineOption doubleOption("double", "Write values in double precision");
+    parser.addOptions({rodsOption, nodesOption, framesOption, modesOption, recordsOption, stepOption, idOption, doubleOption});
+    parser.process(app);
+    if (parser.positionalArguments().size() != 1)
+        parser.showHelp(1);
+    // Parse the values
+    bool isOk = true;
+    auto readInteger = [&parser, &isOk](QCommandLineOption const& option, int minValue)
+    {
+        bool isValueOk = false;
+        int value = parser.value(option).toInt(&isValueOk);
+        isOk = isOk && isValueOk && value >= minValue;
+        return value;
+    };
+    options.numRods = readInteger(rodsOption, 1);
+    options.numNodesRod = readInteger(nodesOption, 1);
+    options.numFrames = readInteger(framesOption, 1);
+    options.numModes = readInteger(modesOption, 0);
+    options.ID = readInteger(idOption, 0);
+    if (!isOk)
+    {
+        errorStream << "Sizes must be positive integers" << Qt::endl;
+        return 1;
+    }
+    options.recordSets = parseRecordSets(parser.value(recordsOption), isOk);
+    if (!isOk)
+    {
+        errorStream << "Unknown record sets: " << parser.value(recordsOption) << Qt::endl;
+        return 1;
+    }
+    options.timeStep = parser.value(stepOption).toDouble(&isOk);
+    if (!isOk || !(options.timeStep > 0.0))
+    {
+        errorStream << "Time step must be positive" << Qt::endl;
+        return 1;
+    }
+    options.isDoublePrecision = parser.isSet(doubleOption);
+    // Write the file
+    QString pathFile = parser.positionalArguments().front();
+    if (!Generator(options).write(pathFile))
+    {
+        errorStream << "Could not write the file " << pathFile << Qt::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,18 @@
+QT -= gui
+
+CONFIG += console
+CONFIG -= app_bundle
+
+CONFIG += c++latest
+
+TEMPLATE = app
+
+HEADERS += \
+    query.h
+
+SOURCES += \
+    main.cpp \
+    query.cpp
+
+include(../../src/klp/klp.pri)
+INCLUDEPATH += ../../src
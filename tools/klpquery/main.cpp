@@ -0,0 +1,263 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Query and export of KLP results without user interface
+ *
+ * Commands:
+ * - info: general information about results;
+ * - index: save sidecar indices of results or verify the saved ones;
+ * - extract: stream the selected quantities, nodes and time range to CSV or raw binary data;
+ * - stats: minimum, maximum and root mean square of the selected quantities.
+ *
+ * Files are mapped to memory and processed concurrently, while the output of each file is streamed through a buffer of fixed size
+ */
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <atomic>
+#include <cstdio>
+#include "query.h"
+
+using namespace KLP;
+
+//! Run a function for each file concurrently
+template<typename Function>
+void forEachFile(int numFiles, int numThreads, Function function)
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(numThreads > 0 ? numThreads : QThread::idealThreadCount());
+    for (int i = 0; i != numFiles; ++i)
+        pool.start([&function, i]() { function(i); });
+    pool.waitForDone();
+}
+
+/*!
+ * \brief Name the outputs of several files after the files
+ *
+ * Files of the same name from different directories are named after their paths relative to the common directory
+ * \return Names without extensions or an empty list, if the names still coincide
+ */
+QStringList outputNames(QStringList const& files)
+{
+    QStringList names, paths;
+    for (QString const& file : files)
+    {
+        QFileInfo info(file);
+        names.push_back(info.completeBaseName());
+        paths.push_back(info.absoluteFilePath());
+    }
+    // Find the common directory of the files
+    QStringList commonParts = QFileInfo(paths.front()).absolutePath().split('/');
+    for (QString const& path : paths)
+    {
+        QStringList parts = QFileInfo(path).absolutePath().split('/');
+        int numCommon = 0;
+        while (numCommon < commonParts.size() && numCommon < parts.size() && commonParts[numCommon] == parts[numCommon])
+            ++numCommon;
+        commonParts.resize(numCommon);
+    }
+    QDir commonDir(commonParts.join('/') + '/');
+    // Rename the files which collide. Names are compared regardless of their case, so that they suit any file system
+    QStringList result = names;
+    for (int i = 0; i != names.size(); ++i)
+    {
+        if (names.count(names[i], Qt::CaseInsensitive) > 1)
+        {
+            QFileInfo relativeInfo(commonDir.relativeFilePath(paths[i]));
+            if (relativeInfo.path() != ".")
+                result[i] = QString(relativeInfo.path() + '/' + names[i]).replace('/', '_').replace(':', '_');
+        }
+    }
+    for (QString const& name : result)
+    {
+        if (result.count(name, Qt::CaseInsensitive) > 1)
+            return QStringList();
+    }
+    return result;
+}
+
+//! Startup point
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("klpquery");
+    QTextStream errorStream(stderr);
+    // Specify the options
+    QStringList names;
+    for (Quantity const& quantity : quantities())
+        names.push_back(quantity.name);
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QString("Query KLP results.\nQuantities: %1").arg(names.join(", ")));
+    parser.addHelpOption();
+    parser.addPositionalArgument("command", "info, index, extract or stats");
+    parser.addPositionalArgument("files", "KLP files", "files...");
+    QCommandLineOption selectOption("select", "Quantities or records separated by commas. By default, all of them", "names");
+    QCommandLineOption nodesOption("nodes", "Indices of nodes and their ranges, e.g. 0-10,15. By default, all of them", "ranges");
+    QCommandLineOption timeOption("time", "Range of time in the form start:end, either of the bounds can be omitted", "range");
+    QCommandLineOption formatOption("format", "Format of extracted data: csv or raw", "format", "csv");
+    QCommandLineOption outputOption("output", "Output file. If several files are extracted, the output directory", "path");
+    QCommandLineOption verifyOption("verify", "Verify the saved indices instead of saving them");
+    QCommandLineOption noIndexOption("no-index", "Scan files instead of using their saved indices");
+    QCommandLineOption jobsOption("jobs", "Number of files processed concurrently. By default, the number of cores", "number", "0");
+    parser.addOptions({selectOption, nodesOption, timeOption, formatOption, outputOption, verifyOption, noIndexOption, jobsOption});
+    parser.process(app);
+    QStringList arguments = parser.positionalArguments();
+    if (arguments.size() < 2)
+        parser.showHelp(2);
+    QString command = arguments.takeFirst();
+    QStringList const& files = arguments;
+    int numFiles = files.size();
+    int numThreads = parser.value(jobsOption).toInt();
+    int readOptions = Result::kMapped | (parser.isSet(noIndexOption) ? 0 : Result::kUseIndexFile);
+    std::atomic<int> numFailed = 0;
+    auto reportMissing = [&numFailed](Result const& result)
+    {
+        if (!result.isEmpty())
+            return false;
+        QTextStream(stderr) << "Error: could not read the file " << result.pathFile() << Qt::endl;
+        ++numFailed;
+        return true;
+    };
+    QFile standardOutput;
+    standardOutput.open(stdout, QIODeviceBase::WriteOnly);
+
+    // Index files
+    if (command == "index")
+    {
+        bool isVerify = parser.isSet(verifyOption);
+        std::vector<QString> states(numFiles);
+        forEachFile(numFiles, numThreads, [&](int i)
+        {
+            Result result(files[i], Result::kMapped);
+            if (reportMissing(result))
+                return;
+            QString pathIndex = Result::indexPathFile(files[i]);
+            bool isOk = isVerify ? result.verifyIndex(pathIndex) : result.writeIndex(pathIndex);
+            states[i] = isVerify ? (isOk ? "valid" : "invalid") : (isOk ? "written" : "failed");
+            if (!isOk)
+                ++numFailed;
+        });
+        QTextStream outputStream(&standardOutput);
+        for (int i = 0; i != numFiles; ++i)
+        {
+            if (!states[i].isEmpty())
+                outputStream << files[i] << ": " << states[i] << Qt::endl;
+        }
+        return numFailed > 0 ? 1 : 0;
+    }
+
+    // Process the information which does not depend on the selection
+    if (command == "info")
+    {
+        std::vector<QByteArray> outputs(numFiles);
+        forEachFile(numFiles, numThreads, [&](int i)
+        {
+            Result result(files[i], readOptions);
+            if (reportMissing(result))
+                return;
+            QBuffer buffer(&outputs[i]);
+            buffer.open(QIODeviceBase::WriteOnly);
+            BufferedWriter writer(buffer);
+            writeInfo(result, writer);
+        });
+        BufferedWriter writer(standardOutput);
+        writeInfoHeader(writer);
+        for (QByteArray const& output : outputs)
+            writer.write(output.constData(), output.size());
+        return numFailed > 0 ? 1 : 0;
+    }
+
+    // Parse the selection
+    if (command != "extract" && command != "stats")
+    {
+        errorStream << "Error: unknown command " << command << Qt::endl;
+        return 2;
+    }
+    Selection selection;
+    QString errorString;
+    if (!parseSelection(parser.value(selectOption), parser.value(nodesOption), parser.value(timeOption), selection, errorString))
+    {
+        errorStream << "Error: " << errorString << Qt::endl;
+        return 2;
+    }
+
+    // Compute statistics
+    if (command == "stats")
+    {
+        std::vector<QByteArray> outputs(numFiles);
+        forEachFile(numFiles, numThreads, [&](int i)
+        {
+            Result result(files[i], readOptions);
+            if (reportMissing(result))
+                return;
+            QBuffer buffer(&outputs[i]);
+            buffer.open(QIODeviceBase::WriteOnly);
+            BufferedWriter writer(buffer);
+            writeStats(result, selection, writer);
+        });
+        BufferedWriter writer(standardOutput);
+        writeStatsHeader(writer);
+        for (QByteArray const& output : outputs)
+            writer.write(output.constData(), output.size());
+        return numFailed > 0 ? 1 : 0;
+    }
+
+    // Extract data
+    QString format = parser.value(formatOption).toLower();
+    if (format != "csv" && format != "raw")
+    {
+        errorStream << "Error: unknown format " << format << Qt::endl;
+        return 2;
+    }
+    ExtractFormat extractFormat = format == "csv" ? ExtractFormat::kCSV : ExtractFormat::kRaw;
+    QString outputPath = parser.value(outputOption);
+    QStringList outputFileNames;
+    if (numFiles > 1)
+    {
+        if (outputPath.isEmpty() || !QDir().mkpath(outputPath))
+        {
+            errorStream << "Error: the output directory is required to extract several files" << Qt::endl;
+            return 2;
+        }
+        outputFileNames = outputNames(files);
+        if (outputFileNames.isEmpty())
+        {
+            errorStream << "Error: outputs of several files coincide. Each file should be listed once" << Qt::endl;
+            return 2;
+        }
+    }
+    forEachFile(numFiles, numThreads, [&](int i)
+    {
+        Result result(files[i], readOptions);
+        if (reportMissing(result))
+            return;
+        QFile file;
+        if (numFiles > 1)
+            file.setFileName(QDir(outputPath).filePath(outputFileNames[i] + '.' + format));
+        else if (!outputPath.isEmpty())
+            file.setFileName(outputPath);
+        bool isOpened = file.fileName().isEmpty() ? file.open(stdout, QIODeviceBase::WriteOnly) : file.open(QIODeviceBase::WriteOnly);
+        if (!isOpened)
+        {
+            QTextStream(stderr) << "Error: could not open the output of the file " << files[i] << Qt::endl;
+            ++numFailed;
+            return;
+        }
+        BufferedWriter writer(file);
+        extract(result, selection, extractFormat, writer);
+        if (!writer.flush())
+        {
+            QTextStream(stderr) << "Error: could not write the output of the file " << files[i] << Qt::endl;
+            ++numFailed;
+        }
+    });
+    return numFailed > 0 ? 1 : 0;
+}
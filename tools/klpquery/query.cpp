@@ -0,0 +1,422 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Definition of the queries of KLP results
+ */
+
+#include <QFileInfo>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include "query.h"
+
+using namespace KLP;
+
+static int const skNumComponents = 12;
+
+static void writeField(BufferedWriter& writer, QString const& text);
+
+//! Check if a node is selected
+bool Selection::isNodeSelected(qint64 iNode) const
+{
+    if (nodes.empty())
+        return true;
+    for (auto const& [first, last] : nodes)
+    {
+        if (iNode >= first && iNode <= last)
+            return true;
+    }
+    return false;
+}
+
+//! Index of the last node selected or -1, if all the nodes are selected
+qint64 Selection::maxNodeSelected() const
+{
+    qint64 result = -1;
+    for (auto const& range : nodes)
+        result = std::max(result, range.second);
+    return result;
+}
+
+BufferedWriter::BufferedWriter(QIODevice& device)
+    : mDevice(device)
+    , mBuffer(skCapacity)
+{
+}
+
+BufferedWriter::~BufferedWriter()
+{
+    flush();
+}
+
+void BufferedWriter::write(char const* pData, qsizetype size)
+{
+    if (size > skCapacity - mSize)
+        flush();
+    // Data which does not fit the buffer is written directly
+    if (size >= skCapacity)
+    {
+        mIsOk = mIsOk && mDevice.write(pData, size) == size;
+        return;
+    }
+    std::memcpy(mBuffer.data() + mSize, pData, size);
+    mSize += size;
+}
+
+void BufferedWriter::write(char symbol)
+{
+    if (mSize == skCapacity)
+        flush();
+    mBuffer[mSize++] = symbol;
+}
+
+void BufferedWriter::write(QString const& text)
+{
+    QByteArray data = text.toUtf8();
+    write(data.constData(), data.size());
+}
+
+//! Write a number in the shortest form which is read back exactly
+template<typename T>
+void BufferedWriter::format(T value)
+{
+    const qsizetype kMaxLength = 32;
+
+    if (skCapacity - mSize < kMaxLength)
+        flush();
+    char* pEnd = std::to_chars(mBuffer.data() + mSize, mBuffer.data() + skCapacity, value).ptr;
+    mSize = pEnd - mBuffer.data();
+}
+
+void BufferedWriter::writeNumber(double value)
+{
+    format(value);
+}
+
+void BufferedWriter::writeNumber(float value)
+{
+    format(value);
+}
+
+void BufferedWriter::writeNumber(qint64 value)
+{
+    format(value);
+}
+
+//! Pass the buffered data to the device
+bool BufferedWriter::flush()
+{
+    if (mSize > 0)
+        mIsOk = mIsOk && mDevice.write(mBuffer.data(), mSize) == mSize;
+    mSize = 0;
+    return mIsOk;
+}
+
+//! Quantities which can be queried
+std::vector<Quantity> const& KLP::quantities()
+{
+    static std::vector<Quantity> const skQuantities = []()
+    {
+        std::vector<Quantity> result = {
+            {"Xi", [](FrameCollection const& c) { return c.parameter; }},
+            {"S", [](FrameCollection const& c) { return c.naturalLength; }},
+            {"SS", [](FrameCollection const& c) { return c.accumulatedNaturalLength; }},
+            {"X1", [](FrameCollection const& c) { return c.coordinates[0]; }},
+            {"X2", [](FrameCollection const& c) { return c.coordinates[1]; }},
+            {"X3", [](FrameCollection const& c) { return c.coordinates[2]; }},
+            {"EPS", [](FrameCollection const& c) { return c.strain; }},
+            {"MF", [](FrameCollection const& c) { return c.frequencies; }},
+            {"EN:kinetic", [](FrameCollection const& c) { return c.energy.kinetic; }},
+            {"EN:potential", [](FrameCollection const& c) { return c.energy.potential; }},
+            {"EN:full", [](FrameCollection const& c) { return c.energy.full; }}};
+        // Components of the state vectors
+        std::vector<std::pair<QString, StateFrame FrameCollection::*>> const states = {
+            {"U", &FrameCollection::state},
+            {"Ul", &FrameCollection::projectedState},
+            {"Ut", &FrameCollection::firstDerivativeState},
+            {"Utt", &FrameCollection::secondDerivativeState},
+            {"ERR", &FrameCollection::errorState}};
+        QStringList const components = {"U1", "U2", "U3", "w1", "w2", "w3", "Q1", "Q2", "Q3", "M1", "M2", "M3"};
+        for (auto const& [record, pState] : states)
+        {
+            for (int i = 0; i != skNumComponents; ++i)
+            {
+                auto get = [pState, i](FrameCollection const& c)
+                {
+                    StateFrame const& state = c.*pState;
+                    FloatFrameObject const* groups[] = {state.displacements, state.rotations, state.forces, state.moments};
+                    return groups[i / kNumDirections][i % kNumDirections];
+                };
+                result.push_back({record + ':' + components[i], get});
+            }
+        }
+        return result;
+    }();
+    return skQuantities;
+}
+
+/*!
+ * \brief Parse the selection specified by options of the command line
+ * \param quantityNames Names of quantities or records separated by commas. A record stands for all its components
+ * \param nodeRanges Indices of nodes and their inclusive ranges separated by commas, e.g. "0-10,15"
+ * \param timeRange Inclusive range of time in the form "start:end", where either of the bounds can be omitted
+ */
+bool KLP::parseSelection(QString const& quantityNames, QString const& nodeRanges, QString const& timeRange, Selection& selection,
+                         QString& errorString)
+{
+    // Quantities
+    selection.quantities.clear();
+    QStringList names = quantityNames.split(',', Qt::SkipEmptyParts);
+    for (Quantity const& quantity : quantities())
+    {
+        bool isSelected = names.isEmpty();
+        for (QString const& name : names)
+        {
+            QString trimmedName = name.trimmed();
+            isSelected = isSelected || quantity.name.compare(trimmedName, Qt::CaseInsensitive) == 0
+                         || quantity.name.startsWith(trimmedName + ':', Qt::CaseInsensitive);
+        }
+        if (isSelected)
+            selection.quantities.push_back(&quantity);
+    }
+    for (QString const& name : names)
+    {
+        QString trimmedName = name.trimmed();
+        auto isMatched = [&trimmedName](Quantity const* pQuantity)
+        {
+            return pQuantity->name.compare(trimmedName, Qt::CaseInsensitive) == 0
+                   || pQuantity->name.startsWith(trimmedName + ':', Qt::CaseInsensitive);
+        };
+        if (std::none_of(selection.quantities.begin(), selection.quantities.end(), isMatched))
+        {
+            errorString = QString("Unknown quantity '%1'").arg(trimmedName);
+            return false;
+        }
+    }
+    // Nodes
+    selection.nodes.clear();
+    for (QString const& range : nodeRanges.split(',', Qt::SkipEmptyParts))
+    {
+        QStringList bounds = range.split('-');
+        bool isFirstOk = false;
+        bool isLastOk = false;
+        qint64 first = bounds.front().trimmed().toLongLong(&isFirstOk);
+        qint64 last = bounds.back().trimmed().toLongLong(&isLastOk);
+        if (bounds.size() > 2 || !isFirstOk || !isLastOk || first < 0 || last < first)
+        {
+            errorString = QString("Invalid range of nodes '%1'").arg(range);
+            return false;
+        }
+        selection.nodes.push_back({first, last});
+    }
+    // Time
+    if (!timeRange.isEmpty())
+    {
+        QStringList bounds = timeRange.split(':');
+        bool isOk = bounds.size() == 2;
+        if (isOk && !bounds[0].trimmed().isEmpty())
+            selection.startTime = bounds[0].toDouble(&isOk);
+        if (isOk && !bounds[1].trimmed().isEmpty())
+            selection.endTime = bounds[1].toDouble(&isOk);
+        if (!isOk || selection.startTime > selection.endTime)
+        {
+            errorString = QString("Invalid range of time '%1'").arg(timeRange);
+            return false;
+        }
+    }
+    return true;
+}
+
+void KLP::writeInfoHeader(BufferedWriter& writer)
+{
+    writer.write(QString("file,ID,created,sizeKb,numRecords,numFrames,numRods,startTime,endTime\n"));
+}
+
+//! Write the general information about a result
+void KLP::writeInfo(Result const& result, BufferedWriter& writer)
+{
+    ResultInfo info = result.info();
+    writeField(writer, result.pathFile());
+    writer.write(',');
+    writer.writeNumber((qint64)info.ID);
+    writer.write(',');
+    writer.write(info.creationDateTime.toString(Qt::ISODate));
+    writer.write(',');
+    writer.writeNumber((qint64)info.fileSize);
+    writer.write(',');
+    writer.writeNumber(info.numTotalRecords);
+    writer.write(',');
+    writer.writeNumber(info.numTimeRecords);
+    writer.write(',');
+    writer.writeNumber((qint64)result.numRods(0));
+    // Time is stored in single precision
+    QVector<double> const& time = result.time();
+    writer.write(',');
+    if (!time.isEmpty())
+        writer.writeNumber((float)time.front());
+    writer.write(',');
+    if (!time.isEmpty())
+        writer.writeNumber((float)time.back());
+    writer.write('\n');
+}
+
+void KLP::writeStatsHeader(BufferedWriter& writer)
+{
+    writer.write(QString("file,quantity,count,min,max,rms\n"));
+}
+
+//! Write the minimum, maximum and root mean square of each quantity over the selected nodes and frames
+void KLP::writeStats(Result const& result, Selection const& selection, BufferedWriter& writer)
+{
+    struct Statistics
+    {
+        qint64 count = 0;
+        float min = std::numeric_limits<float>::infinity();
+        float max = -std::numeric_limits<float>::infinity();
+        double sumSquares = 0.0;
+    };
+    std::size_t numQuantities = selection.quantities.size();
+    std::vector<Statistics> statistics(numQuantities);
+    qint64 numFrames = std::min(result.numTimeRecords(), result.numTotalRecords() - 1);
+    for (qint64 iFrame = 0; iFrame < numFrames; ++iFrame)
+    {
+        if (!selection.isTimeSelected(result.time()[iFrame]))
+            continue;
+        FrameCollection collection = result.getFrameCollection(iFrame);
+        for (std::size_t i = 0; i != numQuantities; ++i)
+        {
+            FloatFrameObject object = selection.quantities[i]->get(collection);
+            Statistics& item = statistics[i];
+            qint64 iNode = 0;
+            for (auto iter = object.begin(); iter != object.end(); ++iter, ++iNode)
+            {
+                if (!selection.isNodeSelected(iNode))
+                    continue;
+                float value = *iter;
+                ++item.count;
+                item.min = std::min(item.min, value);
+                item.max = std::max(item.max, value);
+                item.sumSquares += (double)value * value;
+            }
+        }
+    }
+    for (std::size_t i = 0; i != numQuantities; ++i)
+    {
+        Statistics const& item = statistics[i];
+        writeField(writer, result.pathFile());
+        writer.write(',');
+        writer.write(selection.quantities[i]->name);
+        writer.write(',');
+        writer.writeNumber(item.count);
+        if (item.count > 0)
+        {
+            writer.write(',');
+            writer.writeNumber(item.min);
+            writer.write(',');
+            writer.writeNumber(item.max);
+            writer.write(',');
+            writer.writeNumber(std::sqrt(item.sumSquares / item.count));
+        }
+        else
+        {
+            writer.write(",,,", 3);
+        }
+        writer.write('\n');
+    }
+}
+
+/*!
+ * \brief Stream the selected data frame by frame
+ *
+ * CSV contains a row per frame and node, while cells of quantities which do not have the node are left empty.
+ * Raw data consists of frames, each of which is made up of the time (double), number of nodes and number of quantities (uint32),
+ * followed by the values of each quantity at the selected nodes (float). Absent values are represented by NaN.
+ * Numbers are in the native byte order
+ */
+void KLP::extract(Result const& result, Selection const& selection, ExtractFormat format, BufferedWriter& writer)
+{
+    bool isCSV = format == ExtractFormat::kCSV;
+    std::size_t numQuantities = selection.quantities.size();
+    if (isCSV)
+    {
+        writer.write(QString("frame,time,node"));
+        for (Quantity const* pQuantity : selection.quantities)
+        {
+            writer.write(',');
+            writer.write(pQuantity->name);
+        }
+        writer.write('\n');
+    }
+    std::vector<FloatFrameObject> objects(numQuantities);
+    std::vector<qint64> nodes;
+    qint64 numFrames = std::min(result.numTimeRecords(), result.numTotalRecords() - 1);
+    qint64 maxNode = selection.maxNodeSelected();
+    for (qint64 iFrame = 0; iFrame < numFrames; ++iFrame)
+    {
+        double time = result.time()[iFrame];
+        if (!selection.isTimeSelected(time))
+            continue;
+        FrameCollection collection = result.getFrameCollection(iFrame);
+        qint64 numNodes = 0;
+        for (std::size_t i = 0; i != numQuantities; ++i)
+        {
+            objects[i] = selection.quantities[i]->get(collection);
+            numNodes = std::max(numNodes, objects[i].size());
+        }
+        if (maxNode >= 0)
+            numNodes = std::min(numNodes, maxNode + 1);
+        nodes.clear();
+        for (qint64 iNode = 0; iNode < numNodes; ++iNode)
+        {
+            if (selection.isNodeSelected(iNode))
+                nodes.push_back(iNode);
+        }
+        if (isCSV)
+        {
+            for (qint64 iNode : nodes)
+            {
+                writer.writeNumber(iFrame);
+                writer.write(',');
+                writer.writeNumber((float)time);
+                writer.write(',');
+                writer.writeNumber(iNode);
+                for (FloatFrameObject const& object : objects)
+                {
+                    writer.write(',');
+                    if (iNode < object.size())
+                        writer.writeNumber(*object[iNode]);
+                }
+                writer.write('\n');
+            }
+        }
+        else
+        {
+            quint32 header[] = {(quint32)nodes.size(), (quint32)numQuantities};
+            writer.write((char const*)&time, sizeof(time));
+            writer.write((char const*)header, sizeof(header));
+            for (FloatFrameObject const& object : objects)
+            {
+                for (qint64 iNode : nodes)
+                {
+                    float value = iNode < object.size() ? *object[iNode] : std::numeric_limits<float>::quiet_NaN();
+                    writer.write((char const*)&value, sizeof(value));
+                }
+            }
+        }
+    }
+}
+
+//! Write a text field of CSV quoting it, if necessary
+void writeField(BufferedWriter& writer, QString const& text)
+{
+    if (!text.contains(',') && !text.contains('"') && !text.contains('\n'))
+    {
+        writer.write(text);
+        return;
+    }
+    QString quoted = text;
+    quoted.replace('"', "\"\"");
+    writer.write('"' + quoted + '"');
+}
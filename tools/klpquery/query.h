@@ -0,0 +1,89 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Declaration of the queries of KLP results
+ */
+
+#ifndef QUERY_H
+#define QUERY_H
+
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include <limits>
+#include <vector>
+#include "klp/result.h"
+
+namespace KLP
+{
+
+//! Quantity of a frame identified by its record and component
+struct Quantity
+{
+    //! Name of the record followed by the name of the component, if the record contains several ones
+    QString name;
+    std::function<FloatFrameObject(FrameCollection const&)> get;
+};
+
+//! Quantities, nodes and time range to query
+struct Selection
+{
+    bool isNodeSelected(qint64 iNode) const;
+    bool isTimeSelected(double time) const { return time >= startTime && time <= endTime; }
+    qint64 maxNodeSelected() const;
+
+    std::vector<Quantity const*> quantities;
+    //! Inclusive ranges of indices of nodes. If empty, all the nodes are selected
+    std::vector<std::pair<qint64, qint64>> nodes;
+    double startTime = -std::numeric_limits<double>::infinity();
+    double endTime = std::numeric_limits<double>::infinity();
+};
+
+//! Output of text and binary data through a buffer of fixed size
+class BufferedWriter
+{
+public:
+    BufferedWriter(QIODevice& device);
+    ~BufferedWriter();
+    void write(char const* pData, qsizetype size);
+    void write(char symbol);
+    void write(QString const& text);
+    void writeNumber(double value);
+    void writeNumber(float value);
+    void writeNumber(qint64 value);
+    bool flush();
+    bool isOk() const { return mIsOk; }
+
+private:
+    template<typename T>
+    void format(T value);
+
+private:
+    static qsizetype const skCapacity = 1 << 20;
+    QIODevice& mDevice;
+    std::vector<char> mBuffer;
+    qsizetype mSize = 0;
+    bool mIsOk = true;
+};
+
+//! Formats of extracted data
+enum class ExtractFormat
+{
+    kCSV,
+    kRaw
+};
+
+std::vector<Quantity> const& quantities();
+bool parseSelection(QString const& quantityNames, QString const& nodeRanges, QString const& timeRange, Selection& selection,
+                    QString& errorString);
+void writeInfoHeader(BufferedWriter& writer);
+void writeInfo(Result const& result, BufferedWriter& writer);
+void writeStatsHeader(BufferedWriter& writer);
+void writeStats(Result const& result, Selection const& selection, BufferedWriter& writer);
+void extract(Result const& result, Selection const& selection, ExtractFormat format, BufferedWriter& writer);
+
+}
+
+#endif // QUERY_H
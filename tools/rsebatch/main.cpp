@@ -0,0 +1,101 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Preparation of solver inputs for a series of design variants without user interface
+ *
+ * A base project is modified by the parameters listed in a CSV or JSON manifest, one variant per row or object.
+ * Inputs of each variant are written into its own directory, and the summary of the batch is printed as JSON.
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include "core/batchrunner.h"
+
+using namespace RSE::Core;
+
+//! Startup point
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("rsebatch");
+    QTextStream errorStream(stderr);
+    // Specify the options
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QString("Prepare solver inputs for design variants.\nParameters of variants: %1")
+                                          .arg(BatchRunner::parameterNames().join(", ")));
+    parser.addHelpOption();
+    parser.addPositionalArgument("project", "Base project");
+    QCommandLineOption manifestOption("manifest", "CSV or JSON file which lists variants", "path");
+    QCommandLineOption outputOption("output", "Directory where inputs of variants are written", "path", "Variants/");
+    QCommandLineOption dataOption("data", "Directory of the data", "path", "data/");
+    QCommandLineOption cablesOption("cables", "Name of the database of cables", "name", "Провода.txt");
+    QCommandLineOption templateOption("template", "Directory of the template. By default, the input directory of the data", "path");
+    QCommandLineOption jobsOption("jobs", "Number of variants prepared concurrently. By default, the number of cores", "number", "0");
+    QCommandLineOption summaryOption("summary", "File to write the summary to instead of the standard output", "path");
+    parser.addOptions({manifestOption, outputOption, dataOption, cablesOption, templateOption, jobsOption, summaryOption});
+    parser.process(app);
+    QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 1)
+        parser.showHelp(2);
+    QString pathProject = arguments.front();
+    // Read the variants. Without a manifest, the base project is prepared as is
+    std::vector<BatchVariant> variants;
+    if (parser.isSet(manifestOption))
+    {
+        QString errorString;
+        variants = BatchRunner::readManifest(parser.value(manifestOption), errorString);
+        if (variants.empty())
+        {
+            errorStream << "Error: " << (errorString.isEmpty() ? QString("the manifest is empty") : errorString) << Qt::endl;
+            return 2;
+        }
+    }
+    else
+    {
+        variants.push_back({QFileInfo(pathProject).baseName(), QString(), {}});
+    }
+    // Prepare the variants
+    QString dataPath = parser.value(dataOption);
+    if (!dataPath.endsWith('/'))
+        dataPath.append('/');
+    QString templatePath = parser.isSet(templateOption) ? parser.value(templateOption) : dataPath + "Input/";
+    DataBaseCables dataBaseCables(dataPath, parser.value(cablesOption));
+    BatchRunner runner(dataBaseCables, templatePath, parser.value(outputOption));
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<BatchResult> results = runner.run(pathProject, variants, parser.value(jobsOption).toInt());
+    qint64 duration = timer.elapsed();
+    // Report the results
+    int numFailed = 0;
+    for (BatchResult const& result : results)
+    {
+        if (!result.isOk)
+        {
+            ++numFailed;
+            errorStream << result.name << ": " << result.message << Qt::endl;
+        }
+    }
+    errorStream << QString("%1 of %2 variants prepared in %3 s").arg(results.size() - numFailed).arg(results.size()).arg(duration / 1000.0)
+                << Qt::endl;
+    QByteArray summary = BatchRunner::summary(results).toJson();
+    if (parser.isSet(summaryOption))
+    {
+        QFile file(parser.value(summaryOption));
+        if (!file.open(QIODeviceBase::WriteOnly) || file.write(summary) != summary.size())
+        {
+            errorStream << "Error: could not write the summary to " << parser.value(summaryOption) << Qt::endl;
+            return 2;
+        }
+    }
+    else
+    {
+        QTextStream(stdout) << summary;
+    }
+    return numFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,108 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Offline tabulation of single spans for the cables of a database
+ *
+ * Solutions are tabulated over the grids of distances and stretching forces for each cable of the database.
+ * The tables are written next to the database, where they are looked for by default.
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <algorithm>
+#include "core/databasecables.h"
+#include "core/spansurrogate.h"
+
+using namespace RSE::Core;
+
+bool parseGrid(QString const& text, SurrogateGrid& grid);
+
+//! Startup point
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("spantable");
+    QTextStream errorStream(stderr);
+    // Specify the options
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Tabulate solutions of single spans for the cables of a database.\n"
+                                     "Grids are specified as min:max:nodes");
+    parser.addHelpOption();
+    parser.addPositionalArgument("names", "Names of cables to tabulate. By default, all the cables of the database", "[names...]");
+    QCommandLineOption dataOption("data", "Directory of the data", "path", "data/");
+    QCommandLineOption cablesOption("cables", "Name of the database of cables", "name", "Провода.txt");
+    QCommandLineOption outputOption("output", "File to write the tables to. By default, the one next to the database", "path");
+    QCommandLineOption distancesOption("distances", "Grid of distances between supports, m", "grid", "10:150:57");
+    QCommandLineOption forcesOption("forces", "Grid of stretching forces, N", "grid", "1000:20000:39");
+    parser.addOptions({dataOption, cablesOption, outputOption, distancesOption, forcesOption});
+    parser.process(app);
+    SurrogateGrid distanceGrid, forceGrid;
+    if (!parseGrid(parser.value(distancesOption), distanceGrid) || !parseGrid(parser.value(forcesOption), forceGrid))
+    {
+        errorStream << "Error: grids should be specified as min:max:nodes with min < max and at least two nodes" << Qt::endl;
+        return 2;
+    }
+    // Select the cables
+    QString dataPath = parser.value(dataOption);
+    if (!dataPath.endsWith('/'))
+        dataPath.append('/');
+    DataBaseCables dataBaseCables(dataPath, parser.value(cablesOption));
+    std::vector<std::string> names = dataBaseCables.names();
+    QStringList arguments = parser.positionalArguments();
+    if (!arguments.isEmpty())
+    {
+        std::vector<std::string> allNames = std::move(names);
+        names.clear();
+        for (QString const& argument : arguments)
+        {
+            std::string name = argument.toStdString();
+            if (std::find(allNames.begin(), allNames.end(), name) == allNames.end())
+            {
+                errorStream << "Error: the cable " << argument << " is not found in the database" << Qt::endl;
+                return 2;
+            }
+            names.push_back(name);
+        }
+    }
+    if (names.empty())
+    {
+        errorStream << "Error: the database of cables is empty" << Qt::endl;
+        return 2;
+    }
+    // Tabulate the spans
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<SpanSurrogate> surrogates(names.size());
+    for (std::size_t i = 0; i != names.size(); ++i)
+    {
+        surrogates[i].build(dataBaseCables.getItem(names[i]), distanceGrid, forceGrid);
+        errorStream << QString("%1 of %2: %3").arg(i + 1).arg(names.size()).arg(QString::fromStdString(names[i])) << Qt::endl;
+    }
+    // Write the tables
+    QString pathFile = parser.isSet(outputOption) ? parser.value(outputOption)
+                                                  : SpanSurrogate::pathFile(dataPath + parser.value(cablesOption));
+    if (!SpanSurrogate::write(pathFile, surrogates))
+    {
+        errorStream << "Error: could not write the tables to " << pathFile << Qt::endl;
+        return 2;
+    }
+    errorStream << QString("%1 tables written to %2 in %3 s").arg(surrogates.size()).arg(pathFile).arg(timer.elapsed() / 1000.0)
+                << Qt::endl;
+    return 0;
+}
+
+//! Parse a grid specified as min:max:nodes
+bool parseGrid(QString const& text, SurrogateGrid& grid)
+{
+    QStringList items = text.split(':');
+    if (items.size() != 3)
+        return false;
+    bool isMin, isMax, isNodes;
+    grid.minValue = items[0].toDouble(&isMin);
+    grid.maxValue = items[1].toDouble(&isMax);
+    grid.numNodes = items[2].toInt(&isNodes);
+    return isMin && isMax && isNodes && grid.minValue < grid.maxValue && grid.numNodes >= 2;
+}
@@ -0,0 +1,125 @@
+/*!
+ * \file
+ * \author Pavel Lakiza
+ * \date October 2026
+ * \brief Stand-in for the rod system solver to run solutions where the solver is not available
+ *
+ * The inputs written by a project are read from the input directory, then frames of a synthetic result are appended
+ * to the output file on a schedule, and the status is written once the result is complete.
+ * Failures and solvers which keep running after writing the status can be imitated as well.
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+#include "core/templatecache.h"
+#include "klp/generator.h"
+
+using namespace RSE::Core;
+using namespace KLP;
+
+static QString const skFileNameStatus = "Status.txt";
+
+//! Read an integer entry of a template line
+int readEntry(QStringList const& lines, int iLine, int iEntry)
+{
+    if (iLine >= lines.size())
+        return -1;
+    QStringList entries = lines[iLine].split(' ', Qt::SkipEmptyParts);
+    if (iEntry >= entries.size())
+        return -1;
+    bool isOk = false;
+    int value = entries[iEntry].toInt(&isOk);
+    return isOk ? value : -1;
+}
+
+//! Startup point
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("standinsolver");
+    QTextStream outputStream(stdout);
+    // Specify the options
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Imitate the rod system solver in the working directory");
+    parser.addHelpOption();
+    QCommandLineOption inputOption("input", "Directory of inputs", "path", "Input/");
+    QCommandLineOption outputOption("output", "Path to the resulting file", "path", "Output/Result.klp");
+    QCommandLineOption framesOption("frames", "Number of time frames", "number", "50");
+    QCommandLineOption nodesOption("nodes", "Number of nodes per rod", "number", "20");
+    QCommandLineOption delayOption("delay", "Time to compute a frame, ms", "number", "100");
+    QCommandLineOption lingerOption("linger", "Time to keep running after the status is written, ms", "number", "0");
+    QCommandLineOption statusOption("status", "Status to write", "number", "0");
+    QCommandLineOption failOption("fail", "Exit with an error without writing the status");
+    QCommandLineOption doubleOption("double", "Write values in double precision");
+    parser.addOptions({inputOption, outputOption, framesOption, nodesOption, delayOption, lingerOption, statusOption, failOption,
+                       doubleOption});
+    parser.process(app);
+    // Read the inputs
+    QString inputPath = parser.value(inputOption);
+    if (!inputPath.endsWith('/'))
+        inputPath.append('/');
+    outputStream << "Reading the inputs from " << QDir(inputPath).absolutePath() << Qt::endl;
+    ProjectTemplate inputs;
+    if (!inputs.read(inputPath))
+    {
+        outputStream << "Error: " << inputs.errorString << Qt::endl;
+        return 2;
+    }
+    // Number of rods and modes are substituted into the program by the project
+    int NR = readEntry(inputs.program, 8, 1);
+    int numModes = readEntry(inputs.program, 15, 1);
+    if (inputs.scalarDataObjects.empty() || inputs.vectorDataObjects.empty() || NR < 1 || numModes < 0)
+    {
+        outputStream << "Error: the inputs are incomplete" << Qt::endl;
+        return 2;
+    }
+    GeneratorOptions options;
+    options.numRods = (NR - 1) / 3 + 1;
+    options.numModes = numModes;
+    options.numFrames = std::max(parser.value(framesOption).toInt(), 1);
+    options.numNodesRod = std::max(parser.value(nodesOption).toInt(), 1);
+    options.recordSets = kAllRecords;
+    options.isDoublePrecision = parser.isSet(doubleOption);
+    options.ID = inputs.projectID;
+    outputStream << "Project: " << inputs.projectID << ", rods: " << options.numRods << ", modes: " << options.numModes << Qt::endl;
+    // Append frames, so that the result can be read while it is growing
+    QString pathOutput = parser.value(outputOption);
+    QDir().mkpath(QFileInfo(pathOutput).absolutePath());
+    QFile file(pathOutput);
+    if (!file.open(QIODeviceBase::WriteOnly))
+    {
+        outputStream << "Error: could not open the file " << pathOutput << Qt::endl;
+        return 2;
+    }
+    Generator generator(options);
+    file.write(generator.header());
+    int delay = parser.value(delayOption).toInt();
+    for (int iFrame = 0; iFrame != options.numFrames; ++iFrame)
+    {
+        QThread::msleep(delay);
+        file.write(generator.frame(iFrame));
+        file.flush();
+        outputStream << QString("Step %1/%2: t = %3").arg(iFrame + 1).arg(options.numFrames).arg(generator.time(iFrame)) << Qt::endl;
+    }
+    file.close();
+    if (parser.isSet(failOption))
+    {
+        outputStream << "Error: the solution has diverged" << Qt::endl;
+        return 1;
+    }
+    // Write the status
+    QFile statusFile(skFileNameStatus);
+    if (!statusFile.open(QIODeviceBase::WriteOnly))
+        return 2;
+    QTextStream(&statusFile) << parser.value(statusOption).toInt() << Qt::endl;
+    statusFile.close();
+    outputStream << "Solution finished" << Qt::endl;
+    QThread::msleep(parser.value(lingerOption).toInt());
+    return 0;
+}
@@ -0,0 +1,15 @@
+QT -= gui
+
+CONFIG += console
+CONFIG -= app_bundle
+
+CONFIG += c++latest
+
+TEMPLATE = app
+
+SOURCES += \
+    main.cpp
+
+include(../../src/core/core.pri)
+include(../../src/klp/klp.pri)
+INCLUDEPATH += ../../src
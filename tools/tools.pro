@@ -0,0 +1,8 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    klpgenerator \
+    klpquery \
+    rsebatch \
+    spantable \
+    standinsolver